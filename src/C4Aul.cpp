@@ -99,6 +99,8 @@ C4AulFunc::~C4AulFunc()
 			pAkt->LinkedTo = LinkedTo;
 		LinkedTo = nullptr;
 	}
+	// call sites may still remember this function
+	if (NextSNFunc || OverloadedBy) ++LookupVersion;
 	// remove from list
 	if (Prev) Prev->Next = Next;
 	if (Next) Next->Prev = Prev;
@@ -129,6 +131,8 @@ C4AulFunc *C4AulFunc::GetLocalSFunc(const char *szIdtf)
 	return Owner->GetSFunc(szIdtf);
 }
 
+uint32_t C4AulFunc::LookupVersion = 0;
+
 C4AulFunc *C4AulFunc::FindSameNameFunc(C4Def *pScope)
 {
 	// Note: NextSNFunc forms a ring, not a list
@@ -149,6 +153,39 @@ C4AulFunc *C4AulFunc::FindSameNameFunc(C4Def *pScope)
 	return pResult;
 }
 
+C4AulCallSite::C4AulCallSite(C4AulFunc *pFunc) : pFunc(pFunc), Version(C4AulFunc::LookupVersion), NextEntry(0)
+{
+	for (Entry &rEntry : Entries)
+		rEntry.pDef = nullptr;
+}
+
+C4AulFunc *C4AulCallSite::Find(C4Def *pDef)
+{
+	// entries from before a relink are useless
+	if (Version != C4AulFunc::LookupVersion)
+	{
+		for (Entry &rEntry : Entries)
+			rEntry.pDef = nullptr;
+		Version = C4AulFunc::LookupVersion;
+		NextEntry = 0;
+	}
+	// called for this definition before?
+	for (const Entry &rEntry : Entries)
+		if (rEntry.pDef == pDef)
+			return rEntry.pFunc;
+	// Resolve overloads
+	C4AulFunc *pFound = pFunc;
+	while (pFound->OverloadedBy)
+		pFound = pFound->OverloadedBy;
+	// Search function for given context
+	pFound = pFound->FindSameNameFunc(pDef);
+	// remember, replacing the oldest entry
+	Entries[NextEntry].pDef = pDef;
+	Entries[NextEntry].pFunc = pFound;
+	NextEntry = (NextEntry + 1) % C4AUL_CallCacheSize;
+	return pFound;
+}
+
 StdStrBuf C4AulScriptFunc::GetFullName()
 {
 	// "lost" function?
@@ -207,6 +244,8 @@ void C4AulScript::Default()
 
 C4AulScript::~C4AulScript()
 {
+	// forget compiled DirectExec script
+	if (Temporary && Engine) Engine->DirectExecCache.Remove(this);
 	// clear
 	Clear();
 	// unreg
@@ -233,6 +272,7 @@ void C4AulScript::Clear()
 	// delete script+code
 	Script.Clear();
 	delete[] Code; Code = nullptr;
+	CallSites.clear();
 	CodeSize = CodeBufSize = 0;
 	// reset flags
 	State = ASS_NONE;
@@ -429,6 +469,8 @@ C4AulScriptEngine::~C4AulScriptEngine() { Clear(); }
 
 void C4AulScriptEngine::Clear()
 {
+	// compiled DirectExec scripts are children of other scripts
+	DirectExecCache.Clear();
 	// clear inherited
 	C4AulScript::Clear();
 	// clear own stuff
@@ -443,10 +485,14 @@ void C4AulScriptEngine::Clear()
 	GlobalConsts.SetNameList(&GlobalConstNames);
 	GlobalNamed.Reset();
 	GlobalNamed.SetNameList(&GlobalNamedNames);
+	// all script values are gone now
+	C4Value::FreeLinkTable();
 }
 
 void C4AulScriptEngine::UnLink()
 {
+	// compiled DirectExec scripts refer to the functions and strings about to be unlinked
+	DirectExecCache.Clear();
 	// unlink scripts
 	C4AulScript::UnLink();
 	// clear string table ("hold" strings only)
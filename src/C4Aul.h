@@ -29,6 +29,13 @@
 #include <C4Script.h>
 #include <C4StringTable.h>
 
+#include <cstdint>
+#include <deque>
+#include <list>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
 // class predefs
 class C4AulError;
 class C4AulFunc;
@@ -39,11 +46,15 @@ class C4AulScriptEngine;
 
 struct C4AulContext;
 struct C4AulBCC;
+struct C4AulParseJob;
 
 // consts
 #define C4AUL_MAX_String 1024 // max string length
 #define C4AUL_MAX_Identifier 100 // max length of function identifiers
 #define C4AUL_MAX_Par 10 // max number of parameters
+#define C4AUL_CallCacheSize 4 // number of definitions remembered per object call site
+#define C4AUL_DirectExecCacheSize 64 // number of compiled DirectExec scripts kept
+#define C4AUL_OptimizeByteCode 1 // set to 0 to run byte code as parsed when debugging the optimizer
 
 #define C4AUL_ControlMethod_None 0
 #define C4AUL_ControlMethod_Classic 1
@@ -61,6 +72,7 @@ public:
 	C4AulError(const C4AulError &Error) { sMessage.Copy(Error.sMessage); }
 	virtual ~C4AulError() {}
 	virtual void show(); // present error message
+	const char *GetText() const { return sMessage.getData(); }
 };
 
 // parse error
@@ -95,11 +107,10 @@ struct C4AulParSet
 	C4Value Par[C4AUL_MAX_Par];
 
 	C4AulParSet() {}
-	C4AulParSet(const C4Value &par0, const C4Value &par1 = C4Value(), const C4Value &par2 = C4Value(), const C4Value &par3 = C4Value(), const C4Value &par4 = C4Value(),
-		const C4Value &par5 = C4Value(), const C4Value &par6 = C4Value(), const C4Value &par7 = C4Value(), const C4Value &par8 = C4Value(), const C4Value &par9 = C4Value())
+	// copy-constructs the given parameters only; the others stay null
+	template<typename... Pars> C4AulParSet(const C4Value &par0, const Pars &... pars) : Par{par0, pars...}
 	{
-		Par[0].Set(par0); Par[1].Set(par1); Par[2].Set(par2); Par[3].Set(par3); Par[4].Set(par4);
-		Par[5].Set(par5); Par[6].Set(par6); Par[7].Set(par7); Par[8].Set(par8); Par[9].Set(par9);
+		static_assert(sizeof...(Pars) < C4AUL_MAX_Par, "too many parameters");
 	}
 
 	C4Value &operator[](int iIdx) { return Par[iIdx]; }
@@ -174,8 +185,8 @@ enum C4AulBCCType
 	AB_XOrIt,            // ^=
 	AB_Set,              // =
 
-	AB_CALL,         // direct object call
-	AB_CALLFS,       // failsafe direct call
+	AB_CALL,         // direct object call (X: C4AulCallSite)
+	AB_CALLFS,       // failsafe direct call (X: C4AulCallSite)
 	AB_CALLNS,       // direct object call: namespace operator
 	AB_STACK,        // push nulls / pop
 	AB_INT,          // constant: int
@@ -190,6 +201,10 @@ enum C4AulBCCType
 	AB_CONDN,        // conditional jump (negated, pops stack)
 	AB_FOREACH_NEXT, // foreach: next element
 	AB_RETURN,       // return statement
+	AB_CONDN_VARN,   // fused AB_VARN_V, operand, comparison, AB_CONDN
+	AB_Inc1_VARN,    // fused AB_VARN_R, AB_Inc1, AB_STACK -1
+	AB_Dec1_VARN,    // fused AB_VARN_R, AB_Dec1, AB_STACK -1
+	AB_APPEND_VARN,  // fused AB_VARN_R, AB_VARN_V, AB_FUNC GetLength, AB_ARRAYA_R
 	AB_ERR,          // parse error at this position
 	AB_EOFN,         // end of function
 	AB_EOF,          // end of file
@@ -216,6 +231,7 @@ extern C4ScriptOpDef C4ScriptOpMap[];
 struct C4AulBCC
 {
 	C4AulBCCType bccType; // chunk type
+	int32_t bccParCnt; // number of parameters pushed for AB_FUNC, AB_CALL and AB_CALLFS
 	intptr_t bccX; // extra info (long for use with amd64)
 	const char *SPos;
 };
@@ -236,11 +252,13 @@ struct C4AulScriptContext : public C4AulContext
 	C4Value *Vars;
 	C4AulScriptFunc *Func;
 	bool TemporaryScript;
-	C4ValueList NumVars;
+	C4ValueList *NumVars; // created by the first Var(n) access
 	C4AulBCC *CPos;
-	time_t tTime; // initialized only by profiler if active
+	uint64_t tTime, tChildTime; // initialized only by profiler if active
+	int32_t ProfilerNode; // call stack node of the profiler
 
 	int ParCnt() const { return Vars - Pars; }
+	C4ValueList &GetNumVars() { if (!NumVars) NumVars = new C4ValueList(); return *NumVars; }
 	void dump(StdStrBuf Dump = StdStrBuf(""));
 };
 
@@ -251,6 +269,7 @@ class C4AulFunc
 	friend class C4AulScriptEngine;
 	friend class C4AulFuncMap;
 	friend class C4AulParseState;
+	friend class C4AulScriptCache;
 
 public:
 	C4AulFunc(C4AulScript *pOwner, const char *pName, bool bAtEnd = true);
@@ -277,16 +296,38 @@ public:
 	virtual C4V_Type GetRetType() { return C4V_Any; }
 	virtual C4Value Exec(C4AulContext *pCallerCtx, C4Value pPars[], bool fPassErrors = false) { return C4Value(); } // execute func (script call)
 	virtual C4Value Exec(C4Object *pObj = nullptr, C4AulParSet *pPars = nullptr, bool fPassErrors = false); // execute func (engine call)
-	virtual void UnLink() { OverloadedBy = NextSNFunc = nullptr; }
+	virtual void UnLink() { OverloadedBy = NextSNFunc = nullptr; ++LookupVersion; }
 
 	C4AulFunc *GetLocalSFunc(const char *szIdtf); // find script function in own scope
 
 	C4AulFunc *FindSameNameFunc(C4Def *pScope); // Find a function of the same name for given scope
 
+	static uint32_t LookupVersion; // changed whenever overloads or same-name rings may have changed
+
 protected:
 	void DestroyLinked(); // destroys linked functions
 };
 
+// inline cache of an object call (AB_CALL/AB_CALLFS) in the byte code:
+// remembers the functions found for the last definitions called
+struct C4AulCallSite
+{
+	struct Entry
+	{
+		C4Def *pDef;
+		C4AulFunc *pFunc; // nullptr if the definition has no such function
+	};
+
+	C4AulFunc *pFunc; // function named in the script
+	uint32_t Version; // C4AulFunc::LookupVersion the entries belong to
+	int NextEntry; // entry to be replaced next
+	Entry Entries[C4AUL_CallCacheSize];
+
+	C4AulCallSite(C4AulFunc *pFunc);
+
+	C4AulFunc *Find(C4Def *pDef); // resolve overloads and find the function to call in definition
+};
+
 // script function class
 class C4AulScriptFunc : public C4AulFunc
 {
@@ -311,13 +352,14 @@ public:
 	C4ValueMapNames VarNamed; // list of named vars in this function
 	C4ValueMapNames ParNamed; // list of named pars in this function
 	C4V_Type ParType[C4AUL_MAX_Par]; // parameter types
+	int ParCnt; // parameters kept in a call frame: named ones and those accessed via Par(n)
 	bool bNewFormat; // new func format? [ func xyz(par abc) { ... } ]
 	bool bReturnRef; // return reference
 	C4AulScript *pOrgScript; // the orginal script (!= Owner if included or appended)
 
 	C4AulScriptFunc(C4AulScript *pOwner, const char *pName, bool bAtEnd = true) : C4AulFunc(pOwner, pName, bAtEnd),
 		idImage(C4ID_None), iImagePhase(0), Condition(nullptr), ControlMethod(C4AUL_ControlMethod_All), OwnerOverloaded(nullptr),
-		bReturnRef(false), tProfileTime(0)
+		ParCnt(C4AUL_MAX_Par), bReturnRef(false)
 	{
 		for (int i = 0; i < C4AUL_MAX_Par; i++) ParType[i] = C4V_Any;
 	}
@@ -334,8 +376,6 @@ public:
 
 	StdStrBuf GetFullName(); // get a fully classified name (C4ID::Name) for debug output
 
-	time_t tProfileTime; // internally set by profiler
-
 	friend class C4AulScript;
 };
 
@@ -377,6 +417,7 @@ protected:
 	void Remove(C4AulFunc *func);
 
 	friend class C4AulFunc;
+	friend class C4AulScriptCache;
 };
 
 // aul script state
@@ -389,31 +430,161 @@ enum C4AulScriptState
 	ASS_PARSED     // byte code generated
 };
 
+// on-disk cache of parsed byte code, so linking the same scripts again
+// does not need the parser; an entry is keyed by the texts of the parsed
+// functions and by everything the parser looks up in other scripts
+class C4AulScriptCache
+{
+private:
+	struct Chunk
+	{
+		int32_t Type, ParCnt;
+		int32_t X; // functions and strings as indices
+		int32_t SPos; // offset in the script text of the function; -1 if none
+
+		void CompileFunc(StdCompiler *pComp);
+	};
+
+	struct Function
+	{
+		int32_t Index; // in the function map
+		int32_t CodePos, ParCnt;
+
+		void CompileFunc(StdCompiler *pComp);
+	};
+
+	struct String
+	{
+		enum { Used, Registered, Held };
+
+		std::string Data;
+		int32_t State; // strings registered by the tokenizer are replayed in order
+
+		void CompileFunc(StdCompiler *pComp);
+	};
+
+	struct Entry
+	{
+		std::string Key;
+		uint32_t LastUse; // save count
+		std::vector<String> Strings;
+		std::vector<Chunk> Code;
+		std::vector<Function> Funcs;
+
+		void CompileFunc(StdCompiler *pComp);
+	};
+
+	std::vector<Entry> Entries;
+	std::unordered_map<std::string, size_t> EntryIndex;
+	uint32_t SaveCount;
+	bool Loaded, Changed;
+
+	// valid while linking
+	bool Linking;
+	std::string LinkKey; // hash of the definitions, function tables and globals
+	std::vector<C4AulFunc *> Funcs; // function map in bucket order
+	std::unordered_map<const C4AulFunc *, int32_t> FuncIndex;
+	std::unordered_map<const C4AulScript *, std::string> TextHashes;
+
+	// script being parsed
+	C4AulScript *pRecording;
+	std::string RecordKey;
+	std::vector<String> RecordStrings;
+	std::unordered_map<std::string, size_t> RecordStringIndex;
+	int RecordWarnCnt, RecordErrCnt;
+
+	bool LoadFile();
+	bool SaveFile();
+	void GetParsedFuncs(C4AulScript *pScript, std::vector<C4AulScriptFunc *> &rFuncs);
+	const std::string &GetTextHash(C4AulScript *pScript);
+	std::string GetScriptKey(C4AulScript *pScript, const std::vector<C4AulScriptFunc *> &rFuncs);
+	int32_t GetStringIndex(const char *szString, int32_t iState);
+	bool Check(C4AulScript *pScript, const std::vector<C4AulScriptFunc *> &rFuncs, const Entry &rEntry); // whether the byte code is safe to execute
+	bool Record(C4AulScript *pScript, Entry &rEntry);
+
+public:
+	C4AulScriptCache() : SaveCount(0), Loaded(false), Changed(false), Linking(false), pRecording(nullptr) {}
+
+	void BeginLink(C4AulScriptEngine *pEngine, C4DefList *pDefs);
+	void EndLink();
+	bool Contains(C4AulScript *pScript); // whether there is an entry for the script; Restore may still reject it
+	bool Restore(C4AulScript *pScript); // sets up the byte code of the script if cached; starts recording otherwise
+	void StringRegistered(C4AulScript *pScript, C4String *pString, bool fHold); // called by the tokenizer
+	void EndParse(C4AulScript *pScript);
+};
+
 #ifdef C4ENGINE
 
-// script profiler entry
+// script profiler: records call counts and inclusive and exclusive times
+// for every call stack, so times can be summed up per function, per
+// caller -> callee edge and per definition
 class C4AulProfiler
 {
 private:
-	// map entry
-	struct Entry
+	// a function on a distinct call stack
+	struct Node
+	{
+		int32_t Parent; // -1 for calls by the engine
+		const void *Key; // called function or name of entry point or direct exec
+		StdCopyStrBuf Name; // kept in case the function is deleted
+		int32_t Group; // index into Groups; -1 for entry points and direct exec
+		bool Listed; // shown in the summary
+		bool EntryPoint; // kind of engine call; times are those of the calls below
+		uint64_t Inclusive, Exclusive; // in nanoseconds
+		uint32_t Calls;
+	};
+
+	struct NodeKey
+	{
+		int32_t Parent;
+		const void *Key;
+
+		bool operator==(const NodeKey &rOther) const { return Parent == rOther.Parent && Key == rOther.Key; }
+	};
+
+	struct NodeKeyHash
 	{
-		C4AulScriptFunc *pFunc;
-		time_t tProfileTime;
+		size_t operator()(const NodeKey &rKey) const { return std::hash<const void *>()(rKey.Key) ^ (size_t(rKey.Parent) * 0x9e3779b9u); }
+	};
 
-		bool operator<(const Entry &e2) const { return tProfileTime < e2.tProfileTime; }
+	// summed up times of a function, edge or definition
+	struct Entry
+	{
+		StdCopyStrBuf Name;
+		uint64_t Inclusive, Exclusive;
+		uint32_t Calls;
+		int32_t Active; // nesting depth while summing up
 	};
 
-	// items
-	std::vector<Entry> Times;
+	std::vector<Node> Nodes;
+	std::unordered_map<NodeKey, int32_t, NodeKeyHash> NodeIndex;
+	std::vector<StdCopyStrBuf> Groups; // definitions, "global" and "game"
+	C4AulScript *pProfiledScript; // only functions of this script are listed in the summary
+
+	int32_t GetNode(int32_t iParent, const void *pKey, C4AulScriptFunc *pFunc, const char *szName, bool fEntryPoint = false);
+	int32_t GetGroup(C4AulScriptFunc *pFunc);
+	void LogEntries(const char *szTitle, std::vector<Entry> &rEntries, bool fByInclusive, size_t iMaxCount);
 
 public:
-	void CollectEntry(C4AulScriptFunc *pFunc, time_t tProfileTime);
-	void Show();
+	C4AulProfiler(C4AulScript *pProfiledScript) : pProfiledScript(pProfiledScript) {}
+
+	static uint64_t GetTime(); // monotonic clock in nanoseconds
+
+	int32_t GetContextNode(const C4AulScriptContext &rContext, const C4AulScriptContext *pCaller);
+	void AddCall(int32_t iNode, uint64_t tInclusive, uint64_t tExclusive)
+	{
+		Node &rNode = Nodes[iNode];
+		rNode.Inclusive += tInclusive;
+		rNode.Exclusive += tExclusive;
+		++rNode.Calls;
+	}
+	void Show(); // logs summary per function, call edge and definition
+	bool SaveCollapsedStacks(const char *szFilename); // flame graph input: one "caller;callee time" line per stack
 
 	static void Abort();
 	static void StartProfiling(C4AulScript *pScript);
-	static void StopProfiling();
+	static void StopProfiling(const char *szCollapsedStacksFilename = nullptr);
+	static bool IsProfiling();
 };
 
 #endif
@@ -437,6 +608,7 @@ protected:
 
 	StdStrBuf Script; // script
 	C4AulBCC *Code, *CPos; // compiled script (/pos)
+	std::deque<C4AulCallSite> CallSites; // caches of the object calls in Code
 	C4AulScriptState State; // script state
 	int CodeSize; // current number of byte code chunks in Code
 	int CodeBufSize; // size of Code buffer
@@ -450,11 +622,15 @@ protected:
 	C4AulFunc *GetOverloadedFunc(C4AulFunc *ByFunc);
 	C4AulFunc *GetFunc(const char *pIdtf); // get local function by name
 
-	void AddBCC(C4AulBCCType eType, intptr_t = 0, const char *SPos = 0); // add byte code chunk and advance
+	void AddBCC(C4AulBCCType eType, intptr_t = 0, const char *SPos = 0, int32_t iParCnt = 0); // add byte code chunk and advance
+	C4AulCallSite *AddCallSite(C4AulFunc *pFunc); // add cache for an object call chunk
 	bool Preparse(); // preparse script; return if successfull
-	void ParseFn(C4AulScriptFunc *Fn, bool fExprOnly = false); // parse single script function
+	void ParseFn(C4AulScriptFunc *Fn, bool fExprOnly = false, C4AulParseJob *pJob = nullptr); // parse single script function
+	void OptimizeFn(C4AulScriptFunc *Fn); // optimize the byte code of the function parsed last
 
-	bool Parse(); // parse preparsed script; return if successfull
+	bool Parse(); // parse preparsed script and its children; return if successfull
+	void GetParseOrder(std::vector<C4AulScript *> &rScripts); // scripts to be parsed, children first
+	void ParseCode(C4AulParseJob *pJob); // generate the byte code of all functions; safe on worker threads
 	void ParseDescs(); // parse function descs
 
 	bool ResolveIncludes(C4DefList *rDefs); // resolve includes
@@ -491,8 +667,6 @@ public:
 
 public:
 	C4Value DirectExec(C4Object *pObj, const char *szScript, const char *szContext, bool fPassErrors = false, enum Strict Strict = MAXSTRICT); // directly parse uncompiled script (WARG! CYCLES!)
-	void ResetProfilerTimes(); // zero all profiler times of owned functions
-	void CollectProfilerTimes(class C4AulProfiler &rProfiler);
 
 	bool IsReady() { return State == ASS_PARSED; } // whether script calls may be done
 
@@ -504,6 +678,37 @@ public:
 	friend class C4AulScriptFunc;
 	friend class C4AulScriptEngine;
 	friend class C4AulParseState;
+	friend class C4AulProfiler;
+	friend class C4AulScriptCache;
+	friend class C4AulDirectExecCache;
+	friend struct C4AulParseJob;
+};
+
+// compiled DirectExec scripts, so repeated evaluations of the same string
+// do not need the parser; cleared whenever the scripts are unlinked
+class C4AulDirectExecCache
+{
+private:
+	struct Entry
+	{
+		std::string Key;
+		C4AulScript *pScript; // temporary script holding the function
+		int32_t Running; // executions on the context stack; those are not evicted
+	};
+
+	std::list<Entry> Entries; // most recently used first
+	std::unordered_map<std::string, std::list<Entry>::iterator> Index; // by parent, context object definition, strictness, context and text
+
+	static std::string GetKey(C4AulScript *pParent, C4Def *pDef, int32_t iStrict, const char *szContext, const char *szScript);
+
+public:
+	~C4AulDirectExecCache() { Clear(); }
+
+	C4AulScriptFunc *Get(C4AulScript *pParent, C4Def *pDef, int32_t iStrict, const char *szContext, const char *szScript); // marks the script as running
+	void Add(C4AulScript *pScript, C4Def *pDef, const char *szContext); // adds a script that was just parsed and is about to run
+	void Release(C4AulScript *pScript); // execution done; deletes the script if not cached
+	void Remove(C4AulScript *pScript); // script is being deleted
+	void Clear(); // running scripts are deleted by Release
 };
 
 // holds all C4AulScripts
@@ -530,6 +735,9 @@ public:
 	C4ValueMapNames GlobalConstNames;
 	C4ValueMapData GlobalConsts;
 
+	C4AulScriptCache ScriptCache;
+	C4AulDirectExecCache DirectExecCache;
+
 	C4AulScriptEngine();
 	~C4AulScriptEngine();
 	void Clear(); // clear data
@@ -566,4 +774,5 @@ public:
 
 	friend class C4AulFunc;
 	friend class C4AulParseState;
+	friend class C4AulScriptCache;
 };
@@ -47,6 +47,12 @@ void C4AulExecError::show()
 #endif
 }
 
+// int or zero value that can be used by the fused comparisons directly
+static inline bool IsPlainInt(const C4Value &rVal)
+{
+	return &rVal.GetRefVal() == &rVal && (rVal.GetType() == C4V_Int || (rVal.GetType() == C4V_Any && !rVal._getRaw()));
+}
+
 const int MAX_CONTEXT_STACK = 512;
 const int MAX_VALUE_STACK = 1024;
 
@@ -99,7 +105,7 @@ class C4AulExec
 {
 public:
 	C4AulExec()
-		: pCurCtx(Contexts - 1), pCurVal(Values - 1), iTraceStart(-1) {}
+		: pCurCtx(Contexts - 1), pCurVal(Values - 1), iTraceStart(-1), pProfiler(nullptr) {}
 
 private:
 	C4AulScriptContext Contexts[MAX_CONTEXT_STACK];
@@ -109,20 +115,17 @@ private:
 	C4Value *pCurVal;
 
 	int iTraceStart;
-	bool fProfiling;
-	time_t tDirectExecStart, tDirectExecTotal; // profiler time for DirectExec
-	C4AulScript *pProfiledScript;
+	C4AulProfiler *pProfiler; // only set while profiling
 
 public:
 	C4Value Exec(C4AulScriptFunc *pSFunc, C4Object *pObj, C4Value pPars[], bool fPassErrors, bool fTemporaryScript = false);
 	C4Value Exec(C4AulBCC *pCPos, bool fPassErrors);
 
 	void StartTrace();
-	void StartProfiling(C4AulScript *pScript); // resets profling times and starts recording the times
-	void StopProfiling(); // stop the profiler and displays results
-	void AbortProfiling() { fProfiling = false; }
-	inline void StartDirectExec() { if (fProfiling) tDirectExecStart = timeGetTime(); }
-	inline void StopDirectExec() { if (fProfiling) tDirectExecTotal += timeGetTime() - tDirectExecStart; }
+	void StartProfiling(C4AulScript *pScript); // starts recording the times of all calls
+	void StopProfiling(const char *szCollapsedStacksFilename); // stop the profiler and displays results
+	void AbortProfiling() { delete pProfiler; pProfiler = nullptr; }
+	bool IsProfiling() const { return pProfiler != nullptr; }
 
 private:
 	void PushContext(const C4AulScriptContext &rContext)
@@ -138,7 +141,12 @@ private:
 			pCurCtx->dump(Buf);
 		}
 		// Profiler: Safe time to measure difference afterwards
-		if (fProfiling) pCurCtx->tTime = timeGetTime();
+		if (pProfiler)
+		{
+			pCurCtx->ProfilerNode = pProfiler->GetContextNode(*pCurCtx, pCurCtx > Contexts ? pCurCtx - 1 : nullptr);
+			pCurCtx->tChildTime = 0;
+			pCurCtx->tTime = C4AulProfiler::GetTime();
+		}
 	}
 
 	void PopContext()
@@ -146,11 +154,11 @@ private:
 		if (pCurCtx < Contexts)
 			throw new C4AulExecError(pCurCtx->Obj, "context stack underflow!");
 		// Profiler adding up times
-		if (fProfiling)
+		if (pProfiler)
 		{
-			time_t dt = timeGetTime() - pCurCtx->tTime;
-			if (dt && pCurCtx->Func)
-				pCurCtx->Func->tProfileTime += dt;
+			uint64_t tInclusive = C4AulProfiler::GetTime() - pCurCtx->tTime;
+			pProfiler->AddCall(pCurCtx->ProfilerNode, tInclusive, tInclusive - pCurCtx->tChildTime);
+			if (pCurCtx > Contexts) pCurCtx[-1].tChildTime += tInclusive;
 		}
 		// Trace done?
 		if (iTraceStart >= 0)
@@ -161,7 +169,8 @@ private:
 			}
 		}
 		if (pCurCtx->TemporaryScript)
-			delete pCurCtx->Func->Owner;
+			Game.ScriptEngine.DirectExecCache.Release(pCurCtx->Func->Owner);
+		delete pCurCtx->NumVars;
 		pCurCtx--;
 	}
 
@@ -267,42 +276,54 @@ private:
 					C4ScriptOpMap[iOpID].Identifier, pCurVal->GetTypeInfo(), GetC4VName(C4ScriptOpMap[iOpID].Type1)).getData());
 	}
 
-	C4AulBCC *Call(C4AulFunc *pFunc, C4Value *pReturn, C4Value *pPars, C4Object *pObj = nullptr, C4Def *pDef = nullptr);
+	C4AulBCC *Call(C4AulFunc *pFunc, C4Value *pReturn, C4Value *pPars, int iParCnt, C4Object *pObj = nullptr, C4Def *pDef = nullptr);
 };
 
 C4AulExec AulExec;
 
 C4Value C4AulExec::Exec(C4AulScriptFunc *pSFunc, C4Object *pObj, C4Value *pnPars, bool fPassErrors, bool fTemporaryScript)
 {
-	// Push parameters
-	C4Value *pPars = pCurVal + 1;
-	if (pnPars)
-		for (int i = 0; i < C4AUL_MAX_Par; i++)
-			PushValue(pnPars[i]);
+	try
+	{
+		// Push the parameters the function uses
+		C4Value *pPars = pCurVal + 1;
+		if (pnPars)
+			for (int i = 0; i < pSFunc->ParCnt; i++)
+				PushValue(pnPars[i]);
+		else
+			PushNullVals(pSFunc->ParCnt);
 
-	// Push variables
-	C4Value *pVars = pCurVal + 1;
-	PushNullVals(pSFunc->VarNamed.iSize);
+		// Push variables
+		C4Value *pVars = pCurVal + 1;
+		PushNullVals(pSFunc->VarNamed.iSize);
 
-	// Derive definition context from function owner (legacy)
-	C4Def *pDef = pObj ? pObj->Def : pSFunc->Owner->Def;
+		// Derive definition context from function owner (legacy)
+		C4Def *pDef = pObj ? pObj->Def : pSFunc->Owner->Def;
 
-	// Executing function in right context?
-	// This must hold: The scripter might try to access local variables that don't exist!
-	assert(!pSFunc->Owner->Def || pDef == pSFunc->Owner->Def);
+		// Executing function in right context?
+		// This must hold: The scripter might try to access local variables that don't exist!
+		assert(!pSFunc->Owner->Def || pDef == pSFunc->Owner->Def);
 
-	// Push a new context
-	C4AulScriptContext ctx;
-	ctx.Obj = pObj;
-	ctx.Def = pDef;
-	ctx.Return = nullptr;
-	ctx.Pars = pPars;
-	ctx.Vars = pVars;
-	ctx.Func = pSFunc;
-	ctx.TemporaryScript = fTemporaryScript;
-	ctx.CPos = nullptr;
-	ctx.Caller = nullptr;
-	PushContext(ctx);
+		// Push a new context
+		C4AulScriptContext ctx;
+		ctx.Obj = pObj;
+		ctx.Def = pDef;
+		ctx.Return = nullptr;
+		ctx.Pars = pPars;
+		ctx.Vars = pVars;
+		ctx.Func = pSFunc;
+		ctx.TemporaryScript = fTemporaryScript;
+		ctx.NumVars = nullptr;
+		ctx.CPos = nullptr;
+		ctx.Caller = nullptr;
+		PushContext(ctx);
+	}
+	catch (C4AulError *)
+	{
+		// Stack overflow: there is no context to release the temporary script when popped
+		if (fTemporaryScript) Game.ScriptEngine.DirectExecCache.Release(pSFunc->Owner);
+		throw;
+	}
 
 	// Execute
 	return Exec(pSFunc->Code, fPassErrors);
@@ -356,6 +377,64 @@ C4Value C4AulExec::Exec(C4AulBCC *pCPos, bool fPassErrors)
 				PushValue(pCurCtx->Vars[pCPos->bccX]);
 				break;
 
+			case AB_CONDN_VARN:
+			{
+				// ints are compared right away, everything else takes the usual way
+				const C4Value &rVar = pCurCtx->Vars[pCPos->bccX];
+				const C4Value *pOperand = pCPos[1].bccType == AB_VARN_V ? &pCurCtx->Vars[pCPos[1].bccX] : nullptr;
+				if (!IsPlainInt(rVar) || (pOperand && !IsPlainInt(*pOperand)))
+				{
+					PushValue(rVar);
+					break;
+				}
+				int32_t a = rVar._getInt(), b;
+				if (pOperand)
+					b = pOperand->_getInt();
+				else
+					b = pCPos[1].bccType == AB_STACK ? 0 : static_cast<int32_t>(pCPos[1].bccX);
+				bool fCond;
+				switch (pCPos[2].bccType)
+				{
+				case AB_LessThan:         fCond = a < b;  break;
+				case AB_LessThanEqual:    fCond = a <= b; break;
+				case AB_GreaterThan:      fCond = a > b;  break;
+				case AB_GreaterThanEqual: fCond = a >= b; break;
+				case AB_Equal: case AB_EqualIdent:       fCond = a == b; break;
+				case AB_NotEqual: case AB_NotEqualIdent: fCond = a != b; break;
+				default: assert(false); fCond = false;
+				}
+				pCPos += fCond ? 4 : 3 + pCPos[3].bccX;
+				fJump = true;
+				break;
+			}
+
+			case AB_Inc1_VARN: case AB_Dec1_VARN:
+			{
+				// ints are changed in place, everything else takes the usual way
+				C4Value &rVar = pCurCtx->Vars[pCPos->bccX];
+				if (!IsPlainInt(rVar))
+				{
+					PushValueRef(rVar);
+					break;
+				}
+				if (pCPos->bccType == AB_Inc1_VARN) ++rVar; else --rVar;
+				pCPos += 3;
+				fJump = true;
+				break;
+			}
+
+			case AB_APPEND_VARN:
+			{
+				// arrays get a reference to a new last element, everything else takes the usual way
+				PushValueRef(pCurCtx->Vars[pCPos->bccX]);
+				C4Value &rArray = pCurVal->GetRefVal();
+				if (rArray.GetType() != C4V_Array) break;
+				rArray.GetArrayElement(rArray._getArray()->GetSize(), *pCurVal, pCurCtx);
+				pCPos += 4;
+				fJump = true;
+				break;
+			}
+
 			case AB_LOCALN_R: case AB_LOCALN_V:
 				if (!pCurCtx->Obj)
 					throw new C4AulExecError(pCurCtx->Obj, "can't access local variables in a definition call!");
@@ -812,11 +891,11 @@ C4Value C4AulExec::Exec(C4AulBCC *pCPos, bool fPassErrors)
 			{
 				// Get function call data
 				C4AulFunc *pFunc = reinterpret_cast<C4AulFunc *>(pCPos->bccX);
-				C4Value *pPars = pCurVal - pFunc->GetParCount() + 1;
+				C4Value *pPars = pCurVal - pCPos->bccParCnt + 1;
 				// Save current position
 				pCurCtx->CPos = pCPos;
 				// Do the call
-				C4AulBCC *pJump = Call(pFunc, pPars, pPars, nullptr);
+				C4AulBCC *pJump = Call(pFunc, pPars, pPars, pCPos->bccParCnt, nullptr);
 				if (pJump)
 				{
 					pCPos = pJump;
@@ -830,9 +909,9 @@ C4Value C4AulExec::Exec(C4AulBCC *pCPos, bool fPassErrors)
 					throw new C4AulExecError(pCurCtx->Obj, FormatString("Var: index of type %s, int expected!", pCurVal->GetTypeName()).getData());
 				// Push reference to variable on the stack
 				if (pCPos->bccType == AB_VAR_R)
-					pCurVal->SetRef(&pCurCtx->NumVars.GetItem(pCurVal->_getInt()));
+					pCurVal->SetRef(&pCurCtx->GetNumVars().GetItem(pCurVal->_getInt()));
 				else
-					pCurVal->Set(pCurCtx->NumVars.GetItem(pCurVal->_getInt()));
+					pCurVal->Set(pCurCtx->GetNumVars().GetItem(pCurVal->_getInt()));
 				break;
 
 			case AB_PAR_R: case AB_PAR_V:
@@ -889,8 +968,8 @@ C4Value C4AulExec::Exec(C4AulBCC *pCPos, bool fPassErrors)
 			case AB_CALL:
 			case AB_CALLFS:
 			{
-				C4Value *pPars = pCurVal - C4AUL_MAX_Par + 1;
-				C4Value *pTargetVal = pCurVal - C4AUL_MAX_Par;
+				C4Value *pPars = pCurVal - pCPos->bccParCnt + 1;
+				C4Value *pTargetVal = pPars - 1;
 
 				// Check for call to null
 				if (!*pTargetVal)
@@ -918,13 +997,9 @@ C4Value C4AulExec::Exec(C4AulBCC *pCPos, bool fPassErrors)
 					throw new C4AulExecError(pCurCtx->Obj,
 						FormatString("Object call: Invalid target type %s, expected object or id!", pTargetVal->GetTypeName()).getData());
 
-				// Resolve overloads
-				C4AulFunc *pFunc = reinterpret_cast<C4AulFunc *>(pCPos->bccX);
-				while (pFunc->OverloadedBy)
-					pFunc = pFunc->OverloadedBy;
-
-				// Search function for given context
-				pFunc = pFunc->FindSameNameFunc(pDestDef);
+				// Resolve overloads and search function for given context, cached per call site
+				C4AulCallSite *pSite = reinterpret_cast<C4AulCallSite *>(pCPos->bccX);
+				C4AulFunc *pFunc = pSite->Find(pDestDef);
 				if (!pFunc && pCPos->bccType == AB_CALLFS)
 				{
 					PopValuesUntil(pTargetVal);
@@ -935,7 +1010,7 @@ C4Value C4AulExec::Exec(C4AulBCC *pCPos, bool fPassErrors)
 				// Function not found?
 				if (!pFunc)
 				{
-					const char *szFuncName = reinterpret_cast<C4AulFunc *>(pCPos->bccX)->Name;
+					const char *szFuncName = pSite->pFunc->Name;
 					if (pDestObj)
 						throw new C4AulExecError(pCurCtx->Obj,
 							FormatString("Object call: No function \"%s\" in object \"%s\"!", szFuncName, pTargetVal->GetDataString().getData()).getData());
@@ -944,14 +1019,11 @@ C4Value C4AulExec::Exec(C4AulBCC *pCPos, bool fPassErrors)
 							FormatString("Definition call: No function \"%s\" in definition \"%s\"!", szFuncName, pDestDef->Name.getData()).getData());
 				}
 
-				// Save function back (optimization)
-				pCPos->bccX = reinterpret_cast<long>(pFunc);
-
 				// Save current position
 				pCurCtx->CPos = pCPos;
 
 				// Call function
-				C4AulBCC *pNewCPos = Call(pFunc, pTargetVal, pPars, pDestObj, pDestDef);
+				C4AulBCC *pNewCPos = Call(pFunc, pTargetVal, pPars, pCPos->bccParCnt, pDestObj, pDestDef);
 				if (pNewCPos)
 				{
 					// Jump
@@ -999,7 +1071,7 @@ C4Value C4AulExec::Exec(C4AulBCC *pCPos, bool fPassErrors)
 	return C4VNull;
 }
 
-C4AulBCC *C4AulExec::Call(C4AulFunc *pFunc, C4Value *pReturn, C4Value *pPars, C4Object *pObj, C4Def *pDef)
+C4AulBCC *C4AulExec::Call(C4AulFunc *pFunc, C4Value *pReturn, C4Value *pPars, int iParCnt, C4Object *pObj, C4Def *pDef)
 {
 	// No object given? Use current context
 	if (!pObj && !pDef)
@@ -1009,9 +1081,18 @@ C4AulBCC *C4AulExec::Call(C4AulFunc *pFunc, C4Value *pReturn, C4Value *pPars, C4
 		pDef = pCurCtx->Def;
 	}
 
+	// Size the parameters to what the function uses. Script functions keep
+	// at least one, so a return value stored at pPars can't hit a variable.
+	C4AulScriptFunc *pSFunc = pFunc->SFunc();
+	int iFrameParCnt = pSFunc ? std::max(pSFunc->ParCnt, pReturn == pPars ? 1 : 0) : pFunc->GetParCount();
+	if (iParCnt < iFrameParCnt)
+		PushNullVals(iFrameParCnt - iParCnt);
+	else if (iParCnt > iFrameParCnt)
+		PopValues(iParCnt - iFrameParCnt);
+
 	// Convert parameters (typecheck)
 	C4V_Type *pTypes = pFunc->GetParType();
-	for (int i = 0; i < pFunc->GetParCount(); i++)
+	for (int i = 0; i < iFrameParCnt; i++)
 		if (!pPars[i].ConvertTo(pTypes[i]))
 			throw new C4AulExecError(pCurCtx->Obj,
 				FormatString("call to \"%s\" parameter %d: got \"%s\", but expected \"%s\"!",
@@ -1019,7 +1100,6 @@ C4AulBCC *C4AulExec::Call(C4AulFunc *pFunc, C4Value *pReturn, C4Value *pPars, C4
 				).getData());
 
 	// Script function?
-	C4AulScriptFunc *pSFunc = pFunc->SFunc();
 	if (pSFunc)
 	{
 		// Push variables
@@ -1039,6 +1119,7 @@ C4AulBCC *C4AulExec::Call(C4AulFunc *pFunc, C4Value *pReturn, C4Value *pPars, C4
 		ctx.Vars = pVars;
 		ctx.Func = pSFunc;
 		ctx.TemporaryScript = false;
+		ctx.NumVars = nullptr;
 		ctx.CPos = nullptr;
 		PushContext(ctx);
 
@@ -1061,7 +1142,7 @@ C4AulBCC *C4AulExec::Call(C4AulFunc *pFunc, C4Value *pReturn, C4Value *pPars, C4
 				sCallText.AppendFormat("Object(%d): ", pObj->Number);
 			sCallText.Append(pFunc->Name);
 			sCallText.AppendChar('(');
-			for (int i = 0; i < C4AUL_MAX_Par; ++i)
+			for (int i = 0; i < iFrameParCnt; ++i)
 			{
 				if (i) sCallText.AppendChar(',');
 				C4Value &rV = pPars[i];
@@ -1119,28 +1200,33 @@ void C4AulExec::StartTrace()
 void C4AulExec::StartProfiling(C4AulScript *pProfiledScript)
 {
 	// stop previous profiler run
-	if (fProfiling) AbortProfiling();
-	fProfiling = true;
-	// resets profling times and starts recording the times
-	this->pProfiledScript = pProfiledScript;
-	time_t tNow = timeGetTime();
-	tDirectExecStart = tNow; // in case profiling is started from DirectExec
-	tDirectExecTotal = 0;
-	pProfiledScript->ResetProfilerTimes();
+	AbortProfiling();
+	pProfiler = new C4AulProfiler(pProfiledScript);
+	// calls already running are measured from now on
+	uint64_t tNow = C4AulProfiler::GetTime();
 	for (C4AulScriptContext *pCtx = Contexts; pCtx <= pCurCtx; ++pCtx)
+	{
+		pCtx->ProfilerNode = pProfiler->GetContextNode(*pCtx, pCtx > Contexts ? pCtx - 1 : nullptr);
+		pCtx->tChildTime = 0;
 		pCtx->tTime = tNow;
+	}
 }
 
-void C4AulExec::StopProfiling()
+void C4AulExec::StopProfiling(const char *szCollapsedStacksFilename)
 {
 	// stop the profiler and displays results
-	if (!fProfiling) return;
-	fProfiling = false;
-	// collect profiler times
-	C4AulProfiler Profiler;
-	Profiler.CollectEntry(nullptr, tDirectExecTotal);
-	pProfiledScript->CollectProfilerTimes(Profiler);
-	Profiler.Show();
+	if (!pProfiler) return;
+	C4AulProfiler *pStoppedProfiler = pProfiler;
+	pProfiler = nullptr;
+	pStoppedProfiler->Show();
+	if (szCollapsedStacksFilename)
+	{
+		if (pStoppedProfiler->SaveCollapsedStacks(szCollapsedStacksFilename))
+			LogF("Profiler call stacks saved to %s", szCollapsedStacksFilename);
+		else
+			LogF("Error saving profiler call stacks to %s", szCollapsedStacksFilename);
+	}
+	delete pStoppedProfiler;
 }
 
 void C4AulProfiler::StartProfiling(C4AulScript *pScript)
@@ -1148,9 +1234,9 @@ void C4AulProfiler::StartProfiling(C4AulScript *pScript)
 	AulExec.StartProfiling(pScript);
 }
 
-void C4AulProfiler::StopProfiling()
+void C4AulProfiler::StopProfiling(const char *szCollapsedStacksFilename)
 {
-	AulExec.StopProfiling();
+	AulExec.StopProfiling(szCollapsedStacksFilename);
 }
 
 void C4AulProfiler::Abort()
@@ -1158,32 +1244,9 @@ void C4AulProfiler::Abort()
 	AulExec.AbortProfiling();
 }
 
-void C4AulProfiler::CollectEntry(C4AulScriptFunc *pFunc, time_t tProfileTime)
-{
-	// zero entries are not collected to have a cleaner list
-	if (!tProfileTime) return;
-	// add entry to list
-	Entry e;
-	e.pFunc = pFunc;
-	e.tProfileTime = tProfileTime;
-	Times.push_back(e);
-}
-
-void C4AulProfiler::Show()
+bool C4AulProfiler::IsProfiling()
 {
-	// sort by time
-	std::sort(Times.rbegin(), Times.rend());
-	// display them
-	Log("Profiler statistics:");
-	Log("==============================");
-	typedef std::vector<Entry> EntryList;
-	for (EntryList::iterator i = Times.begin(); i != Times.end(); ++i)
-	{
-		Entry &e = (*i);
-		LogF("%05dms\t%s", (int)e.tProfileTime, e.pFunc ? (e.pFunc->GetFullName().getData()) : "Direct exec");
-	}
-	Log("==============================");
-	// done!
+	return AulExec.IsProfiling();
 }
 
 C4Value C4AulFunc::Exec(C4Object *pObj, C4AulParSet *pPars, bool fPassErrors)
@@ -1253,71 +1316,121 @@ C4Value C4AulScript::DirectExec(C4Object *pObj, const char *szScript, const char
 	int32_t iObjNumber = pObj ? pObj->Number : -1;
 	AddDbgRec(RCT_DirectExec, &iObjNumber, sizeof(int32_t));
 #endif
-	// profiler
-	AulExec.StartDirectExec();
-	// Create a new temporary script as child of this script
-	C4AulScript *pScript = new C4AulScript();
-	pScript->Script.Copy(szScript);
-	pScript->ScriptName = FormatString("%s in %s", szContext, ScriptName.getData());
-	pScript->Strict = Strict;
-	pScript->Temporary = true;
-	pScript->State = ASS_LINKED;
-	if (pObj)
+	C4Def *pDef = pObj ? pObj->Def : nullptr;
+	// Compiled before?
+	C4AulScriptFunc *pFunc = Engine->DirectExecCache.Get(this, pDef, Strict, szContext, szScript);
+	if (!pFunc)
 	{
-		pScript->Def = pObj->Def;
-		pScript->LocalNamed = pObj->Def->Script.LocalNamed;
-	}
-	else
-	{
-		pScript->Def = nullptr;
-	}
-	pScript->Reg2List(Engine, this);
-	// Add a new function
-	C4AulScriptFunc *pFunc = new C4AulScriptFunc(pScript, "");
-	pFunc->Script = pScript->Script.getData();
-	pFunc->pOrgScript = pScript;
-	// Parse function
-	try
-	{
-		pScript->ParseFn(pFunc, true);
-	}
-	catch (C4AulError *ex)
-	{
-		ex->show();
-		delete ex;
-		delete pFunc;
-		delete pScript;
-		return C4VNull;
+		// Create a new temporary script as child of this script
+		C4AulScript *pScript = new C4AulScript();
+		pScript->Script.Copy(szScript);
+		pScript->ScriptName = FormatString("%s in %s", szContext, ScriptName.getData());
+		pScript->Strict = Strict;
+		pScript->Temporary = true;
+		pScript->State = ASS_LINKED;
+		if (pObj)
+		{
+			pScript->Def = pObj->Def;
+			pScript->LocalNamed = pObj->Def->Script.LocalNamed;
+		}
+		else
+		{
+			pScript->Def = nullptr;
+		}
+		pScript->Reg2List(Engine, this);
+		// Add a new function
+		pFunc = new C4AulScriptFunc(pScript, "");
+		pFunc->Script = pScript->Script.getData();
+		pFunc->pOrgScript = pScript;
+		// Parse function
+		const int iWarnCnt = Engine->warnCnt;
+		try
+		{
+			pScript->ParseFn(pFunc, true);
+		}
+		catch (C4AulError *ex)
+		{
+			ex->show();
+			delete ex;
+			delete pFunc;
+			delete pScript;
+			return C4VNull;
+		}
+		pFunc->Code = pScript->Code;
+		pScript->State = ASS_PARSED;
+		// Keep it unless the parser had something to say, which should be shown every time
+		if (Engine->warnCnt == iWarnCnt) Engine->DirectExecCache.Add(pScript, pDef, szContext);
 	}
-	pFunc->Code = pScript->Code;
-	pScript->State = ASS_PARSED;
-	// Execute. The TemporaryScript-parameter makes sure the script will be deleted later on.
-	C4Value vRetVal(AulExec.Exec(pFunc, pObj, nullptr, fPassErrors, true));
-	// profiler
-	AulExec.StopDirectExec();
-	return vRetVal;
+	// Execute. The TemporaryScript-parameter makes sure the script will be released later on.
+	return AulExec.Exec(pFunc, pObj, nullptr, fPassErrors, true);
+}
+
+std::string C4AulDirectExecCache::GetKey(C4AulScript *pParent, C4Def *pDef, int32_t iStrict, const char *szContext, const char *szScript)
+{
+	std::string Key(reinterpret_cast<const char *>(&pParent), sizeof(pParent));
+	Key.append(reinterpret_cast<const char *>(&pDef), sizeof(pDef));
+	Key.append(reinterpret_cast<const char *>(&iStrict), sizeof(iStrict));
+	Key.append(szContext).append(1, '\0').append(szScript);
+	return Key;
+}
+
+C4AulScriptFunc *C4AulDirectExecCache::Get(C4AulScript *pParent, C4Def *pDef, int32_t iStrict, const char *szContext, const char *szScript)
+{
+	auto it = Index.find(GetKey(pParent, pDef, iStrict, szContext, szScript));
+	if (it == Index.end()) return nullptr;
+	// most recently used
+	Entries.splice(Entries.begin(), Entries, it->second);
+	Entry &rEntry = Entries.front();
+	++rEntry.Running;
+	return rEntry.pScript->Func0->SFunc();
 }
 
-void C4AulScript::ResetProfilerTimes()
+void C4AulDirectExecCache::Add(C4AulScript *pScript, C4Def *pDef, const char *szContext)
 {
-	// zero all profiler times of owned functions
-	C4AulScriptFunc *pSFunc;
-	for (C4AulFunc *pFn = Func0; pFn; pFn = pFn->Next)
-		if (pSFunc = pFn->SFunc())
-			pSFunc->tProfileTime = 0;
-	// reset sub-scripts
-	for (C4AulScript *pScript = Child0; pScript; pScript = pScript->Next)
-		pScript->ResetProfilerTimes();
+	// evict the least recently used script that is not running
+	if (Entries.size() >= C4AUL_DirectExecCacheSize)
+		for (auto it = Entries.end(); it != Entries.begin(); )
+			if (!(--it)->Running)
+			{
+				C4AulScript *pEvicted = it->pScript;
+				Index.erase(it->Key);
+				Entries.erase(it);
+				delete pEvicted;
+				break;
+			}
+	Entries.push_front({GetKey(pScript->Owner, pDef, pScript->Strict, szContext, pScript->GetScript()), pScript, 1});
+	Index[Entries.front().Key] = Entries.begin();
+}
+
+void C4AulDirectExecCache::Release(C4AulScript *pScript)
+{
+	for (Entry &rEntry : Entries)
+		if (rEntry.pScript == pScript)
+		{
+			--rEntry.Running;
+			return;
+		}
+	// not cached
+	delete pScript;
+}
+
+void C4AulDirectExecCache::Remove(C4AulScript *pScript)
+{
+	for (auto it = Entries.begin(); it != Entries.end(); ++it)
+		if (it->pScript == pScript)
+		{
+			Index.erase(it->Key);
+			Entries.erase(it);
+			return;
+		}
 }
 
-void C4AulScript::CollectProfilerTimes(class C4AulProfiler &rProfiler)
+void C4AulDirectExecCache::Clear()
 {
-	// collect all profiler times of owned functions
-	C4AulScriptFunc *pSFunc;
-	for (C4AulFunc *pFn = Func0; pFn; pFn = pFn->Next)
-		if (pSFunc = pFn->SFunc())
-			rProfiler.CollectEntry(pSFunc, pSFunc->tProfileTime);
-	// collect sub-scripts
-	for (C4AulScript *pScript = Child0; pScript; pScript = pScript->Next)
-		pScript->CollectProfilerTimes(rProfiler);
+	std::list<Entry> OldEntries;
+	OldEntries.swap(Entries);
+	Index.clear();
+	for (Entry &rEntry : OldEntries)
+		if (!rEntry.Running)
+			delete rEntry.pScript;
 }
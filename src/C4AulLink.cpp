@@ -170,6 +170,7 @@ void C4AulScript::UnLink()
 
 	// check if byte code needs to be freed
 	delete[] Code; Code = nullptr;
+	CallSites.clear();
 
 	// delete included/appended functions
 	C4AulFunc *pFunc = Func0;
@@ -207,6 +208,8 @@ void C4AulScriptFunc::UnLink()
 
 void C4AulScript::AfterLink()
 {
+	// rings and overloads are rebuilt: forget all lookups
+	++C4AulFunc::LookupVersion;
 	// for all funcs: search functions that have the same name in
 	// the whole script tree (for great fast direct object call)
 	for (C4AulFunc *Func = Func0; Func; Func = Func->Next)
@@ -262,6 +265,9 @@ void C4AulScriptEngine::Link(C4DefList *rDefs)
 {
 #ifdef C4ENGINE
 
+	// compiled DirectExec scripts may refer to functions of the old links
+	DirectExecCache.Clear();
+
 	try
 	{
 		// resolve appends
@@ -274,6 +280,7 @@ void C4AulScriptEngine::Link(C4DefList *rDefs)
 		ParseDescs();
 
 		// parse the scripts to byte code
+		ScriptCache.BeginLink(this, rDefs);
 		Parse();
 
 		// engine is always parsed (for global funcs)
@@ -316,6 +323,9 @@ void C4AulScriptEngine::Link(C4DefList *rDefs)
 		delete err;
 	}
 
+	// save newly parsed byte code
+	ScriptCache.EndLink();
+
 #endif
 }
 
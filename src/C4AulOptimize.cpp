@@ -0,0 +1,468 @@
+/*
+ * LegacyClonk
+ *
+ * Copyright (c) 2017-2019, The LegacyClonk Team and contributors
+ *
+ * Distributed under the terms of the ISC license; see accompanying file
+ * "COPYING" for details.
+ *
+ * "Clonk" is a registered trademark of Matthes Bender, used with permission.
+ * See accompanying file "TRADEMARK" for details.
+ *
+ * To redistribute this file separately, substitute the full license texts
+ * for the above references.
+ */
+
+// optimizes the byte code of aul script functions after parsing
+
+#include <C4Include.h>
+#include <C4Aul.h>
+
+#include <vector>
+
+// The byte code of one function, with jumps resolved to chunk indices.
+// Chunks are only marked as removed while optimizing, so indices stay valid;
+// a jump to a removed chunk continues at the next chunk that is kept. Each
+// transformation makes sure that this is the right place to continue.
+class C4AulOptimizer
+{
+public:
+	C4AulOptimizer(C4AulBCC *pCode, int iSize);
+
+	void Optimize();
+	int Store(C4AulBCC *pCode); // write the code back and return its new size
+
+protected:
+	struct Chunk
+	{
+		C4AulBCC BCC;
+		int Target; // chunk index jumped to, -1 if no jump
+		int Refs; // number of jumps arriving here
+		bool Removed;
+		bool Pinned; // jump after AB_FOREACH_NEXT: must stay where it is
+	};
+
+	std::vector<Chunk> Chunks;
+
+	static bool IsJump(C4AulBCCType eType) { return eType == AB_JUMP || eType == AB_JUMPAND || eType == AB_JUMPOR || eType == AB_CONDN; }
+	static bool GetConst(const C4AulBCC &rBCC, int32_t &rValue); // int-like constant pushed by the chunk
+
+	int Next(int i) const; // next kept chunk after i
+	int Prev(int i) const; // previous kept chunk before i, -1 if none
+	int Resolve(int i) const; // chunk that is executed when jumping to i
+	bool IsTarget(int i) const { return Chunks[i].Refs > 0; }
+
+	void CountTargets();
+	void Remove(int i);
+	void SetTarget(int i, int iTarget);
+	void SetConst(int i, int32_t iValue, C4V_Type eType);
+
+	bool FoldConstants();
+	bool FoldConditions();
+	bool RemovePushPop();
+	bool ThreadJumps();
+	bool RemoveUnreachable();
+	bool MergeStack();
+	void Fuse();
+};
+
+C4AulOptimizer::C4AulOptimizer(C4AulBCC *pCode, int iSize) : Chunks(iSize)
+{
+	for (int i = 0; i < iSize; i++)
+	{
+		Chunk &rChunk = Chunks[i];
+		rChunk.BCC = pCode[i];
+		rChunk.Target = IsJump(pCode[i].bccType) ? i + pCode[i].bccX : -1;
+		rChunk.Refs = 0;
+		rChunk.Removed = false;
+		rChunk.Pinned = i > 0 && pCode[i - 1].bccType == AB_FOREACH_NEXT;
+	}
+}
+
+bool C4AulOptimizer::GetConst(const C4AulBCC &rBCC, int32_t &rValue)
+{
+	switch (rBCC.bccType)
+	{
+	case AB_INT: case AB_BOOL: rValue = static_cast<int32_t>(rBCC.bccX); return true;
+	case AB_STACK: rValue = 0; return rBCC.bccX == 1; // 0 is stored as a single null
+	default: return false;
+	}
+}
+
+int C4AulOptimizer::Next(int i) const
+{
+	do ++i; while (Chunks[i].Removed);
+	return i;
+}
+
+int C4AulOptimizer::Prev(int i) const
+{
+	do --i; while (i >= 0 && Chunks[i].Removed);
+	return i;
+}
+
+int C4AulOptimizer::Resolve(int i) const
+{
+	return Chunks[i].Removed ? Next(i) : i;
+}
+
+void C4AulOptimizer::CountTargets()
+{
+	for (Chunk &rChunk : Chunks) rChunk.Refs = 0;
+	for (int i = 0; i < static_cast<int>(Chunks.size()); i++)
+	{
+		if (Chunks[i].Removed) continue;
+		if (Chunks[i].Target >= 0) ++Chunks[Resolve(Chunks[i].Target)].Refs;
+		// AB_FOREACH_NEXT continues behind the following jump
+		if (Chunks[i].BCC.bccType == AB_FOREACH_NEXT) ++Chunks[Resolve(i + 2)].Refs;
+	}
+}
+
+void C4AulOptimizer::Remove(int i)
+{
+	Chunk &rChunk = Chunks[i];
+	assert(!rChunk.Removed && rChunk.BCC.bccType != AB_EOFN);
+	if (rChunk.Target >= 0) --Chunks[Resolve(rChunk.Target)].Refs;
+	rChunk.Removed = true;
+	// jumps here now arrive at the next chunk
+	Chunks[Next(i)].Refs += rChunk.Refs;
+	rChunk.Refs = 0;
+}
+
+void C4AulOptimizer::SetTarget(int i, int iTarget)
+{
+	--Chunks[Resolve(Chunks[i].Target)].Refs;
+	Chunks[i].Target = iTarget;
+	++Chunks[Resolve(iTarget)].Refs;
+}
+
+void C4AulOptimizer::SetConst(int i, int32_t iValue, C4V_Type eType)
+{
+	// results keep their type: 1-1 is int 0 and !1 is false, not a null like the literal 0
+	C4AulBCC &rBCC = Chunks[i].BCC;
+	switch (eType)
+	{
+	case C4V_Int: rBCC.bccType = AB_INT; rBCC.bccX = iValue; break;
+	case C4V_Bool: rBCC.bccType = AB_BOOL; rBCC.bccX = !!iValue; break;
+	default: rBCC.bccType = AB_STACK; rBCC.bccX = 1; break;
+	}
+}
+
+bool C4AulOptimizer::FoldConstants()
+{
+	// operators on int and bool constants are calculated like C4AulExec does
+	bool fChanged = false;
+	for (int i = 0; i < static_cast<int>(Chunks.size()); i++)
+	{
+		if (Chunks[i].Removed) continue;
+		int32_t a, b;
+		const C4AulBCCType eOp = Chunks[i].BCC.bccType;
+		int iRight = Prev(i);
+		if (iRight < 0 || IsTarget(i) || !GetConst(Chunks[iRight].BCC, b)) continue;
+		// unary operators
+		if (eOp == AB_BitNot || eOp == AB_Not || eOp == AB_Neg)
+		{
+			if (eOp == AB_BitNot) SetConst(iRight, ~b, C4V_Int);
+			else if (eOp == AB_Not) SetConst(iRight, !b, C4V_Bool);
+			else SetConst(iRight, -b, C4V_Int);
+			Remove(i);
+			fChanged = true;
+			continue;
+		}
+		// binary operators
+		int iLeft = Prev(iRight);
+		if (iLeft < 0 || IsTarget(iRight) || !GetConst(Chunks[iLeft].BCC, a)) continue;
+		int32_t r; C4V_Type eType = C4V_Int;
+		switch (eOp)
+		{
+		case AB_Pow: r = Pow(a, b); break;
+		case AB_Div: if (b) r = a / b; else { r = 0; eType = C4V_Any; } break;
+		case AB_Mul: r = a * b; break;
+		case AB_Mod: if (b) r = a % b; else { r = 0; eType = C4V_Any; } break;
+		case AB_Sub: r = a - b; break;
+		case AB_Sum: r = a + b; break;
+		case AB_LeftShift: r = a << b; break;
+		case AB_RightShift: r = a >> b; break;
+		case AB_LessThan: r = a < b; eType = C4V_Bool; break;
+		case AB_LessThanEqual: r = a <= b; eType = C4V_Bool; break;
+		case AB_GreaterThan: r = a > b; eType = C4V_Bool; break;
+		case AB_GreaterThanEqual: r = a >= b; eType = C4V_Bool; break;
+		case AB_EqualIdent: case AB_Equal: r = a == b; eType = C4V_Bool; break;
+		case AB_NotEqualIdent: case AB_NotEqual: r = a != b; eType = C4V_Bool; break;
+		case AB_BitAnd: r = a & b; break;
+		case AB_BitXOr: r = a ^ b; break;
+		case AB_BitOr: r = a | b; break;
+		case AB_And: r = a && b; eType = C4V_Bool; break;
+		case AB_Or: r = a || b; eType = C4V_Bool; break;
+		default: continue;
+		}
+		SetConst(iLeft, r, eType);
+		Remove(iRight);
+		Remove(i);
+		fChanged = true;
+	}
+	return fChanged;
+}
+
+bool C4AulOptimizer::FoldConditions()
+{
+	// conditional jumps on constants either always or never jump
+	bool fChanged = false;
+	for (int i = 0; i < static_cast<int>(Chunks.size()); i++)
+	{
+		if (Chunks[i].Removed || Chunks[i].Pinned) continue;
+		C4AulBCC &rBCC = Chunks[i].BCC;
+		if (rBCC.bccType != AB_CONDN && rBCC.bccType != AB_JUMPAND && rBCC.bccType != AB_JUMPOR) continue;
+		int32_t iValue; int iConst = Prev(i);
+		if (iConst < 0 || IsTarget(i) || !GetConst(Chunks[iConst].BCC, iValue)) continue;
+		bool fJumps = rBCC.bccType == AB_JUMPOR ? !!iValue : !iValue;
+		if (!fJumps)
+		{
+			// the value is popped and execution continues
+			Remove(iConst);
+			Remove(i);
+		}
+		else if (rBCC.bccType == AB_CONDN)
+		{
+			// the value is popped before the jump
+			Remove(iConst);
+			rBCC.bccType = AB_JUMP;
+		}
+		else
+			// the value stays on the stack
+			rBCC.bccType = AB_JUMP;
+		fChanged = true;
+	}
+	return fChanged;
+}
+
+bool C4AulOptimizer::RemovePushPop()
+{
+	// values that are pushed without side effects and popped right away
+	bool fChanged = false;
+	for (int i = 0; i < static_cast<int>(Chunks.size()); i++)
+	{
+		if (Chunks[i].Removed || Chunks[i].BCC.bccType != AB_STACK || Chunks[i].BCC.bccX >= 0) continue;
+		int iPush = Prev(i);
+		if (iPush < 0 || IsTarget(i)) continue;
+		switch (Chunks[iPush].BCC.bccType)
+		{
+		case AB_INT: case AB_BOOL: case AB_STRING: case AB_C4ID:
+		case AB_VARN_R: case AB_VARN_V: case AB_PARN_R: case AB_PARN_V:
+		case AB_GLOBALN_R: case AB_GLOBALN_V:
+			break;
+		default:
+			continue;
+		}
+		Remove(iPush);
+		if (!++Chunks[i].BCC.bccX) Remove(i);
+		fChanged = true;
+	}
+	return fChanged;
+}
+
+bool C4AulOptimizer::ThreadJumps()
+{
+	bool fChanged = false;
+	for (int i = 0; i < static_cast<int>(Chunks.size()); i++)
+	{
+		Chunk &rChunk = Chunks[i];
+		if (rChunk.Removed || rChunk.Target < 0) continue;
+		// jumps to jumps go to the final target directly. A jump that leaves
+		// its value on the stack may continue with a jump of the same kind.
+		int iTarget = Resolve(rChunk.Target);
+		for (size_t iSteps = 0; iSteps < Chunks.size(); iSteps++)
+		{
+			C4AulBCCType eNext = Chunks[iTarget].BCC.bccType;
+			if (eNext == AB_JUMP || (eNext == rChunk.BCC.bccType && eNext != AB_CONDN))
+				iTarget = Resolve(Chunks[iTarget].Target);
+			else
+				break;
+		}
+		if (iTarget != Resolve(rChunk.Target))
+		{
+			SetTarget(i, iTarget);
+			fChanged = true;
+		}
+		if (rChunk.BCC.bccType != AB_JUMP) continue;
+		// a jump to a return returns right away
+		if (Chunks[iTarget].BCC.bccType == AB_RETURN)
+		{
+			--Chunks[iTarget].Refs;
+			rChunk.BCC.bccType = AB_RETURN;
+			rChunk.BCC.bccX = Chunks[iTarget].BCC.bccX;
+			rChunk.Target = -1;
+			fChanged = true;
+		}
+		// a jump to the next chunk does nothing
+		else if (!rChunk.Pinned && iTarget == Next(i))
+		{
+			Remove(i);
+			fChanged = true;
+		}
+	}
+	return fChanged;
+}
+
+bool C4AulOptimizer::RemoveUnreachable()
+{
+	// follow all ways the function can execute
+	std::vector<bool> Reached(Chunks.size(), false);
+	std::vector<int> Open{Resolve(0)};
+	while (!Open.empty())
+	{
+		int i = Open.back(); Open.pop_back();
+		if (Reached[i]) continue;
+		Reached[i] = true;
+		const Chunk &rChunk = Chunks[i];
+		switch (rChunk.BCC.bccType)
+		{
+		case AB_RETURN: case AB_ERR: case AB_EOFN:
+			break;
+		case AB_JUMP:
+			Open.push_back(Resolve(rChunk.Target));
+			break;
+		case AB_FOREACH_NEXT:
+			Open.push_back(Resolve(i + 2));
+			Open.push_back(Next(i));
+			break;
+		default:
+			if (rChunk.Target >= 0) Open.push_back(Resolve(rChunk.Target));
+			Open.push_back(Next(i));
+			break;
+		}
+	}
+	// the end marker stays in any case
+	bool fChanged = false;
+	for (int i = 0; i < static_cast<int>(Chunks.size()); i++)
+		if (!Chunks[i].Removed && !Reached[i] && Chunks[i].BCC.bccType != AB_EOFN)
+		{
+			Remove(i);
+			fChanged = true;
+		}
+	return fChanged;
+}
+
+bool C4AulOptimizer::MergeStack()
+{
+	// same rule as C4AulParseState::AddBCC: nulls may be popped again, but values can't be replaced by nulls
+	bool fChanged = false;
+	for (int i = 0; i < static_cast<int>(Chunks.size()); i++)
+	{
+		C4AulBCC &rBCC = Chunks[i].BCC;
+		if (Chunks[i].Removed || rBCC.bccType != AB_STACK) continue;
+		int iPrev = Prev(i);
+		if (!rBCC.bccX && !Chunks[i].Pinned)
+		{
+			Remove(i);
+			fChanged = true;
+		}
+		else if (iPrev >= 0 && !IsTarget(i) && Chunks[iPrev].BCC.bccType == AB_STACK && (rBCC.bccX <= 0 || Chunks[iPrev].BCC.bccX >= 0))
+		{
+			Chunks[iPrev].BCC.bccX += rBCC.bccX;
+			Remove(i);
+			if (!Chunks[iPrev].BCC.bccX) Remove(iPrev);
+			fChanged = true;
+		}
+	}
+	return fChanged;
+}
+
+void C4AulOptimizer::Fuse()
+{
+	// Superinstructions replace the first chunk of a sequence and read the others
+	// as operands. They handle ints themselves and skip the sequence; for all other
+	// values, they do what the replaced chunk did and the sequence runs as usual.
+	for (int i = 0; i < static_cast<int>(Chunks.size()); i++)
+	{
+		C4AulBCC &rBCC = Chunks[i].BCC;
+		if (Chunks[i].Removed || (rBCC.bccType != AB_VARN_V && rBCC.bccType != AB_VARN_R)) continue;
+		int i1 = Next(i);
+		if (Chunks[i1].BCC.bccType == AB_EOFN || IsTarget(i1)) continue;
+		int i2 = Next(i1);
+		if (Chunks[i2].BCC.bccType == AB_EOFN || IsTarget(i2)) continue;
+		const C4AulBCC &rBCC1 = Chunks[i1].BCC, &rBCC2 = Chunks[i2].BCC;
+		// Var++; Var--;
+		if (rBCC.bccType == AB_VARN_R && rBCC2.bccType == AB_STACK && rBCC2.bccX == -1)
+		{
+			if (rBCC1.bccType == AB_Inc1 || rBCC1.bccType == AB_Inc1_Postfix)
+				rBCC.bccType = AB_Inc1_VARN;
+			else if (rBCC1.bccType == AB_Dec1 || rBCC1.bccType == AB_Dec1_Postfix)
+				rBCC.bccType = AB_Dec1_VARN;
+			continue;
+		}
+		int32_t iValue;
+		int i3 = Next(i2);
+		// Var[GetLength(Var)] = ...
+		if (rBCC.bccType == AB_VARN_R && rBCC1.bccType == AB_VARN_V && rBCC1.bccX == rBCC.bccX && rBCC2.bccType == AB_FUNC && rBCC2.bccParCnt == 1)
+		{
+			// only the engine function, not a script function of the same name
+			C4AulFunc *pFunc = reinterpret_cast<C4AulFunc *>(rBCC2.bccX);
+			if (pFunc && !pFunc->SFunc() && SEqual(pFunc->Name, "GetLength") && Chunks[i3].BCC.bccType == AB_ARRAYA_R && !IsTarget(i3))
+				rBCC.bccType = AB_APPEND_VARN;
+			continue;
+		}
+		// if (Var < Const) ..., while (Var != Var2) ...
+		if (rBCC.bccType != AB_VARN_V || Chunks[i3].BCC.bccType != AB_CONDN || IsTarget(i3)) continue;
+		if (rBCC1.bccType != AB_VARN_V && !GetConst(rBCC1, iValue)) continue;
+		switch (rBCC2.bccType)
+		{
+		case AB_LessThan: case AB_LessThanEqual: case AB_GreaterThan: case AB_GreaterThanEqual:
+		case AB_EqualIdent: case AB_Equal: case AB_NotEqualIdent: case AB_NotEqual:
+			rBCC.bccType = AB_CONDN_VARN;
+			break;
+		default:
+			break;
+		}
+	}
+}
+
+void C4AulOptimizer::Optimize()
+{
+	bool fChanged;
+	do
+	{
+		CountTargets();
+		fChanged = FoldConstants();
+		fChanged |= FoldConditions();
+		fChanged |= RemovePushPop();
+		fChanged |= ThreadJumps();
+		fChanged |= RemoveUnreachable();
+	}
+	while (fChanged);
+	CountTargets();
+	while (MergeStack());
+	CountTargets();
+	Fuse();
+}
+
+int C4AulOptimizer::Store(C4AulBCC *pCode)
+{
+	// new position of each chunk
+	std::vector<int> Pos(Chunks.size());
+	int iSize = 0;
+	for (size_t i = 0; i < Chunks.size(); i++)
+		if (!Chunks[i].Removed) Pos[i] = iSize++;
+	for (size_t i = 0; i < Chunks.size(); i++)
+		if (Chunks[i].Removed) Pos[i] = Pos[Next(i)];
+	// copy code and relocate jumps
+	for (size_t i = 0; i < Chunks.size(); i++)
+	{
+		const Chunk &rChunk = Chunks[i];
+		if (rChunk.Removed) continue;
+		C4AulBCC &rBCC = pCode[Pos[i]] = rChunk.BCC;
+		if (rChunk.Target >= 0)
+			rBCC.bccX = Pos[rChunk.Target] - Pos[i];
+	}
+	return iSize;
+}
+
+void C4AulScript::OptimizeFn(C4AulScriptFunc *Fn)
+{
+	// the function is the last one in the code buffer; its code pointer is still relative
+	C4AulBCC *pStart = Code + reinterpret_cast<intptr_t>(Fn->Code);
+	C4AulOptimizer Optimizer(pStart, CPos - pStart);
+	Optimizer.Optimize();
+	CPos = pStart + Optimizer.Store(pStart);
+	CodeSize = CPos - Code;
+}
@@ -26,6 +26,13 @@
 #include <C4Wrappers.h>
 #endif
 
+#include <atomic>
+#include <memory>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <vector>
+
 #define DEBUG_BYTECODE_DUMP 0
 
 #define C4AUL_Include "#include"
@@ -116,10 +123,11 @@ class C4AulParseState
 {
 public:
 	typedef enum { PARSER, PREPARSER } TypeType;
-	C4AulParseState(C4AulScriptFunc *Fn, C4AulScript *a, TypeType Type) :
+	C4AulParseState(C4AulScriptFunc *Fn, C4AulScript *a, TypeType Type, C4AulParseJob *Job = nullptr) :
 		Fn(Fn), a(a), SPos(Fn ? Fn->Script : a->Script.getData()),
 		Done(false),
 		Type(Type),
+		Job(Job),
 		fJump(false),
 		iStack(0),
 		pLoopStack(nullptr) {}
@@ -136,13 +144,14 @@ public:
 	long cInt; // current int constant (long for compatibility with x86_64)
 	bool Done; // done parsing?
 	TypeType Type; // emitting bytecode?
+	C4AulParseJob *Job; // set while linking; keeps strings and messages until applied
 	void Parse_Script();
 	void Parse_FuncHead();
 	void Parse_Desc();
 	void Parse_Function();
 	void Parse_Statement();
 	void Parse_Block();
-	int Parse_Params(int iMaxCnt, const char *sWarn, C4AulFunc *pFunc = nullptr);
+	int Parse_Params(int iMaxCnt, const char *sWarn, C4AulFunc *pFunc = nullptr, int32_t *piPushed = nullptr); // piPushed: function call, do not pad missing parameters
 	void Parse_Array();
 	void Parse_While();
 	void Parse_If();
@@ -172,7 +181,7 @@ private:
 	bool fJump;
 	int iStack;
 
-	void AddBCC(C4AulBCCType eType, intptr_t X = 0);
+	void AddBCC(C4AulBCCType eType, intptr_t X = 0, int32_t iParCnt = 0);
 
 	void SetNoRef(); // Switches the bytecode to generate a value instead of a reference
 
@@ -201,6 +210,55 @@ private:
 	void AddLoopControl(bool fBreak);
 };
 
+// byte code generation of a script, which may run on a worker thread:
+// the byte code refers to strings by index into Strings, and nothing
+// outside the script is changed until the job is applied
+struct C4AulParseJob
+{
+	struct String
+	{
+		enum { Constant, Registered, Held };
+
+		std::string Data;
+		C4String *pString; // set for constants; other strings are registered when applied
+		int32_t State;
+	};
+
+	C4AulScript *pScript;
+	std::vector<String> Strings;
+	std::vector<std::string> Messages;
+	int WarnCnt, ErrCnt;
+
+	C4AulParseJob(C4AulScript *pScript) : pScript(pScript), WarnCnt(0), ErrCnt(0) {}
+
+	intptr_t AddString(const char *szString, int32_t iState);
+	intptr_t AddString(C4String *pString);
+	void Show(const C4AulError &rError, C4AulScriptFunc *Fn);
+	void Apply(); // register strings and show messages
+
+	static void RunAll(const std::vector<C4AulParseJob *> &rJobs); // generate the byte code on as many threads as configured
+};
+
+intptr_t C4AulParseJob::AddString(const char *szString, int32_t iState)
+{
+	Strings.push_back({szString, nullptr, iState});
+	return static_cast<intptr_t>(Strings.size() - 1);
+}
+
+intptr_t C4AulParseJob::AddString(C4String *pString)
+{
+	Strings.push_back({"", pString, String::Constant});
+	return static_cast<intptr_t>(Strings.size() - 1);
+}
+
+void C4AulParseJob::Show(const C4AulError &rError, C4AulScriptFunc *Fn)
+{
+	Messages.push_back(rError.GetText());
+	// show a warning if the error is in a remote script
+	if (Fn && Fn->pOrgScript != pScript)
+		Messages.push_back(FormatString("  (as #appendto/#include to %s)", Fn->Owner->ScriptName.getData()).getData());
+}
+
 void C4AulScript::Warn(const char *pMsg, const char *pIdtf)
 {
 	// display error
@@ -220,6 +278,13 @@ void C4AulParseState::Warn(const char *pMsg, const char *pIdtf)
 	// display error
 
 	C4AulParseError warning(this, pMsg, pIdtf, true);
+	// jobs display it when applied
+	if (Job)
+	{
+		Job->Show(warning, Fn);
+		++Job->WarnCnt;
+		return;
+	}
 	// display it
 	warning.show();
 	if (Fn && Fn->pOrgScript != a)
@@ -513,7 +578,7 @@ C4AulTokenType C4AulParseState::GetNextToken(char *pToken, long int *pInt, HoldS
 	};
 	TokenGetState State = TGS_None;
 
-	static char StrBuff[C4AUL_MAX_String + 1];
+	char StrBuff[C4AUL_MAX_String + 1];
 	char *pStrPos = StrBuff;
 
 	// loop until finished
@@ -732,11 +797,18 @@ C4AulTokenType C4AulParseState::GetNextToken(char *pToken, long int *pInt, HoldS
 				SPos++;
 				// no string expected?
 				if (HoldStrings == Discard) return ATT_STRING;
+				// jobs register strings when applied
+				if (Job)
+				{
+					*pInt = Job->AddString(StrBuff, HoldStrings == Hold ? C4AulParseJob::String::Held : C4AulParseJob::String::Registered);
+					return ATT_STRING;
+				}
 				// reg string (if not already done so)
 				C4String *pString;
 				if (!(pString = a->Engine->Strings.FindString(StrBuff)))
 					pString = a->Engine->Strings.RegString(StrBuff);
 				if (HoldStrings == Hold) pString->Hold = 1;
+				if (Type == PARSER) a->Engine->ScriptCache.StringRegistered(a, pString, HoldStrings == Hold);
 				// return pointer on string object
 				*pInt = (long)pString;
 				return ATT_STRING;
@@ -854,6 +926,10 @@ static const char *GetTTName(C4AulBCCType e)
 	case AB_CONDN:        return "AB_CONDN";        // conditional jump (negated, pops stack)
 	case AB_FOREACH_NEXT: return "AB_FOREACH_NEXT"; // foreach: next element
 	case AB_RETURN:       return "AB_RETURN";       // return statement
+	case AB_CONDN_VARN:   return "AB_CONDN_VARN";   // fused AB_VARN_V, operand, comparison, AB_CONDN
+	case AB_Inc1_VARN:    return "AB_Inc1_VARN";    // fused AB_VARN_R, AB_Inc1, AB_STACK -1
+	case AB_Dec1_VARN:    return "AB_Dec1_VARN";    // fused AB_VARN_R, AB_Dec1, AB_STACK -1
+	case AB_APPEND_VARN:  return "AB_APPEND_VARN";  // fused AB_VARN_R, AB_VARN_V, AB_FUNC GetLength, AB_ARRAYA_R
 	case AB_ERR:          return "AB_ERR";          // parse error at this position
 	case AB_EOFN:         return "AB_EOFN";         // end of function
 	case AB_EOF:          return "AB_EOF";
@@ -862,7 +938,7 @@ static const char *GetTTName(C4AulBCCType e)
 	}
 }
 
-void C4AulScript::AddBCC(C4AulBCCType eType, intptr_t X, const char *SPos)
+void C4AulScript::AddBCC(C4AulBCCType eType, intptr_t X, const char *SPos, int32_t iParCnt)
 {
 	// range check
 	if (CodeSize >= CodeBufSize)
@@ -880,11 +956,18 @@ void C4AulScript::AddBCC(C4AulBCCType eType, intptr_t X, const char *SPos)
 	}
 	// store chunk
 	CPos->bccType = eType;
+	CPos->bccParCnt = iParCnt;
 	CPos->bccX = X;
 	CPos->SPos = SPos;
 	CPos++; CodeSize++;
 }
 
+C4AulCallSite *C4AulScript::AddCallSite(C4AulFunc *pFunc)
+{
+	CallSites.emplace_back(pFunc);
+	return &CallSites.back();
+}
+
 bool C4AulScript::Preparse()
 {
 	// handle easiest case first
@@ -925,9 +1008,34 @@ bool C4AulScript::Preparse()
 	return true;
 }
 
-void C4AulParseState::AddBCC(C4AulBCCType eType, intptr_t X)
+void C4AulParseState::AddBCC(C4AulBCCType eType, intptr_t X, int32_t iParCnt)
 {
 	if (Type != PARSER) return;
+	// Track parameters the function accesses
+	switch (eType)
+	{
+	case AB_PARN_R:
+	case AB_PARN_V:
+		Fn->ParCnt = std::max<int>(Fn->ParCnt, X + 1);
+		break;
+
+	case AB_PAR_R:
+	case AB_PAR_V:
+	{
+		// constant index: only that parameter (AB_INT 0 is stored as AB_STACK)
+		C4AulBCC *pIndex = a->CPos > a->Code && !fJump ? a->CPos - 1 : nullptr;
+		if (pIndex && pIndex->bccType == AB_INT && Inside<intptr_t>(pIndex->bccX, 0, C4AUL_MAX_Par - 1))
+			Fn->ParCnt = std::max<int>(Fn->ParCnt, pIndex->bccX + 1);
+		else if (pIndex && pIndex->bccType == AB_STACK && pIndex->bccX > 0)
+			Fn->ParCnt = std::max(Fn->ParCnt, 1);
+		else
+			Fn->ParCnt = C4AUL_MAX_Par;
+		break;
+	}
+
+	default:
+		break;
+	}
 	// Track stack size
 	switch (eType)
 	{
@@ -991,12 +1099,12 @@ void C4AulParseState::AddBCC(C4AulBCCType eType, intptr_t X)
 		break;
 
 	case AB_FUNC:
-		iStack -= reinterpret_cast<C4AulFunc *>(X)->GetParCount() - 1;
+		iStack -= iParCnt - 1;
 		break;
 
 	case AB_CALL:
 	case AB_CALLFS:
-		iStack -= C4AUL_MAX_Par;
+		iStack -= iParCnt;
 		break;
 
 	case AB_Inc1:
@@ -1058,7 +1166,7 @@ void C4AulParseState::AddBCC(C4AulBCCType eType, intptr_t X)
 	}
 
 	// Add
-	a->AddBCC(eType, X, SPos);
+	a->AddBCC(eType, X, SPos, iParCnt);
 
 	// Reset jump flag
 	fJump = false;
@@ -1202,7 +1310,7 @@ void C4AulParseState::UnexpectedToken(const char *Expected)
 	throw new C4AulParseError(this, FormatString("%s expected, but found %s", Expected, GetTokenName(TokenType)).getData());
 }
 
-void C4AulScript::ParseFn(C4AulScriptFunc *Fn, bool fExprOnly)
+void C4AulScript::ParseFn(C4AulScriptFunc *Fn, bool fExprOnly, C4AulParseJob *pJob)
 {
 	// check if fn overloads other fn (all func tables are built now)
 	// *MUST* check Fn->Owner-list, because it may be the engine (due to linked globals)
@@ -1215,8 +1323,10 @@ void C4AulScript::ParseFn(C4AulScriptFunc *Fn, bool fExprOnly)
 	// (relative position to code start; code pointer may change while
 	//  parsing)
 	Fn->Code = (C4AulBCC *)(CPos - Code);
+	// parameter slots are raised by the Par accesses found while parsing
+	Fn->ParCnt = Fn->ParNamed.iSize;
 	// parse
-	C4AulParseState state(Fn, this, C4AulParseState::PARSER);
+	C4AulParseState state(Fn, this, C4AulParseState::PARSER, pJob);
 	// get first token
 	state.Shift();
 	if (!fExprOnly)
@@ -2004,9 +2114,10 @@ void C4AulParseState::Parse_Statement()
 				return;
 			}
 			// The preparser assumes the syntax is correct
+			int32_t iParCnt = 0;
 			if (TokenType == ATT_BOPEN || Type == PARSER)
-				Parse_Params(FoundFn ? FoundFn->GetParCount() : 10, FoundFn ? FoundFn->Name : Idtf, FoundFn);
-			AddBCC(AB_FUNC, (long)FoundFn);
+				Parse_Params(FoundFn ? FoundFn->GetParCount() : 10, FoundFn ? FoundFn->Name : Idtf, FoundFn, &iParCnt);
+			AddBCC(AB_FUNC, (long)FoundFn, iParCnt);
 			if (gotohack)
 			{
 				AddBCC(AB_RETURN);
@@ -2027,7 +2138,7 @@ void C4AulParseState::Parse_Statement()
 	}
 }
 
-int C4AulParseState::Parse_Params(int iMaxCnt, const char *sWarn, C4AulFunc *pFunc)
+int C4AulParseState::Parse_Params(int iMaxCnt, const char *sWarn, C4AulFunc *pFunc, int32_t *piPushed)
 {
 	int size = 0;
 	// so it's a regular function; force "("
@@ -2105,8 +2216,14 @@ int C4AulParseState::Parse_Params(int iMaxCnt, const char *sWarn, C4AulFunc *pFu
 	// too many parameters?
 	if (sWarn && size > iMaxCnt && Type == PARSER)
 		Warn(FormatString("%s: passing %d parameters, but only %d are used", sWarn, size, iMaxCnt).getData(), nullptr);
-	// Balance stack
-	if (size != iMaxCnt)
+	// Balance stack; function calls get only the parameters actually passed
+	if (piPushed)
+	{
+		*piPushed = std::min(size, iMaxCnt);
+		if (size > iMaxCnt)
+			AddBCC(AB_STACK, iMaxCnt - size);
+	}
+	else if (size != iMaxCnt)
 		AddBCC(AB_STACK, iMaxCnt - size);
 	return size;
 }
@@ -2443,8 +2560,9 @@ void C4AulParseState::Parse_Expression(int iParentPrio)
 			if (Fn->OwnerOverloaded)
 			{
 				// add direct call to byte code
-				Parse_Params(Fn->OwnerOverloaded->GetParCount(), nullptr, Fn->OwnerOverloaded);
-				AddBCC(AB_FUNC, (long)Fn->OwnerOverloaded);
+				int32_t iParCnt;
+				Parse_Params(Fn->OwnerOverloaded->GetParCount(), nullptr, Fn->OwnerOverloaded, &iParCnt);
+				AddBCC(AB_FUNC, (long)Fn->OwnerOverloaded, iParCnt);
 			}
 			else
 				// not found? raise an error, if it's not a safe call
@@ -2462,8 +2580,9 @@ void C4AulParseState::Parse_Expression(int iParentPrio)
 		{
 			// old syntax: do not allow recursive calls in overloaded functions
 			Shift();
-			Parse_Params(Fn->OwnerOverloaded->GetParCount(), Fn->Name, Fn);
-			AddBCC(AB_FUNC, (long)Fn->OwnerOverloaded);
+			int32_t iParCnt;
+			Parse_Params(Fn->OwnerOverloaded->GetParCount(), Fn->Name, Fn, &iParCnt);
+			AddBCC(AB_FUNC, (long)Fn->OwnerOverloaded, iParCnt);
 		}
 		else
 		{
@@ -2484,11 +2603,10 @@ void C4AulParseState::Parse_Expression(int iParentPrio)
 			{
 				Shift();
 				// Function parameters for all functions except "this", which can be used without
+				int32_t iParCnt = 0;
 				if (!SEqual(FoundFn->Name, C4AUL_this) || TokenType == ATT_BOPEN)
-					Parse_Params(FoundFn->GetParCount(), FoundFn->Name, FoundFn);
-				else
-					AddBCC(AB_STACK, FoundFn->GetParCount());
-				AddBCC(AB_FUNC, (long)FoundFn);
+					Parse_Params(FoundFn->GetParCount(), FoundFn->Name, FoundFn, &iParCnt);
+				AddBCC(AB_FUNC, (long)FoundFn, iParCnt);
 			}
 			else
 			{
@@ -2496,15 +2614,16 @@ void C4AulParseState::Parse_Expression(int iParentPrio)
 				// check for global constant (static const)
 				// global constants have lowest priority for backwards compatibility
 				// it is now allowed to have functional overloads of these constants
-				C4Value val;
-				if (a->Engine->GetGlobalConstant(Idtf, &val))
+				// (not copying the value, which would change the reference count of strings)
+				if (const C4Value *pVal = a->Engine->GlobalConsts.GetItem(Idtf))
 				{
+					const C4Value &val = *pVal;
 					// store as direct constant
 					switch (val.GetType())
 					{
 					case C4V_Int:    AddBCC(AB_INT, val.GetData().Int); break;
 					case C4V_Bool:   AddBCC(AB_BOOL, val.GetData().Int); break;
-					case C4V_String: AddBCC(AB_STRING, reinterpret_cast<intptr_t>(val.GetData().Str)); break;
+					case C4V_String: AddBCC(AB_STRING, Job ? Job->AddString(val.GetData().Str) : reinterpret_cast<intptr_t>(val.GetData().Str)); break;
 					case C4V_C4ID:   AddBCC(AB_C4ID, val.GetData().Int); break;
 					case C4V_Any:
 						// any: allow zero; add it as int
@@ -2725,14 +2844,17 @@ void C4AulParseState::Parse_Expression2(int iParentPrio)
 			{
 				// get def from id
 				C4Def *pDef = C4Id2Def(idNS);
+				// (C4IdText is not safe on worker threads)
+				char szNS[5];
+				GetC4IdText(idNS, szNS);
 				if (!pDef)
 				{
-					throw new C4AulParseError(this, "direct object call: def not found: ", C4IdText(idNS));
+					throw new C4AulParseError(this, "direct object call: def not found: ", szNS);
 				}
 				// search func
 				if (!(pFunc = pDef->Script.GetSFunc(Idtf)))
 				{
-					throw new C4AulParseError(this, FormatString("direct object call: function %s::%s not found", C4IdText(idNS), Idtf).getData());
+					throw new C4AulParseError(this, FormatString("direct object call: function %s::%s not found", szNS, Idtf).getData());
 				}
 				// write namespace chunk to byte code
 				AddBCC(AB_CALLNS, (int)idNS);
@@ -2768,10 +2890,11 @@ void C4AulParseState::Parse_Expression2(int iParentPrio)
 		}
 		// add call chunk
 		Shift();
-		Parse_Params(C4AUL_MAX_Par, pFunc ? pFunc->Name : 0, pFunc);
+		int32_t iParCnt;
+		Parse_Params(C4AUL_MAX_Par, pFunc ? pFunc->Name : 0, pFunc, &iParCnt);
 		if (idNS != 0)
 			AddBCC(AB_CALLNS, (long)idNS);
-		AddBCC(eCallType, (long)pFunc);
+		AddBCC(eCallType, Type == PARSER ? reinterpret_cast<intptr_t>(a->AddCallSite(pFunc)) : 0, iParCnt);
 		break;
 	}
 	default:
@@ -2972,22 +3095,20 @@ void C4AulParseState::Parse_Const()
 	}
 }
 
-bool C4AulScript::Parse()
+void C4AulScript::GetParseOrder(std::vector<C4AulScript *> &rScripts)
 {
-	if (DEBUG_BYTECODE_DUMP)
-	{
-		C4ScriptHost *scripthost = 0;
-		if (Def) scripthost = &Def->Script;
-		if (scripthost) LogSilentF("parsing %s...\n", scripthost->GetFilePath());
-		else LogSilentF("parsing unknown...\n");
-	}
 	// parse children
 	C4AulScript *s = Child0;
-	while (s) { s->Parse(); s = s->Next; }
+	while (s) { s->GetParseOrder(rScripts); s = s->Next; }
 	// check state
-	if (State != ASS_LINKED) return false;
+	if (State != ASS_LINKED) return;
 	// don't parse global funcs again, as they're parsed already through links
-	if (this == Engine) return false;
+	if (this == Engine) return;
+	rScripts.push_back(this);
+}
+
+void C4AulScript::ParseCode(C4AulParseJob *pJob)
+{
 	// delete existing code
 	delete[] Code;
 	CodeSize = CodeBufSize = 0;
@@ -3009,22 +3130,21 @@ bool C4AulScript::Parse()
 		if (Fn)
 		{
 			// parse function
+			bool fParsed = false;
 			try
 			{
-				ParseFn(Fn);
+				ParseFn(Fn, false, pJob);
+				fParsed = true;
 			}
 			catch (C4AulError *err)
 			{
 				// do not show errors for System.c4g scripts that appear to be pure #appendto scripts
 				if (Fn->Owner->Def || Fn->Owner->Appends.empty())
 				{
-					// show
-					err->show();
-					// show a warning if the error is in a remote script
-					if (Fn->pOrgScript != this)
-						DebugLogF("  (as #appendto/#include to %s)", Fn->Owner->ScriptName.getData());
+					// show when the job is applied
+					pJob->Show(*err, Fn);
 					// and count (visible only ;) )
-					++Game.ScriptEngine.errCnt;
+					++pJob->ErrCnt;
 				}
 				delete err;
 				// make all jumps that don't have their destination yet jump here
@@ -3042,6 +3162,7 @@ bool C4AulScript::Parse()
 
 			// add separator
 			AddBCC(AB_EOFN);
+			if (fParsed && C4AUL_OptimizeByteCode) OptimizeFn(Fn);
 		}
 	}
 
@@ -3060,44 +3181,142 @@ bool C4AulScript::Parse()
 		if (Fn)
 			Fn->Code = Code + (long)Fn->Code;
 	}
+}
+
+void C4AulParseJob::Apply()
+{
+	C4AulScriptEngine *pEngine = pScript->Engine;
+	// register strings like the tokenizer would have done
+	for (String &rString : Strings)
+	{
+		if (rString.State == String::Constant) continue;
+		if (!(rString.pString = pEngine->Strings.FindString(rString.Data.c_str())))
+			rString.pString = pEngine->Strings.RegString(rString.Data.c_str());
+		if (rString.State == String::Held) rString.pString->Hold = 1;
+		pEngine->ScriptCache.StringRegistered(pScript, rString.pString, rString.State == String::Held);
+	}
+	for (C4AulBCC *pBCC = pScript->Code; pBCC < pScript->CPos; ++pBCC)
+		if (pBCC->bccType == AB_STRING)
+			pBCC->bccX = reinterpret_cast<intptr_t>(Strings[pBCC->bccX].pString);
+	// show messages
+	for (const std::string &rMessage : Messages)
+		DebugLog(rMessage.c_str());
+	pEngine->warnCnt += WarnCnt;
+	pEngine->errCnt += ErrCnt;
+}
 
-	// save line count
-	Engine->lineCnt += SGetLine(Script.getData(), Script.getPtr(Script.getLength()));
+void C4AulParseJob::RunAll(const std::vector<C4AulParseJob *> &rJobs)
+{
+	// one thread per processor, if not configured otherwise
+	size_t iThreads = Config.Developer.ParseThreads > 0 ? Config.Developer.ParseThreads : std::thread::hardware_concurrency();
+	iThreads = std::min(iThreads, rJobs.size());
+	std::atomic<size_t> iNextJob(0);
+	auto Work = [&rJobs, &iNextJob]()
+	{
+		for (size_t i; (i = iNextJob++) < rJobs.size(); )
+			rJobs[i]->pScript->ParseCode(rJobs[i]);
+	};
+	std::vector<std::thread> Threads;
+	for (size_t i = 1; i < iThreads; ++i)
+	{
+		try
+		{
+			Threads.emplace_back(Work);
+		}
+		catch (const std::system_error &)
+		{
+			// fewer threads do the job as well
+			break;
+		}
+	}
+	// this thread helps
+	Work();
+	for (std::thread &rThread : Threads)
+		rThread.join();
+}
 
-	// dump bytecode
-	if (DEBUG_BYTECODE_DUMP)
-		for (f = Func0; f; f = f->Next)
+bool C4AulScript::Parse()
+{
+	std::vector<C4AulScript *> Scripts;
+	GetParseOrder(Scripts);
+	// scripts only write to their own byte code and functions while parsed,
+	// so those without cached byte code can be parsed in parallel
+	std::vector<std::unique_ptr<C4AulParseJob>> Jobs(Scripts.size());
+	std::vector<C4AulParseJob *> PendingJobs;
+	for (size_t i = 0; i < Scripts.size(); ++i)
+		if (!Engine->ScriptCache.Contains(Scripts[i]))
+		{
+			Jobs[i].reset(new C4AulParseJob(Scripts[i]));
+			PendingJobs.push_back(Jobs[i].get());
+		}
+	C4AulParseJob::RunAll(PendingJobs);
+	// everything else happens in the order of a serial parse, so the string
+	// table, the cache and the log do not depend on the threads
+	for (size_t i = 0; i < Scripts.size(); ++i)
+	{
+		C4AulScript *pScript = Scripts[i];
+		if (DEBUG_BYTECODE_DUMP)
 		{
-			C4AulScriptFunc *Fn;
-			if (!(Fn = f->SFunc()))
+			C4ScriptHost *scripthost = 0;
+			if (pScript->Def) scripthost = &pScript->Def->Script;
+			if (scripthost) LogSilentF("parsing %s...\n", scripthost->GetFilePath());
+			else LogSilentF("parsing unknown...\n");
+		}
+		// byte code of an earlier start?
+		if (!Engine->ScriptCache.Restore(pScript))
+		{
+			// not cached after all
+			if (!Jobs[i])
 			{
-				if (f->LinkedTo) Fn = f->LinkedTo->SFunc();
-				if (Fn) if (Fn->Owner != Engine) Fn = nullptr;
+				Jobs[i].reset(new C4AulParseJob(pScript));
+				pScript->ParseCode(Jobs[i].get());
 			}
-			if (Fn)
-			{
-				LogSilentF("%s:", Fn->Name);
-				for (C4AulBCC *pBCC = Fn->Code;; pBCC++)
+			Jobs[i]->Apply();
+
+			// keep the byte code for the next start
+			Engine->ScriptCache.EndParse(pScript);
+
+			// dump bytecode
+			if (DEBUG_BYTECODE_DUMP)
+				for (C4AulFunc *f = pScript->Func0; f; f = f->Next)
 				{
-					C4AulBCCType eType = pBCC->bccType; long X = pBCC->bccX;
-					switch (eType)
+					C4AulScriptFunc *Fn;
+					if (!(Fn = f->SFunc()))
 					{
-					case AB_FUNC: case AB_CALL: case AB_CALLFS:
-						LogSilentF("%s\t'%s'\n", GetTTName(eType), X ? ((C4AulFunc *)X)->Name : ""); break;
-					case AB_STRING:
-						LogSilentF("%s\t'%s'\n", GetTTName(eType), X ? ((C4String *)X)->Data.getData() : ""); break;
-					default:
-						LogSilentF("%s\t%ld\n", GetTTName(eType), X); break;
+						if (f->LinkedTo) Fn = f->LinkedTo->SFunc();
+						if (Fn) if (Fn->Owner != Engine) Fn = nullptr;
+					}
+					if (Fn)
+					{
+						LogSilentF("%s:", Fn->Name);
+						for (C4AulBCC *pBCC = Fn->Code;; pBCC++)
+						{
+							C4AulBCCType eType = pBCC->bccType; long X = pBCC->bccX;
+							switch (eType)
+							{
+							case AB_FUNC:
+								LogSilentF("%s\t'%s'\t%d\n", GetTTName(eType), X ? ((C4AulFunc *)X)->Name : "", pBCC->bccParCnt); break;
+							case AB_CALL: case AB_CALLFS:
+								LogSilentF("%s\t'%s'\t%d\n", GetTTName(eType), X ? ((C4AulCallSite *)X)->pFunc->Name : "", pBCC->bccParCnt); break;
+							case AB_STRING:
+								LogSilentF("%s\t'%s'\n", GetTTName(eType), X ? ((C4String *)X)->Data.getData() : ""); break;
+							default:
+								LogSilentF("%s\t%ld\n", GetTTName(eType), X); break;
+							}
+							if (eType == AB_EOFN) break;
+						}
 					}
-					if (eType == AB_EOFN) break;
 				}
-			}
 		}
 
-	// finished
-	State = ASS_PARSED;
+		// save line count
+		Engine->lineCnt += SGetLine(pScript->Script.getData(), pScript->Script.getPtr(pScript->Script.getLength()));
 
-	return true;
+		// finished
+		pScript->State = ASS_PARSED;
+	}
+
+	return State == ASS_PARSED;
 }
 
 void C4AulScript::ParseDescs()
@@ -0,0 +1,253 @@
+/*
+ * LegacyClonk
+ *
+ * Copyright (c) 2017-2019, The LegacyClonk Team and contributors
+ *
+ * Distributed under the terms of the ISC license; see accompanying file
+ * "COPYING" for details.
+ *
+ * "Clonk" is a registered trademark of Matthes Bender, used with permission.
+ * See accompanying file "TRADEMARK" for details.
+ *
+ * To redistribute this file separately, substitute the full license texts
+ * for the above references.
+ */
+
+// hierarchical script profiler
+
+#include <C4Include.h>
+#include <C4Aul.h>
+
+#ifndef BIG_C4INCLUDE
+#include <C4Object.h>
+#include <C4Def.h>
+#include <C4Log.h>
+#endif
+
+#include <algorithm>
+#include <chrono>
+#include <map>
+
+// names of the entry points; their addresses are the node keys
+static const char ProfilerTimerCall[] = "TimerCall";
+static const char ProfilerEffect[] = "Effect";
+static const char ProfilerGameScript[] = "GameScript";
+static const char ProfilerCallback[] = "Callback";
+static const char ProfilerDirectExec[] = "DirectExec";
+
+uint64_t C4AulProfiler::GetTime()
+{
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+int32_t C4AulProfiler::GetContextNode(const C4AulScriptContext &rContext, const C4AulScriptContext *pCaller)
+{
+	int32_t iParent;
+	if (pCaller)
+		iParent = pCaller->ProfilerNode;
+	else if (rContext.TemporaryScript)
+		return GetNode(-1, ProfilerDirectExec, nullptr, ProfilerDirectExec);
+	else
+	{
+		// called by the engine: sort in by the kind of call
+		C4AulScriptFunc *pFunc = rContext.Func;
+		const char *szEntryPoint;
+		if (rContext.Obj && rContext.Obj->Def->TimerCall == pFunc)
+			szEntryPoint = ProfilerTimerCall;
+		else if (SEqual2(pFunc->Name, "Fx"))
+			szEntryPoint = ProfilerEffect;
+		else if (pFunc->Owner && !pFunc->Owner->Def && pFunc->Owner != pFunc->Owner->Engine)
+			szEntryPoint = ProfilerGameScript;
+		else
+			szEntryPoint = ProfilerCallback;
+		iParent = GetNode(-1, szEntryPoint, nullptr, szEntryPoint, true);
+	}
+	if (rContext.TemporaryScript)
+		return GetNode(iParent, ProfilerDirectExec, nullptr, ProfilerDirectExec);
+	return GetNode(iParent, rContext.Func, rContext.Func, nullptr);
+}
+
+int32_t C4AulProfiler::GetNode(int32_t iParent, const void *pKey, C4AulScriptFunc *pFunc, const char *szName, bool fEntryPoint)
+{
+	NodeKey Key = { iParent, pKey };
+	auto i = NodeIndex.find(Key);
+	if (i != NodeIndex.end()) return i->second;
+	// new call stack
+	Node NewNode;
+	NewNode.Parent = iParent;
+	NewNode.Key = pKey;
+	NewNode.EntryPoint = fEntryPoint;
+	NewNode.Inclusive = NewNode.Exclusive = 0;
+	NewNode.Calls = 0;
+	if (pFunc)
+	{
+		NewNode.Name.Take(pFunc->GetFullName());
+		NewNode.Group = GetGroup(pFunc);
+		// list functions of the profiled script only
+		NewNode.Listed = false;
+		for (C4AulScript *pScript = pFunc->Owner; pScript; pScript = pScript->Owner)
+			if (pScript == pProfiledScript)
+			{
+				NewNode.Listed = true;
+				break;
+			}
+	}
+	else
+	{
+		NewNode.Name.Copy(szName);
+		NewNode.Group = -1;
+		NewNode.Listed = !fEntryPoint;
+	}
+	int32_t iNode = Nodes.size();
+	Nodes.push_back(NewNode);
+	NodeIndex[Key] = iNode;
+	return iNode;
+}
+
+int32_t C4AulProfiler::GetGroup(C4AulScriptFunc *pFunc)
+{
+	// same owner names as C4AulScriptFunc::GetFullName
+	const char *szGroup;
+	if (!pFunc->Owner)
+		szGroup = "(unknown)";
+	else if (pFunc->Owner->Def)
+		szGroup = C4IdText(pFunc->Owner->Def->id);
+	else if (pFunc->Owner->Engine == pFunc->Owner)
+		szGroup = "global";
+	else
+		szGroup = "game";
+	// few groups, and only looked up for new nodes
+	for (size_t i = 0; i < Groups.size(); ++i)
+		if (SEqual(Groups[i].getData(), szGroup))
+			return i;
+	Groups.push_back(StdCopyStrBuf(szGroup));
+	return Groups.size() - 1;
+}
+
+void C4AulProfiler::Show()
+{
+	// entry points have no times of their own; children always come after their parent
+	std::vector<uint64_t> Inclusive(Nodes.size());
+	for (size_t i = Nodes.size(); i--; )
+	{
+		Inclusive[i] += Nodes[i].Inclusive;
+		if (Nodes[i].Parent >= 0 && Nodes[Nodes[i].Parent].EntryPoint)
+			Inclusive[Nodes[i].Parent] += Inclusive[i];
+	}
+	// entries of every node: function, call edge and definition
+	enum { EntryFunc, EntryCall, EntryDef, EntryCount };
+	std::vector<Entry> Entries[EntryCount];
+	std::vector<size_t> NodeEntries(Nodes.size() * EntryCount, SIZE_MAX);
+	std::map<const void *, size_t> FuncIndex;
+	std::map<std::pair<const void *, const void *>, size_t> CallIndex;
+	std::vector<size_t> DefIndex(Groups.size(), SIZE_MAX);
+	auto GetEntry = [&Entries](int iKind, size_t &riIndex, const char *szName, const char *szName2)
+	{
+		if (riIndex == SIZE_MAX)
+		{
+			riIndex = Entries[iKind].size();
+			Entry NewEntry;
+			NewEntry.Name.Copy(szName);
+			if (szName2) NewEntry.Name.AppendFormat(" -> %s", szName2);
+			NewEntry.Inclusive = NewEntry.Exclusive = 0;
+			NewEntry.Calls = 0;
+			NewEntry.Active = 0;
+			Entries[iKind].push_back(NewEntry);
+		}
+		return riIndex;
+	};
+	std::vector<std::vector<int32_t>> Children(Nodes.size());
+	std::vector<int32_t> Roots;
+	for (size_t i = 0; i < Nodes.size(); ++i)
+	{
+		const Node &rNode = Nodes[i];
+		(rNode.Parent >= 0 ? Children[rNode.Parent] : Roots).push_back(i);
+		if (!rNode.Listed) continue;
+		size_t *piEntries = &NodeEntries[i * EntryCount];
+		auto iFunc = FuncIndex.insert(std::make_pair(rNode.Key, SIZE_MAX)).first;
+		piEntries[EntryFunc] = GetEntry(EntryFunc, iFunc->second, rNode.Name.getData(), nullptr);
+		if (rNode.Parent >= 0)
+		{
+			const Node &rCaller = Nodes[rNode.Parent];
+			auto iCall = CallIndex.insert(std::make_pair(std::make_pair(rCaller.Key, rNode.Key), SIZE_MAX)).first;
+			piEntries[EntryCall] = GetEntry(EntryCall, iCall->second, rCaller.Name.getData(), rNode.Name.getData());
+		}
+		if (rNode.Group >= 0)
+			piEntries[EntryDef] = GetEntry(EntryDef, DefIndex[rNode.Group], Groups[rNode.Group].getData(), nullptr);
+	}
+	// sum up along the call stacks; calls nested into calls of the same
+	// function, edge or definition only count for the outermost one inclusively
+	std::vector<std::pair<int32_t, bool>> Stack; // node, whether it has been entered
+	for (size_t i = Roots.size(); i--; ) Stack.push_back(std::make_pair(Roots[i], false));
+	while (!Stack.empty())
+	{
+		int32_t iNode = Stack.back().first;
+		bool fEntered = Stack.back().second;
+		Stack.back().second = true;
+		const Node &rNode = Nodes[iNode];
+		for (int iKind = 0; iKind < EntryCount; ++iKind)
+		{
+			size_t iEntry = NodeEntries[iNode * EntryCount + iKind];
+			if (iEntry == SIZE_MAX) continue;
+			Entry &rEntry = Entries[iKind][iEntry];
+			if (fEntered)
+				--rEntry.Active;
+			else
+			{
+				if (!rEntry.Active++) rEntry.Inclusive += Inclusive[iNode];
+				rEntry.Exclusive += rNode.Exclusive;
+				rEntry.Calls += rNode.Calls;
+			}
+		}
+		if (fEntered)
+			Stack.pop_back();
+		else
+			for (size_t i = Children[iNode].size(); i--; )
+				Stack.push_back(std::make_pair(Children[iNode][i], false));
+	}
+	// display them
+	Log("Profiler statistics (exclusive, inclusive time, calls):");
+	Log("==============================");
+	LogEntries("Functions:", Entries[EntryFunc], false, 50);
+	LogEntries("Calls:", Entries[EntryCall], true, 50);
+	LogEntries("Definitions:", Entries[EntryDef], false, SIZE_MAX);
+	Log("==============================");
+}
+
+void C4AulProfiler::LogEntries(const char *szTitle, std::vector<Entry> &rEntries, bool fByInclusive, size_t iMaxCount)
+{
+	std::sort(rEntries.begin(), rEntries.end(), [fByInclusive](const Entry &e1, const Entry &e2)
+	{
+		return fByInclusive ? e1.Inclusive > e2.Inclusive : e1.Exclusive > e2.Exclusive;
+	});
+	Log(szTitle);
+	size_t iCount = std::min(iMaxCount, rEntries.size());
+	for (size_t i = 0; i < iCount; ++i)
+	{
+		const Entry &e = rEntries[i];
+		LogF("%10.3fms %10.3fms %8u  %s", e.Exclusive / 1e6, e.Inclusive / 1e6, static_cast<unsigned int>(e.Calls), e.Name.getData());
+	}
+	if (iCount < rEntries.size())
+		LogF("(%d more)", static_cast<int>(rEntries.size() - iCount));
+}
+
+bool C4AulProfiler::SaveCollapsedStacks(const char *szFilename)
+{
+	// one line per call stack with the time spent in its innermost function
+	StdStrBuf Buf;
+	std::vector<const char *> Path;
+	for (const Node &rNode : Nodes)
+	{
+		if (!rNode.Exclusive) continue;
+		Path.clear();
+		for (const Node *pNode = &rNode; ; pNode = &Nodes[pNode->Parent])
+		{
+			Path.push_back(pNode->Name.getData());
+			if (pNode->Parent < 0) break;
+		}
+		for (size_t i = Path.size(); i--; )
+			Buf.AppendFormat(i ? "%s;" : "%s", Path[i]);
+		Buf.AppendFormat(" %.0f\n", static_cast<double>(rNode.Exclusive)); // no 64 bit integer formats; exact up to 2^53
+	}
+	return Buf.SaveToFile(szFilename);
+}
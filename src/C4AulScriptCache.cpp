@@ -0,0 +1,595 @@
+/*
+ * LegacyClonk
+ *
+ * Copyright (c) 2017-2019, The LegacyClonk Team and contributors
+ *
+ * Distributed under the terms of the ISC license; see accompanying file
+ * "COPYING" for details.
+ *
+ * "Clonk" is a registered trademark of Matthes Bender, used with permission.
+ * See accompanying file "TRADEMARK" for details.
+ *
+ * To redistribute this file separately, substitute the full license texts
+ * for the above references.
+ */
+
+// on-disk cache of parsed script byte code
+
+#include <C4Include.h>
+#include <C4Aul.h>
+
+#ifndef BIG_C4INCLUDE
+#include <C4Components.h>
+#include <C4Config.h>
+#include <C4Def.h>
+#include <C4Log.h>
+#include <C4Version.h>
+#endif
+
+#include <StdSha1.h>
+
+#include <algorithm>
+
+// increase whenever the byte code or the file layout changes
+static const int32_t C4AulScriptCacheVersion = 3;
+static const char C4AulScriptCacheMagic[] = "LegacyClonk script cache";
+// entries not used by the last that many saves are dropped
+static const uint32_t C4AulScriptCacheMaxAge = 64;
+
+static void HashInt(StdSha1 &rSha, int32_t iValue)
+{
+	rSha.Update(&iValue, sizeof(iValue));
+}
+
+static void HashString(StdSha1 &rSha, const char *szString)
+{
+	if (!szString) szString = "";
+	rSha.Update(szString, strlen(szString) + 1);
+}
+
+static void HashNames(StdSha1 &rSha, const C4ValueMapNames &rNames)
+{
+	HashInt(rSha, rNames.iSize);
+	for (int32_t i = 0; i < rNames.iSize; ++i)
+		HashString(rSha, rNames.pNames[i]);
+}
+
+static std::string GetDigest(StdSha1 &rSha)
+{
+	uint8_t Digest[StdSha1::DigestLength];
+	rSha.GetHash(Digest);
+	static const char HexDigits[] = "0123456789abcdef";
+	std::string Result;
+	for (uint8_t Byte : Digest)
+	{
+		Result += HexDigits[Byte >> 4];
+		Result += HexDigits[Byte & 15];
+	}
+	return Result;
+}
+
+void C4AulScriptCache::Chunk::CompileFunc(StdCompiler *pComp)
+{
+	pComp->Value(Type);
+	pComp->Value(ParCnt);
+	pComp->Value(X);
+	pComp->Value(SPos);
+}
+
+void C4AulScriptCache::Function::CompileFunc(StdCompiler *pComp)
+{
+	pComp->Value(Index);
+	pComp->Value(CodePos);
+	pComp->Value(ParCnt);
+}
+
+void C4AulScriptCache::String::CompileFunc(StdCompiler *pComp)
+{
+	pComp->Value(Data);
+	pComp->Value(State);
+}
+
+void C4AulScriptCache::Entry::CompileFunc(StdCompiler *pComp)
+{
+	pComp->Value(Key);
+	pComp->Value(LastUse);
+	pComp->Value(mkSTLContainerAdapt(Strings));
+	pComp->Value(mkSTLContainerAdapt(Code));
+	pComp->Value(mkSTLContainerAdapt(Funcs));
+}
+
+bool C4AulScriptCache::LoadFile()
+{
+	Entries.clear();
+	EntryIndex.clear();
+	StdBuf Buf;
+	if (!Buf.LoadFromFile(Config.AtUserPath(C4CFN_ScriptCache))) return false;
+	try
+	{
+		std::string Magic, Checksum;
+		int32_t iVersion = 0;
+		StdCompilerBinRead Compiler;
+		Compiler.setInput(Buf.getRef());
+		Compiler.Begin();
+		Compiler.Value(Magic);
+		Compiler.Value(iVersion);
+		if (Magic != C4AulScriptCacheMagic || iVersion != C4AulScriptCacheVersion) return false;
+		Compiler.Value(Checksum);
+		// the rest is the payload
+		const size_t iPayloadPos = Compiler.getPosition();
+		StdSha1 Sha;
+		Sha.Update(Buf.getPtr(iPayloadPos), Buf.getSize() - iPayloadPos);
+		if (Checksum != GetDigest(Sha))
+		{
+			LogSilent("Script cache damaged: checksum mismatch");
+			return false;
+		}
+		Compiler.Value(SaveCount);
+		Compiler.Value(mkSTLContainerAdapt(Entries));
+		Compiler.End();
+	}
+	catch (StdCompiler::Exception *pExc)
+	{
+		LogSilentF("Script cache damaged: %s", pExc->Msg.getData());
+		delete pExc;
+		Entries.clear();
+		return false;
+	}
+	for (size_t i = 0; i < Entries.size(); ++i)
+		EntryIndex[Entries[i].Key] = i;
+	return true;
+}
+
+bool C4AulScriptCache::SaveFile()
+{
+	// drop entries that have not been used for a while
+	++SaveCount;
+	Entries.erase(std::remove_if(Entries.begin(), Entries.end(),
+		[this](const Entry &rEntry) { return SaveCount - rEntry.LastUse > C4AulScriptCacheMaxAge; }), Entries.end());
+	EntryIndex.clear();
+	for (size_t i = 0; i < Entries.size(); ++i)
+		EntryIndex[Entries[i].Key] = i;
+	// payload
+	StdCompilerBinWrite PayloadCompiler;
+	PayloadCompiler.Begin();
+	PayloadCompiler.Value(SaveCount);
+	PayloadCompiler.Value(mkSTLContainerAdapt(Entries));
+	PayloadCompiler.BeginSecond();
+	PayloadCompiler.Value(SaveCount);
+	PayloadCompiler.Value(mkSTLContainerAdapt(Entries));
+	PayloadCompiler.End();
+	const StdBuf &Payload = PayloadCompiler.getOutput();
+	// header with a checksum of the payload
+	std::string Magic = C4AulScriptCacheMagic;
+	int32_t iVersion = C4AulScriptCacheVersion;
+	StdSha1 Sha;
+	Sha.Update(Payload.getData(), Payload.getSize());
+	std::string Checksum = GetDigest(Sha);
+	StdCompilerBinWrite Compiler;
+	Compiler.Begin();
+	Compiler.Value(Magic);
+	Compiler.Value(iVersion);
+	Compiler.Value(Checksum);
+	Compiler.BeginSecond();
+	Compiler.Value(Magic);
+	Compiler.Value(iVersion);
+	Compiler.Value(Checksum);
+	Compiler.End();
+	StdBuf Output = Compiler.getOutput();
+	Output.Append(Payload);
+	// write to a temporary file first, so an interrupted save does not leave a truncated cache
+	StdStrBuf Filename(Config.AtUserPath(C4CFN_ScriptCache), true);
+	StdStrBuf TempFilename(FormatString("%s.tmp", Filename.getData()));
+	if (!Output.SaveToFile(TempFilename.getData())) return false;
+	if (!RenameFile(TempFilename.getData(), Filename.getData()))
+	{
+		EraseFile(TempFilename.getData());
+		return false;
+	}
+	return true;
+}
+
+void C4AulScriptCache::BeginLink(C4AulScriptEngine *pEngine, C4DefList *pDefs)
+{
+	Linking = Config.Developer.ScriptCache;
+	pRecording = nullptr;
+	Funcs.clear();
+	FuncIndex.clear();
+	TextHashes.clear();
+	if (!Linking) return;
+	if (!Loaded)
+	{
+		LoadFile();
+		Loaded = true;
+	}
+	// number all functions by their position in the function map; the parser
+	// finds overloads and same-named functions in this order
+	const C4AulFuncMap &rMap = pEngine->FuncLookUp;
+	for (int i = 0; i < rMap.Capacity; ++i)
+		for (C4AulFunc *f = rMap.Funcs[i]; f; f = f->MapNext)
+		{
+			FuncIndex[f] = static_cast<int32_t>(Funcs.size());
+			Funcs.push_back(f);
+		}
+	StdSha1 Sha;
+	HashString(Sha, C4VERSION);
+	HashInt(Sha, C4AulScriptCacheVersion);
+	HashInt(Sha, AB_EOF);
+	HashInt(Sha, C4AUL_OptimizeByteCode);
+	// definitions that can be called through the namespace operator
+	const int32_t iDefCount = pDefs->GetDefCount();
+	HashInt(Sha, iDefCount);
+	for (int32_t i = 0; i < iDefCount; ++i)
+		HashInt(Sha, static_cast<int32_t>(pDefs->GetDef(i)->id));
+	// script tree and function tables
+	std::unordered_map<const C4AulScript *, int32_t> ScriptIndex;
+	auto fnHashScript = [&](C4AulScript *pScript, const auto &fnRecurse) -> void
+	{
+		const int32_t iIndex = static_cast<int32_t>(ScriptIndex.size());
+		ScriptIndex[pScript] = iIndex;
+		HashString(Sha, pScript->ScriptName.getData());
+		HashInt(Sha, pScript->Def ? static_cast<int32_t>(pScript->Def->id) : 0);
+		HashInt(Sha, pScript->Temporary);
+		HashInt(Sha, pScript != pEngine ? pScript->State : ASS_NONE); // the engine itself is not parsed
+		for (C4AulFunc *f = pScript->Func0; f; f = f->Next)
+			HashInt(Sha, FuncIndex[f]);
+		HashInt(Sha, -1);
+		for (C4AulScript *pChild = pScript->Child0; pChild; pChild = pChild->Next)
+			fnRecurse(pChild, fnRecurse);
+		HashInt(Sha, -1);
+	};
+	fnHashScript(pEngine, fnHashScript);
+	for (C4AulFunc *f : Funcs)
+	{
+		HashString(Sha, f->Name);
+		auto itOwner = ScriptIndex.find(f->Owner);
+		HashInt(Sha, itOwner != ScriptIndex.end() ? itOwner->second : -1);
+		C4AulScriptFunc *pSFunc = f->SFunc();
+		HashInt(Sha, pSFunc ? pSFunc->Access : -1);
+		HashInt(Sha, f->GetParCount());
+		const C4V_Type *pParTypes = f->GetParType();
+		for (int i = 0; i < C4AUL_MAX_Par; ++i)
+			HashInt(Sha, pParTypes ? pParTypes[i] : -1);
+		HashInt(Sha, f->LinkedTo ? FuncIndex[f->LinkedTo] : -1);
+	}
+	// global variables and constants
+	HashNames(Sha, pEngine->GlobalNamedNames);
+	HashNames(Sha, pEngine->GlobalConstNames);
+	for (int32_t i = 0; i < pEngine->GlobalConstNames.iSize; ++i)
+	{
+		const C4Value &rValue = pEngine->GlobalConsts[i];
+		HashInt(Sha, rValue.GetType());
+		if (rValue.GetType() == C4V_String)
+			HashString(Sha, rValue._getStr()->Data.getData());
+		else if (rValue.GetType() == C4V_Int || rValue.GetType() == C4V_Bool || rValue.GetType() == C4V_C4ID)
+			HashInt(Sha, static_cast<int32_t>(rValue._getRaw()));
+	}
+	LinkKey = GetDigest(Sha);
+}
+
+void C4AulScriptCache::EndLink()
+{
+	if (Linking && Changed)
+	{
+		if (!SaveFile()) LogSilentF("Could not save script cache to %s", Config.AtUserPath(C4CFN_ScriptCache));
+		Changed = false;
+	}
+	Linking = false;
+	pRecording = nullptr;
+	Funcs.clear();
+	FuncIndex.clear();
+	TextHashes.clear();
+}
+
+void C4AulScriptCache::GetParsedFuncs(C4AulScript *pScript, std::vector<C4AulScriptFunc *> &rFuncs)
+{
+	// same selection as in C4AulScript::Parse
+	rFuncs.clear();
+	for (C4AulFunc *f = pScript->Func0; f; f = f->Next)
+	{
+		C4AulScriptFunc *Fn;
+		if (!(Fn = f->SFunc()))
+		{
+			if (f->LinkedTo) Fn = f->LinkedTo->SFunc();
+			if (Fn) if (Fn->Owner != pScript->Engine) Fn = nullptr;
+		}
+		if (Fn) rFuncs.push_back(Fn);
+	}
+}
+
+const std::string &C4AulScriptCache::GetTextHash(C4AulScript *pScript)
+{
+	auto it = TextHashes.find(pScript);
+	if (it != TextHashes.end()) return it->second;
+	StdSha1 Sha;
+	Sha.Update(pScript->Script.getData() ? pScript->Script.getData() : "", pScript->Script.getLength());
+	return TextHashes[pScript] = GetDigest(Sha);
+}
+
+std::string C4AulScriptCache::GetScriptKey(C4AulScript *pScript, const std::vector<C4AulScriptFunc *> &rFuncs)
+{
+	StdSha1 Sha;
+	HashString(Sha, LinkKey.c_str());
+	HashString(Sha, pScript->ScriptName.getData());
+	HashInt(Sha, pScript->Def ? static_cast<int32_t>(pScript->Def->id) : 0);
+	HashInt(Sha, pScript->Strict);
+	HashString(Sha, GetTextHash(pScript).c_str());
+	HashNames(Sha, pScript->LocalNamed);
+	for (C4AulScriptFunc *Fn : rFuncs)
+	{
+		HashInt(Sha, FuncIndex[Fn]);
+		C4AulScript *pOrgScript = Fn->pOrgScript;
+		HashString(Sha, GetTextHash(pOrgScript).c_str());
+		HashInt(Sha, pOrgScript->Strict);
+		HashInt(Sha, Fn->Script ? static_cast<int32_t>(Fn->Script - pOrgScript->Script.getData()) : -1);
+		HashInt(Sha, Fn->bNewFormat);
+		HashInt(Sha, Fn->bReturnRef);
+		HashNames(Sha, Fn->ParNamed);
+		HashNames(Sha, Fn->VarNamed);
+	}
+	return GetDigest(Sha);
+}
+
+bool C4AulScriptCache::Contains(C4AulScript *pScript)
+{
+	if (!Linking) return false;
+	std::vector<C4AulScriptFunc *> ParsedFuncs;
+	GetParsedFuncs(pScript, ParsedFuncs);
+	return EntryIndex.find(GetScriptKey(pScript, ParsedFuncs)) != EntryIndex.end();
+}
+
+bool C4AulScriptCache::Check(C4AulScript *pScript, const std::vector<C4AulScriptFunc *> &rFuncs, const Entry &rEntry)
+{
+	// laid out like ParseCode does: the functions one after another, each closed by AB_EOFN, then AB_EOF
+	const int32_t iCodeSize = static_cast<int32_t>(rEntry.Code.size());
+	if (!iCodeSize || rEntry.Code.back().Type != AB_EOF) return false;
+	int32_t iStart = 0;
+	for (size_t iFunc = 0; iFunc < rFuncs.size(); ++iFunc)
+	{
+		const Function &rFunc = rEntry.Funcs[iFunc];
+		if (rFunc.Index < 0 || rFunc.Index >= static_cast<int32_t>(Funcs.size()) || Funcs[rFunc.Index] != rFuncs[iFunc]) return false;
+		if (rFunc.CodePos != iStart) return false;
+		if (rFunc.ParCnt < 0 || rFunc.ParCnt > C4AUL_MAX_Par) return false;
+		int32_t iEnd = iStart;
+		while (iEnd < iCodeSize - 1 && rEntry.Code[iEnd].Type != AB_EOFN) ++iEnd;
+		if (iEnd == iCodeSize - 1) return false;
+		// operands must stay within the function, its variables and the tables the executor indexes
+		const int32_t iVarCnt = rFuncs[iFunc]->VarNamed.iSize;
+		for (int32_t i = iStart; i < iEnd; ++i)
+		{
+			const Chunk &rChunk = rEntry.Code[i];
+			if (rChunk.Type < 0 || rChunk.Type >= AB_EOFN) return false;
+			if (rChunk.ParCnt < 0 || rChunk.ParCnt > C4AUL_MAX_Par) return false;
+			const int32_t X = rChunk.X;
+			bool fVar = false;
+			int32_t iFollowing = 0; // chunks the instruction looks at or skips
+			switch (rChunk.Type)
+			{
+			case AB_FUNC: case AB_CALL: case AB_CALLFS:
+				if (X < -1 || X >= static_cast<int32_t>(Funcs.size())) return false;
+				break;
+			case AB_STRING:
+				if (X < -1 || X >= static_cast<int32_t>(rEntry.Strings.size())) return false;
+				break;
+			case AB_JUMP: case AB_JUMPAND: case AB_JUMPOR: case AB_CONDN:
+				if (X < iStart - i || X > iEnd - i) return false;
+				break;
+			case AB_PARN_R: case AB_PARN_V:
+				if (X < 0 || X >= C4AUL_MAX_Par) return false;
+				break;
+			case AB_LOCALN_R: case AB_LOCALN_V:
+				if (X < 0 || X >= pScript->LocalNamed.iSize) return false;
+				break;
+			case AB_GLOBALN_R: case AB_GLOBALN_V:
+				if (X < 0 || X >= pScript->Engine->GlobalNamedNames.iSize) return false;
+				break;
+			case AB_VARN_R: case AB_VARN_V: case AB_IVARN:
+				fVar = true;
+				break;
+			case AB_FOREACH_NEXT:
+				fVar = true; iFollowing = 2;
+				break;
+			case AB_Inc1_VARN: case AB_Dec1_VARN:
+				fVar = true; iFollowing = 3;
+				break;
+			case AB_APPEND_VARN:
+				fVar = true; iFollowing = 4;
+				break;
+			case AB_CONDN_VARN:
+				// the jump itself is checked with the AB_CONDN
+				fVar = true; iFollowing = 3;
+				if (i + iFollowing < iEnd && rEntry.Code[i + iFollowing].Type != AB_CONDN) return false;
+				break;
+			}
+			if (fVar && (X < 0 || X >= iVarCnt)) return false;
+			if (i + iFollowing > iEnd) return false;
+		}
+		iStart = iEnd + 1;
+	}
+	return iStart == iCodeSize - 1;
+}
+
+bool C4AulScriptCache::Restore(C4AulScript *pScript)
+{
+	pRecording = nullptr;
+	if (!Linking) return false;
+	std::vector<C4AulScriptFunc *> ParsedFuncs;
+	GetParsedFuncs(pScript, ParsedFuncs);
+	std::string Key = GetScriptKey(pScript, ParsedFuncs);
+	auto it = EntryIndex.find(Key);
+	if (it == EntryIndex.end())
+	{
+		// parse and record
+		pRecording = pScript;
+		RecordKey = std::move(Key);
+		RecordStrings.clear();
+		RecordStringIndex.clear();
+		RecordWarnCnt = pScript->Engine->warnCnt;
+		RecordErrCnt = pScript->Engine->errCnt;
+		return false;
+	}
+	Entry &rEntry = Entries[it->second];
+	// check everything before changing anything
+	if (rEntry.Funcs.size() != ParsedFuncs.size()) return false;
+	C4StringTable &rStrings = pScript->Engine->Strings;
+	for (const String &rString : rEntry.Strings)
+		if (rString.State == String::Used && !rStrings.FindString(rString.Data.c_str())) return false;
+	if (!Check(pScript, ParsedFuncs, rEntry)) return false;
+	const int32_t iCodeSize = static_cast<int32_t>(rEntry.Code.size());
+	// strings are registered like the tokenizer would have done
+	std::vector<C4String *> Strings(rEntry.Strings.size());
+	for (size_t i = 0; i < rEntry.Strings.size(); ++i)
+	{
+		const String &rString = rEntry.Strings[i];
+		// only strings that were looked up are there already
+		C4String *pString = rStrings.FindString(rString.Data.c_str());
+		if (!pString) pString = rStrings.RegString(rString.Data.c_str());
+		if (rString.State == String::Held) pString->Hold = 1;
+		Strings[i] = pString;
+	}
+	// byte code
+	delete[] pScript->Code;
+	pScript->Code = new C4AulBCC[std::max(iCodeSize, 1)];
+	pScript->CodeSize = pScript->CodeBufSize = iCodeSize;
+	pScript->CPos = pScript->Code + iCodeSize;
+	size_t iFunc = 0;
+	const char *szText = nullptr;
+	for (int32_t i = 0; i < iCodeSize; ++i)
+	{
+		const Chunk &rChunk = rEntry.Code[i];
+		while (iFunc < rEntry.Funcs.size() && rEntry.Funcs[iFunc].CodePos <= i)
+			szText = ParsedFuncs[iFunc++]->pOrgScript->Script.getData();
+		C4AulBCC &rBCC = pScript->Code[i];
+		rBCC.bccType = static_cast<C4AulBCCType>(rChunk.Type);
+		rBCC.bccParCnt = rChunk.ParCnt;
+		rBCC.SPos = rChunk.SPos >= 0 && szText ? szText + rChunk.SPos : nullptr;
+		switch (rChunk.Type)
+		{
+		case AB_FUNC:
+			rBCC.bccX = reinterpret_cast<intptr_t>(rChunk.X >= 0 ? Funcs[rChunk.X] : nullptr);
+			break;
+		case AB_CALL: case AB_CALLFS:
+			rBCC.bccX = reinterpret_cast<intptr_t>(pScript->AddCallSite(rChunk.X >= 0 ? Funcs[rChunk.X] : nullptr));
+			break;
+		case AB_STRING:
+			rBCC.bccX = reinterpret_cast<intptr_t>(rChunk.X >= 0 ? Strings[rChunk.X] : nullptr);
+			break;
+		default:
+			rBCC.bccX = rChunk.X;
+			break;
+		}
+	}
+	// functions, as set up by ParseFn
+	for (size_t i = 0; i < ParsedFuncs.size(); ++i)
+	{
+		C4AulScriptFunc *Fn = ParsedFuncs[i];
+		if (Fn->OwnerOverloaded = Fn->Owner->GetOverloadedFunc(Fn))
+			if (Fn->Owner == Fn->OwnerOverloaded->Owner)
+				Fn->OwnerOverloaded->OverloadedBy = Fn;
+		Fn->NextSNFunc = nullptr;
+		Fn->Code = pScript->Code + rEntry.Funcs[i].CodePos;
+		Fn->ParCnt = rEntry.Funcs[i].ParCnt;
+	}
+	rEntry.LastUse = SaveCount;
+	return true;
+}
+
+void C4AulScriptCache::StringRegistered(C4AulScript *pScript, C4String *pString, bool fHold)
+{
+	if (pScript != pRecording) return;
+	GetStringIndex(pString->Data.getData(), fHold ? String::Held : String::Registered);
+}
+
+int32_t C4AulScriptCache::GetStringIndex(const char *szString, int32_t iState)
+{
+	auto it = RecordStringIndex.find(szString);
+	if (it != RecordStringIndex.end())
+	{
+		String &rString = RecordStrings[it->second];
+		rString.State = std::max(rString.State, iState);
+		return static_cast<int32_t>(it->second);
+	}
+	RecordStringIndex[szString] = RecordStrings.size();
+	RecordStrings.push_back({szString, iState});
+	return static_cast<int32_t>(RecordStrings.size() - 1);
+}
+
+bool C4AulScriptCache::Record(C4AulScript *pScript, Entry &rEntry)
+{
+	std::vector<C4AulScriptFunc *> ParsedFuncs;
+	GetParsedFuncs(pScript, ParsedFuncs);
+	for (C4AulScriptFunc *Fn : ParsedFuncs)
+		rEntry.Funcs.push_back({FuncIndex[Fn], static_cast<int32_t>(Fn->Code - pScript->Code), Fn->ParCnt});
+	size_t iFunc = 0;
+	const char *szText = nullptr;
+	size_t iTextLength = 0;
+	for (int32_t i = 0; i < pScript->CodeSize; ++i)
+	{
+		const C4AulBCC &rBCC = pScript->Code[i];
+		while (iFunc < ParsedFuncs.size() && rEntry.Funcs[iFunc].CodePos <= i)
+		{
+			const StdStrBuf &rText = ParsedFuncs[iFunc++]->pOrgScript->Script;
+			szText = rText.getData();
+			iTextLength = rText.getLength();
+		}
+		Chunk NewChunk;
+		NewChunk.Type = rBCC.bccType;
+		NewChunk.ParCnt = rBCC.bccParCnt;
+		NewChunk.SPos = -1;
+		if (rBCC.SPos)
+		{
+			if (!szText || rBCC.SPos < szText || rBCC.SPos > szText + iTextLength) return false;
+			NewChunk.SPos = static_cast<int32_t>(rBCC.SPos - szText);
+		}
+		switch (rBCC.bccType)
+		{
+		case AB_FUNC: case AB_CALL: case AB_CALLFS:
+		{
+			const C4AulFunc *pFunc = rBCC.bccType == AB_FUNC ? reinterpret_cast<C4AulFunc *>(rBCC.bccX) : reinterpret_cast<C4AulCallSite *>(rBCC.bccX)->pFunc;
+			NewChunk.X = -1;
+			if (pFunc)
+			{
+				auto it = FuncIndex.find(pFunc);
+				if (it == FuncIndex.end()) return false;
+				NewChunk.X = it->second;
+			}
+			break;
+		}
+		case AB_STRING:
+		{
+			C4String *pString = reinterpret_cast<C4String *>(rBCC.bccX);
+			NewChunk.X = -1;
+			if (pString)
+			{
+				// restored strings are looked up by content, so that must lead to the same one
+				if (pScript->Engine->Strings.FindString(pString->Data.getData()) != pString) return false;
+				NewChunk.X = GetStringIndex(pString->Data.getData(), String::Used);
+			}
+			break;
+		}
+		default:
+			NewChunk.X = static_cast<int32_t>(rBCC.bccX);
+			if (NewChunk.X != rBCC.bccX) return false;
+			break;
+		}
+		rEntry.Code.push_back(NewChunk);
+	}
+	rEntry.Strings = std::move(RecordStrings);
+	return true;
+}
+
+void C4AulScriptCache::EndParse(C4AulScript *pScript)
+{
+	if (pScript != pRecording) return;
+	pRecording = nullptr;
+	// byte code of scripts with errors or warnings is not kept, so the messages are shown again
+	C4AulScriptEngine *pEngine = pScript->Engine;
+	if (pEngine->warnCnt != RecordWarnCnt || pEngine->errCnt != RecordErrCnt) return;
+	Entry NewEntry;
+	NewEntry.Key = RecordKey;
+	NewEntry.LastUse = SaveCount;
+	if (!Record(pScript, NewEntry)) return;
+	EntryIndex[NewEntry.Key] = Entries.size();
+	Entries.push_back(std::move(NewEntry));
+	Changed = true;
+}
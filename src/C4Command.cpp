@@ -239,12 +239,17 @@ void C4Command::MoveTo()
 					if (!PathFree(cx, cy, Tx._getInt(), Ty))
 					{
 						Game.PathFinder.EnableTransferZones(!cObj->Def->NoTransferZones);
+						Game.PathFinder.EnableNavGrid(!!cObj->Def->NavGrid);
 						Game.PathFinder.SetLevel(cObj->Def->Pathfinder);
+						bool fDeferred = false;
 						if (!Game.PathFinder.Find(cObj->x, cObj->y,
 							Tx._getInt(), Ty,
 							&ObjectAddWaypoint,
-							(intptr_t)cObj)) // intptr for 64bit?
+							(intptr_t)cObj, // intptr for 64bit?
+							&fDeferred))
 						{
+							// Pathfinder busy this frame: try again next frame
+							if (fDeferred) return;
 							/* Path not found: react? */ PathChecked = true; /* recheck delay */
 						}
 						return;
@@ -1084,7 +1089,7 @@ bool C4Command::GetTryEnter()
 	// No minimum con knowledge vehicles/items: fail
 	if (Target->Contained && CheckMinimumCon(Target)) { /* fail??! */ return false; }
 	// Target contained and container has RejectContents: fail
-	if (Target->Contained && !!Target->Contained->Call(PSF_RejectContents)) { Finish(); return false; }
+	if (Target->Contained && !!Target->Contained->Call(PSFId_RejectContents)) { Finish(); return false; }
 	// Collection limit: drop other object
 	// return after drop, so multiple objects may be dropped
 	if (cObj->Def->CollectionLimit && (cObj->Contents.ObjectCount() >= cObj->Def->CollectionLimit))
@@ -1111,7 +1116,7 @@ bool C4Command::GetTryEnter()
 	// if not successfully entered for any other reason, fail
 	if (!fSuccess) { Finish(); return false; }
 	// get-callback for getting out of containers
-	if (fWasContained) cObj->Call(PSF_Get, &C4AulParSet(C4VObj(Target)));
+	if (fWasContained) cObj->Call(PSFId_Get, &C4AulParSet(C4VObj(Target)));
 	// entered
 	return true;
 }
@@ -1757,7 +1762,7 @@ void C4Command::Construct()
 	}
 
 	// command has been validated: check for script overload now
-	int32_t scriptresult = cObj->Call(PSF_ControlCommandConstruction, &C4AulParSet(C4VObj(Target), Tx, C4VInt(Ty), C4VObj(Target2), C4VID(Data))).getInt();
+	int32_t scriptresult = cObj->Call(PSFId_ControlCommandConstruction, &C4AulParSet(C4VObj(Target), Tx, C4VInt(Ty), C4VObj(Target2), C4VID(Data))).getInt();
 	// script call might have deleted object
 	if (!cObj->Status) return;
 	if (1 == scriptresult) return;
@@ -2081,7 +2086,7 @@ void C4Command::Acquire()
 	}
 
 	// script overload
-	int32_t scriptresult = cObj->Call(PSF_ControlCommandAcquire, &C4AulParSet(C4VObj(Target), Tx, C4VInt(Ty), C4VObj(Target2), C4VID(Data))).getInt();
+	int32_t scriptresult = cObj->Call(PSFId_ControlCommandAcquire, &C4AulParSet(C4VObj(Target), Tx, C4VInt(Ty), C4VObj(Target2), C4VID(Data))).getInt();
 
 	// script call might have deleted object
 	if (!cObj->Status) return;
@@ -2179,7 +2184,7 @@ void C4Command::Fail(const char *szFailMessage)
 			// Needed components
 			if (!Target) break;
 			// BuildNeedsMaterial call to builder script...
-			if (!!cObj->Call(PSF_BuildNeedsMaterial, &C4AulParSet(
+			if (!!cObj->Call(PSFId_BuildNeedsMaterial, &C4AulParSet(
 				C4VID(Target->Component.GetID(0)), C4VInt(Target->Component.GetCount(0))))) // WTF? This is passing current components. Not needed ones!
 				break; // no message
 			if (szFailMessage) break;
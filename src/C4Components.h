@@ -112,6 +112,8 @@
 
 #define C4CFN_Log    "Clonk.log"
 #define C4CFN_LogEx  "Clonk%d.log" // created if regular logfile is in use
+#define C4CFN_ScriptProfile "ScriptProfile.txt" // collapsed call stacks of the script profiler
+#define C4CFN_ScriptCache   "ScriptCache.c4b"   // byte code of parsed scripts
 #define C4CFN_Names  "Names.txt"
 #define C4CFN_Titles "Title*.txt|Title.txt"
 
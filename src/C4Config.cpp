@@ -108,7 +108,9 @@ void C4ConfigGeneral::CompileFunc(StdCompiler *pComp)
 
 void C4ConfigDeveloper::CompileFunc(StdCompiler *pComp)
 {
-	pComp->Value(mkNamingAdapt(AutoFileReload, "AutoFileReload", true, false, true));
+	pComp->Value(mkNamingAdapt(AutoFileReload,  "AutoFileReload",  true, false, true));
+	pComp->Value(mkNamingAdapt(ScriptCache,     "ScriptCache",     true, false, true));
+	pComp->Value(mkNamingAdapt(ParseThreads,    "ParseThreads",    0,    false, true));
 }
 
 void C4ConfigGraphics::CompileFunc(StdCompiler *pComp)
@@ -126,6 +128,7 @@ void C4ConfigGraphics::CompileFunc(StdCompiler *pComp)
 	pComp->Value(mkNamingAdapt(ShowCommandKeys,      "ShowCommandKeys",      true,  false, true));
 	pComp->Value(mkNamingAdapt(ColorAnimation,       "ColorAnimation",       false, false, true));
 	pComp->Value(mkNamingAdapt(SmokeLevel,           "SmokeLevel",           200,   false, true));
+	pComp->Value(mkNamingAdapt(ParticleThreads,      "ParticleThreads",      2,     false, true));
 	pComp->Value(mkNamingAdapt(VerboseObjectLoading, "VerboseObjectLoading", 0,     false, true));
 	pComp->Value(mkNamingAdapt(VideoModule,          "VideoModule",          false, false, true));
 	pComp->Value(mkNamingAdapt(UpperBoard,           "UpperBoard",           true,  false, true));
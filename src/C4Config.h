@@ -90,6 +90,8 @@ class C4ConfigDeveloper
 {
 public:
 	bool AutoFileReload;
+	bool ScriptCache; // if set, parsed script byte code is kept on disk for the next start
+	int32_t ParseThreads; // threads generating script byte code at link time; 0 = one per processor
 	void CompileFunc(StdCompiler *pComp);
 };
 
@@ -106,6 +108,7 @@ public:
 	int32_t VerboseObjectLoading;
 	bool ColorAnimation;
 	int32_t SmokeLevel;
+	int32_t ParticleThreads; // worker threads for the particle simulation; 0 simulates on the main thread
 	bool VideoModule;
 	bool UpperBoard;
 	bool ShowClock;
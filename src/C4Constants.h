@@ -67,7 +67,6 @@ const int C4D_MaxName = C4MaxName,
           C4D_MaxIDLen = C4D_MaxName;
 
 const int C4Px_MaxParticle = 256, // maximum number of particles of one type
-          C4Px_BufSize = 128, // number of particles in one buffer
           C4Px_MaxIDLen = 30; // maximum length of internal identifiers
 
 const int C4SymbolSize = 35,
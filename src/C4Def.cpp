@@ -205,6 +205,7 @@ void C4DefCore::Default()
 	DragImagePicture = 0;
 	VehicleControl = 0;
 	Pathfinder = 0;
+	NavGrid = 0;
 	NoComponentMass = 0;
 	MoveToRange = 0;
 	NoStabilize = 0;
@@ -422,6 +423,7 @@ void C4DefCore::CompileFunc(StdCompiler *pComp)
 	pComp->Value(mkNamingAdapt(DragImagePicture,          "DragImagePicture",   0));
 	pComp->Value(mkNamingAdapt(VehicleControl,            "VehicleControl",     0));
 	pComp->Value(mkNamingAdapt(Pathfinder,                "Pathfinder",         0));
+	pComp->Value(mkNamingAdapt(NavGrid,                   "NavGrid",            0));
 	pComp->Value(mkNamingAdapt(MoveToRange,               "MoveToRange",        0));
 	pComp->Value(mkNamingAdapt(NoComponentMass,           "NoComponentMass",    0));
 	pComp->Value(mkNamingAdapt(NoStabilize,               "NoStabilize",        0));
@@ -246,6 +246,7 @@ public:
 	int32_t DragImagePicture;
 	int32_t VehicleControl;
 	int32_t Pathfinder;
+	int32_t NavGrid; // MoveTo searches the navigation grid before casting rays
 	int32_t MoveToRange;
 	int32_t Timer;
 	int32_t NoComponentMass;
@@ -66,6 +66,7 @@ C4Effect::C4Effect(C4Object *pForObj, const char *szName, int32_t iPrio, int32_t
 	riStoredAsNumber = 0;
 	iIntervall = iTimerIntervall;
 	iTime = 0;
+	iStartTick = GetTiming(pForObj).iTicks;
 	pCommandTarget = pCmdTarget;
 	idCommandTarget = idCmdTarget;
 	AssignCallbackFunctions();
@@ -91,6 +92,8 @@ C4Effect::C4Effect(C4Object *pForObj, const char *szName, int32_t iPrio, int32_t
 		pNext = *ppEffectList;
 		*ppEffectList = this;
 	}
+	// the list needs to be walked for the new effect's timer, or to delete it if it isn't validated
+	Reschedule(pForObj);
 	// no calls to be done: finished here
 	if (!fDoCalls) return;
 	// ask all effects with higher priority first - except for prio 1 effects, which are considered out of the priority call chain (as per doc)
@@ -125,7 +128,7 @@ C4Effect::C4Effect(C4Object *pForObj, const char *szName, int32_t iPrio, int32_t
 	if (pFnStart)
 		if (pFnStart->Exec(pCommandTarget, &C4AulParSet(C4VObj(pForObj), C4VInt(iNumber), C4VInt(0), rVal1, rVal2, rVal3, rVal4)).getInt() == C4Fx_Start_Deny)
 			// the effect denied to start: assume it hasn't, and mark it dead
-			SetDead();
+			SetDead(pForObj);
 	if (fRemoveUpper && pNext && pFnStart)
 		TempReaddUpperEffects(pForObj, pLastRemovedEffect);
 	if (pForObj && !pForObj->Status) return; // this will be invalid!
@@ -136,7 +139,7 @@ C4Effect::C4Effect(C4Object *pForObj, const char *szName, int32_t iPrio, int32_t
 C4Effect::C4Effect(StdCompiler *pComp) : EffectVars(0)
 {
 	// defaults
-	iNumber = iPriority = nCommandTarget = iTime = iIntervall = 0;
+	iNumber = iPriority = nCommandTarget = iTime = iIntervall = iStartTick = 0;
 	pCommandTarget = nullptr;
 	pNext = nullptr;
 	// compile
@@ -182,7 +185,7 @@ void C4Effect::DenumeratePointers()
 	} while (pEff = pEff->pNext);
 }
 
-void C4Effect::ClearPointers(C4Object *pObj)
+void C4Effect::ClearPointers(C4Object *pObj, C4Object *pForObj)
 {
 	// clear pointers in all effects
 	C4Effect *pEff = this;
@@ -190,7 +193,7 @@ void C4Effect::ClearPointers(C4Object *pObj)
 		// command target lost: effect dead w/o callback
 		if (pEff->pCommandTarget == pObj)
 		{
-			pEff->SetDead();
+			pEff->SetDead(pForObj);
 			pEff->pCommandTarget = nullptr;
 		}
 	while (pEff = pEff->pNext);
@@ -300,8 +303,34 @@ int32_t C4Effect::Check(C4Object *pForObj, const char *szCheckEffect, int32_t iP
 	return 0;
 }
 
+C4EffectTiming &C4Effect::GetTiming(C4Object *pForObj)
+{
+	return pForObj ? pForObj->EffectTiming : Game.GlobalEffectTiming;
+}
+
+void C4Effect::SaveTimes(C4Object *pForObj)
+{
+	for (C4Effect *pEff = this; pEff; pEff = pEff->pNext)
+		pEff->iTime = pEff->GetTime(pForObj);
+}
+
+void C4Effect::LoadTimes(C4Object *pForObj)
+{
+	C4EffectTiming &rTiming = GetTiming(pForObj);
+	rTiming.Default();
+	for (C4Effect *pEff = this; pEff; pEff = pEff->pNext)
+		pEff->iStartTick = -pEff->iTime;
+}
+
 void C4Effect::Execute(C4Object *pObj)
 {
+	// time elapsed for all effects
+	C4EffectTiming *pTiming = &GetTiming(pObj);
+	const int32_t iTicks = ++pTiming->iTicks;
+	// nothing to do until the next timer is due
+	if (iTicks < pTiming->iDueTick) return;
+	pTiming->iDueTick = INT32_MAX;
+	int32_t iDueTick = INT32_MAX;
 	// get effect list
 	C4Effect **ppEffectList = pObj ? &pObj->pEffects : &Game.pGlobalEffects;
 	// execute all effects not marked as dead
@@ -320,13 +349,14 @@ void C4Effect::Execute(C4Object *pObj)
 		}
 		else
 		{
-			// execute effect: time elapsed
-			++pEffect->iTime;
+			// effects added or reset during this execution are counted when they're reached
+			if (pEffect->iStartTick == iTicks) --pEffect->iStartTick;
 			// check timer execution
-			if (pEffect->iIntervall && !(pEffect->iTime % pEffect->iIntervall))
+			int32_t iTime = iTicks - pEffect->iStartTick;
+			if (pEffect->iIntervall && !(iTime % pEffect->iIntervall))
 				if (pEffect->pFnTimer)
 				{
-					if (pEffect->pFnTimer->Exec(pEffect->pCommandTarget, &C4AulParSet(C4VObj(pObj), C4VInt(pEffect->iNumber), C4VInt(pEffect->iTime))).getInt() == C4Fx_Execute_Kill)
+					if (pEffect->pFnTimer->Exec(pEffect->pCommandTarget, &C4AulParSet(C4VObj(pObj), C4VInt(pEffect->iNumber), C4VInt(iTime))).getInt() == C4Fx_Execute_Kill)
 					{
 						// safety: this class got deleted!
 						if (pObj && !pObj->Status) return;
@@ -339,11 +369,22 @@ void C4Effect::Execute(C4Object *pObj)
 				else
 					// no timer function: mark dead after time elapsed
 					pEffect->Kill(pObj);
+			// schedule next timer call - the callback might have changed the timer
+			if (pEffect->iIntervall && !pEffect->IsDead())
+			{
+				int32_t iIntervall = Abs(pEffect->iIntervall);
+				int32_t iPhase = (iTicks - pEffect->iStartTick) % iIntervall;
+				if (iPhase < 0) iPhase += iIntervall;
+				iDueTick = std::min(iDueTick, iTicks + iIntervall - iPhase);
+			}
 			// next effect
 			ppPrevEffect = &pEffect->pNext;
 			pEffect = pEffect->pNext;
 		}
 	} while (pEffect);
+	// changes during the callbacks may have requested an earlier walk
+	pTiming = &GetTiming(pObj);
+	pTiming->iDueTick = std::min(pTiming->iDueTick, iDueTick);
 }
 
 void C4Effect::Kill(C4Object *pObj)
@@ -358,7 +399,7 @@ void C4Effect::Kill(C4Object *pObj)
 		// this happens only if a lower priority effect removes an upper priority effect in its add- or removal-call
 		if (pFnStart && iPriority != 1) pFnStart->Exec(pCommandTarget, &C4AulParSet(C4VObj(pObj), C4VInt(iNumber), C4VInt(C4FxCall_TempAddForRemoval)));
 	// remove this effect
-	int32_t iPrevPrio = iPriority; SetDead();
+	int32_t iPrevPrio = iPriority; SetDead(pObj);
 	if (pFnStop)
 		if (pFnStop->Exec(pCommandTarget, &C4AulParSet(C4VObj(pObj), C4VInt(iNumber))).getInt() == C4Fx_Stop_Deny)
 			// effect denied to be removed: recover
@@ -375,7 +416,7 @@ void C4Effect::ClearAll(C4Object *pObj, int32_t iClearFlag)
 	if (pNext) pNext->ClearAll(pObj, iClearFlag);
 	if ((pObj && !pObj->Status) || IsDead()) return;
 	int32_t iPrevPrio = iPriority;
-	SetDead();
+	SetDead(pObj);
 	if (pFnStop)
 		if (pFnStop->Exec(pCommandTarget, &C4AulParSet(C4VObj(pObj), C4VInt(iNumber), C4VInt(iClearFlag))).getInt() == C4Fx_Stop_Deny)
 		{
@@ -569,12 +610,12 @@ int32_t FnFxFireStart(C4AulContext *ctx, C4Object *pObj, int32_t iNumber, int32_
 	{
 		// if object was blasted but not incinerated (i.e., inside extinguisher)
 		// do a script callback
-		if (fBlasted) pObj->Call(PSF_IncinerationEx, &C4AulParSet(C4VInt(iCausedBy)));
+		if (fBlasted) pObj->Call(PSFId_IncinerationEx, &C4AulParSet(C4VInt(iCausedBy)));
 		return -1;
 	}
 	// determine fire appearance
 	int32_t iFireMode;
-	if (!(iFireMode = pObj->Call(PSF_FireMode).getInt()))
+	if (!(iFireMode = pObj->Call(PSFId_FireMode).getInt()))
 	{
 		// set default fire modes
 		uint32_t dwCat = pObj->Category;
@@ -601,7 +642,7 @@ int32_t FnFxFireStart(C4AulContext *ctx, C4Object *pObj, int32_t iNumber, int32_
 	if (pObj->Shape.Wdt * pObj->Shape.Hgt > 500) StartSoundEffect("Inflame", false, 100, pObj);
 	if (pObj->Def->Mass >= 100) StartSoundEffect("Fire", true, 100, pObj);
 	// Engine script call
-	pObj->Call(PSF_Incineration, &C4AulParSet(C4VInt(iCausedBy)));
+	pObj->Call(PSFId_Incineration, &C4AulParSet(C4VInt(iCausedBy)));
 	// Done, success
 	return C4Fx_OK;
 }
@@ -835,7 +876,7 @@ void Smoke(int32_t tx, int32_t ty, int32_t level, uint32_t dwClr)
 	level = BoundBy<int32_t>(level, 3, 32);
 	C4Object *pObj;
 	if (pObj = Game.CreateObjectConstruction(C4Id("FXS1"), nullptr, NO_OWNER, tx, ty, FullCon * level / 32))
-		pObj->Call(PSF_Activate);
+		pObj->Call(PSFId_Activate);
 }
 
 void Explosion(int32_t tx, int32_t ty, int32_t level, C4Object *inobj, int32_t iCausedBy, C4Object *pByObj, C4ID idEffect, const char *szEffect)
@@ -873,7 +914,7 @@ void Explosion(int32_t tx, int32_t ty, int32_t level, C4Object *inobj, int32_t i
 				Game.Particles.Cast(Game.Particles.pFSpark, level / 5 + 1, (float)tx, (float)ty, level, level / 2 + 1.0f, 0x00ef0000, level + 1.0f, 0xffff1010);
 		}
 		else if (pBlast = Game.CreateObjectConstruction(idEffect ? idEffect : C4Id("FXB1"), pByObj, iCausedBy, tx, ty + level, FullCon * level / 20))
-			pBlast->Call(PSF_Activate);
+			pBlast->Call(PSFId_Activate);
 	}
 	// Blast objects
 	Game.BlastObjects(tx, ty, level, inobj, iCausedBy, pByObj);
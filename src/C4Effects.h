@@ -69,6 +69,16 @@ typedef unsigned long C4ID;
 #define C4Fx_FireMode_Object    3 // other (C4D_Object and no bit set (magic))
 #define C4Fx_FireMode_Last      3 // largest valid fire mode
 
+// execution timing of an effect list
+// effect times count the executions of their list, so they are kept relative to the list's tick counter
+struct C4EffectTiming
+{
+	int32_t iTicks; // number of executions of the list
+	int32_t iDueTick; // tick at which the list needs to be walked: any timer due or any effect to be deleted
+
+	void Default() { iTicks = iDueTick = 0; }
+};
+
 // generic object effect
 class C4Effect
 {
@@ -80,7 +90,8 @@ public:
 
 	int32_t iPriority; // effect priority for sorting into effect list; -1 indicates a dead effect
 	C4ValueList EffectVars; // custom effect variables
-	int32_t iTime, iIntervall; // effect time; effect callback intervall
+	int32_t iTime, iIntervall; // effect time (only valid when saved or loaded - use GetTime); effect callback intervall
+	int32_t iStartTick; // tick of the effect list at which the effect time was zero
 	int32_t iNumber; // effect number for addressing
 
 	C4Effect *pNext; // next effect in linked list
@@ -101,9 +112,9 @@ public:
 
 	void EnumeratePointers(); // object pointers to numbers
 	void DenumeratePointers(); // numbers to object pointers
-	void ClearPointers(C4Object *pObj); // clear all pointers to object - may kill some effects w/o callback, because the callback target is lost
+	void ClearPointers(C4Object *pObj, C4Object *pForObj); // clear all pointers to object - may kill some effects w/o callback, because the callback target is lost
 
-	void SetDead()              { iPriority = 0; }        // mark effect to be removed in next execution cycle
+	void SetDead(C4Object *pForObj) { iPriority = 0; Reschedule(pForObj); } // mark effect to be removed in next execution cycle
 	bool IsDead()               { return !iPriority; }    // return whether effect is to be removed
 	void FlipActive()           { iPriority *= -1; }      // alters activation status
 	bool IsActive()             { return iPriority > 0; } // returns whether effect is active
@@ -116,6 +127,12 @@ public:
 	C4AulScript *GetCallbackScript(); // get script context for effect callbacks
 
 	void Execute(C4Object *pObj); // execute all effects
+	int32_t GetTime(C4Object *pForObj) { return GetTiming(pForObj).iTicks - iStartTick; } // get effect time
+	void SetTime(C4Object *pForObj, int32_t iToTime) { iStartTick = GetTiming(pForObj).iTicks - iToTime; Reschedule(pForObj); }
+	void SaveTimes(C4Object *pForObj); // store time of all effects in iTime for saving
+	void LoadTimes(C4Object *pForObj); // restart list timing from loaded iTime of all effects
+	static C4EffectTiming &GetTiming(C4Object *pForObj); // timing of object or global effect list
+	static void Reschedule(C4Object *pForObj) { GetTiming(pForObj).iDueTick = 0; } // effect list changed: walk it in next execution
 	void Kill(C4Object *pObj); // mark this effect deleted and do approprioate calls
 	void ClearAll(C4Object *pObj, int32_t iClearFlag); // kill all effects doing removal calls w/o reagard of inactive effects
 	void DoDamage(C4Object *pObj, int32_t &riDamage, int32_t iDamageType, int32_t iCausePlr); // ask all effects for damage
@@ -22,10 +22,15 @@
 #include <C4Game.h>
 #include <C4Wrappers.h>
 #include <C4Random.h>
+#include <C4Log.h>
 #endif
 
+#include <algorithm>
+
 // *** C4FindObject
 
+uint32_t C4FindObject::CheckCount = 0;
+
 C4FindObject::~C4FindObject()
 {
 	delete pSort;
@@ -170,7 +175,7 @@ int32_t C4FindObject::Count(const C4ObjectList &Objs)
 	int32_t iCount = 0;
 	for (C4ObjectLink *pLnk = Objs.First; pLnk; pLnk = pLnk->Next)
 		if (pLnk->Obj->Status)
-			if (Check(pLnk->Obj))
+			if (CountedCheck(pLnk->Obj))
 				iCount++;
 	return iCount;
 }
@@ -185,7 +190,7 @@ C4Object *C4FindObject::Find(const C4ObjectList &Objs)
 	C4Object *pBestResult = nullptr;
 	for (C4ObjectLink *pLnk = Objs.First; pLnk; pLnk = pLnk->Next)
 		if (pLnk->Obj->Status)
-			if (Check(pLnk->Obj))
+			if (CountedCheck(pLnk->Obj))
 				if (pLnk->Obj->Status)
 				{
 					// no sorting: Use first object found
@@ -209,7 +214,7 @@ C4ValueArray *C4FindObject::FindMany(const C4ObjectList &Objs)
 	// Search
 	for (C4ObjectLink *pLnk = Objs.First; pLnk; pLnk = pLnk->Next)
 		if (pLnk->Obj->Status)
-			if (Check(pLnk->Obj))
+			if (CountedCheck(pLnk->Obj))
 			{
 				// Grow the array, if neccessary
 				if (iSize >= pArray->GetSize())
@@ -226,6 +231,116 @@ C4ValueArray *C4FindObject::FindMany(const C4ObjectList &Objs)
 	return pArray;
 }
 
+C4FindObjectPlan C4FindObject::GetPlan(const C4ObjectList &Objs, bool fSorted)
+{
+	// Default: scan list or sectors
+	C4FindObjectPlan Plan;
+	Plan.pCandidates = &Objs;
+	Plan.pBounds = GetBounds();
+	Plan.fUseShapes = Plan.pBounds && UseShapes();
+	Plan.Access = Plan.pBounds ? C4FOA_Sectors : C4FOA_List;
+	// Indices only cover the main list. Candidates are checked in a different order,
+	// which scripts might notice - or even change the indices while they are scanned.
+	if (&Objs != &Game.Objects || HasSideEffects() || (fSorted && pSort && pSort->HasSideEffects()))
+		return Plan;
+	// Estimate the number of objects the default scan visits
+	int32_t iBestCount = Game.Objects.GetIndexedCount();
+	if (Plan.pBounds && Game.Objects.Sectors.Size)
+	{
+		C4LArea Area(&Game.Objects.Sectors, *Plan.pBounds);
+		int32_t iSectors = 0;
+		for (C4LSector *pSct = Area.First(); pSct; pSct = Area.Next(pSct))
+			++iSectors;
+		iBestCount = iBestCount * iSectors / Game.Objects.Sectors.Size;
+	}
+	// Use the most selective restriction
+	const C4ObjectList *pList; int32_t iCount;
+	C4ID idIndex = GetIndexID();
+	if (idIndex != C4ID_None)
+		if (pList = Game.Objects.GetIDIndex(idIndex, iCount))
+			if (iCount < iBestCount)
+			{
+				Plan.Access = C4FOA_IDIndex; Plan.pCandidates = pList; iBestCount = iCount;
+			}
+	int32_t iIndexCategory = GetIndexCategory();
+	if (iIndexCategory)
+		if (pList = Game.Objects.GetCategoryIndex(iIndexCategory, iCount))
+			if (iCount < iBestCount)
+			{
+				Plan.Access = C4FOA_CategoryIndex; Plan.pCandidates = pList; iBestCount = iCount;
+			}
+	C4Object *pContainer = GetIndexContainer();
+	if (pContainer && pContainer->Status)
+		if ((iCount = pContainer->Contents.ObjectCount()) < iBestCount)
+		{
+			Plan.Access = C4FOA_Contents; Plan.pCandidates = &pContainer->Contents; iBestCount = iCount;
+		}
+	return Plan;
+}
+
+uint32_t C4FindObject::GetResultDependencies()
+{
+	// The set of searched objects and their order always matter
+	uint32_t dwDependencies = (1 << C4FOD_Objects) | GetDependencies();
+	if (pSort) dwDependencies |= pSort->GetDependencies();
+	return dwDependencies;
+}
+
+// Position of a sector in the scan order of the area; -1 if it is not part of the area
+static int32_t GetSectorRank(const C4LArea &Area, C4LSector *pSct)
+{
+	if (!Area.Contains(pSct)) return -1;
+	// the outside-sector is scanned last
+	if (pSct == Area.pOut) return INT32_MAX;
+	return (pSct->y - Area.pFirst->y) * Game.Objects.Sectors.Wdt + pSct->x - Area.pFirst->x;
+}
+
+void C4FindObject::FindCandidates(const C4FindObjectPlan &Plan, std::vector<C4Object *> &rResult, bool fOrdered)
+{
+	// Check all candidates (only objects of the main list, as the default scan would)
+	for (C4ObjectLink *pLnk = Plan.pCandidates->First; pLnk; pLnk = pLnk->Next)
+		if (pLnk->Obj->Status == C4OS_NORMAL)
+			if (CountedCheck(pLnk->Obj))
+				rResult.push_back(pLnk->Obj);
+	// Indices and contents aren't sorted like the main list
+	if (fOrdered && rResult.size() > 1)
+	{
+		::Game.Objects.UpdateListOrder();
+		std::sort(rResult.begin(), rResult.end(),
+			[](C4Object *pObj1, C4Object *pObj2) { return pObj1->ListOrder < pObj2->ListOrder; });
+	}
+	// Without bounds, the default is a main list scan
+	if (!Plan.pBounds) return;
+	// Otherwise, only objects listed in the area's sectors are found, in the order the sectors are scanned
+	C4LArea Area(&Game.Objects.Sectors, *Plan.pBounds);
+	std::vector<std::pair<int32_t, C4Object *>> Ranked;
+	for (C4Object *pObj : rResult)
+	{
+		if (pObj->Area.IsNull()) continue;
+		int32_t iRank = -1;
+		if (Plan.fUseShapes)
+		{
+			// first sector of the area the shape is listed in
+			for (C4LSector *pSct = pObj->Area.First(); pSct; pSct = pObj->Area.Next(pSct))
+			{
+				int32_t iSctRank = GetSectorRank(Area, pSct);
+				if (iSctRank >= 0 && (iRank < 0 || iSctRank < iRank))
+					iRank = iSctRank;
+			}
+		}
+		else
+			iRank = GetSectorRank(Area, Game.Objects.Sectors.SectorAt(pObj->old_x, pObj->old_y));
+		if (iRank >= 0)
+			Ranked.push_back(std::make_pair(iRank, pObj));
+	}
+	if (fOrdered)
+		std::stable_sort(Ranked.begin(), Ranked.end(),
+			[](const std::pair<int32_t, C4Object *> &a, const std::pair<int32_t, C4Object *> &b) { return a.first < b.first; });
+	rResult.clear();
+	for (const std::pair<int32_t, C4Object *> &Entry : Ranked)
+		rResult.push_back(Entry.second);
+}
+
 int32_t C4FindObject::Count(const C4ObjectList &Objs, const C4LSectors &Sct)
 {
 	// Trivial cases
@@ -233,6 +348,16 @@ int32_t C4FindObject::Count(const C4ObjectList &Objs, const C4LSectors &Sct)
 		return 0;
 	if (IsEnsured())
 		return Objs.ObjectCount();
+	// Restricted to an index or container?
+	C4FindObjectPlan Plan = GetPlan(Objs, false);
+	if (Plan.Access >= C4FOA_IDIndex)
+	{
+		if (!Plan.pBounds && Plan.Access != C4FOA_Contents)
+			return Count(*Plan.pCandidates);
+		std::vector<C4Object *> Objects;
+		FindCandidates(Plan, Objects, false);
+		return Objects.size();
+	}
 	// Check bounds
 	C4Rect *pBounds = GetBounds();
 	if (!pBounds)
@@ -254,7 +379,7 @@ int32_t C4FindObject::Count(const C4ObjectList &Objs, const C4LSectors &Sct)
 					if (pLnk->Obj->Marker != iMarker)
 					{
 						pLnk->Obj->Marker = iMarker;
-						if (Check(pLnk->Obj))
+						if (CountedCheck(pLnk->Obj))
 							iCount++;
 					}
 		return iCount;
@@ -276,6 +401,23 @@ C4Object *C4FindObject::Find(const C4ObjectList &Objs, const C4LSectors &Sct)
 	if (IsImpossible())
 		return nullptr;
 	C4Object *pBestResult = nullptr;
+	// Restricted to an index or container?
+	C4FindObjectPlan Plan = GetPlan(Objs, true);
+	if (Plan.Access >= C4FOA_IDIndex)
+	{
+		std::vector<C4Object *> Objects;
+		FindCandidates(Plan, Objects, true);
+		for (C4Object *pObj : Objects)
+			if (pObj->Status)
+			{
+				// no sorting: Use first object found
+				if (!pSort) return pObj;
+				// Sorting: Check if found object is better
+				if (!pBestResult || pSort->Compare(pObj, pBestResult) > 0)
+					pBestResult = pObj;
+			}
+		return pBestResult;
+	}
 	// Check bounds
 	C4Rect *pBounds = GetBounds();
 	if (!pBounds)
@@ -313,11 +455,26 @@ C4ValueArray *C4FindObject::FindMany(const C4ObjectList &Objs, const C4LSectors
 	// Trivial case
 	if (IsImpossible())
 		return new C4ValueArray();
+	// Prepare for array that may be generated
+	C4ValueArray *pArray; int32_t iSize;
+	// Restricted to an index or container?
+	C4FindObjectPlan Plan = GetPlan(Objs, true);
+	if (Plan.Access >= C4FOA_IDIndex)
+	{
+		std::vector<C4Object *> Objects;
+		FindCandidates(Plan, Objects, true);
+		pArray = new C4ValueArray(Objects.size()); iSize = 0;
+		for (C4Object *pObj : Objects)
+			(*pArray)[iSize++] = C4VObj(pObj);
+		// Recheck object status (may shrink array)
+		CheckObjectStatus(pArray);
+		// Apply sorting
+		if (pSort) pSort->SortObjects(pArray);
+		return pArray;
+	}
 	C4Rect *pBounds = GetBounds();
 	if (!pBounds)
 		return FindMany(Objs);
-	// Prepare for array that may be generated
-	C4ValueArray *pArray; int32_t iSize;
 	// Check shape lists?
 	if (UseShapes())
 	{
@@ -337,7 +494,7 @@ C4ValueArray *C4FindObject::FindMany(const C4ObjectList &Objs, const C4LSectors
 					if (pLnk->Obj->Marker != iMarker)
 					{
 						pLnk->Obj->Marker = iMarker;
-						if (Check(pLnk->Obj))
+						if (CountedCheck(pLnk->Obj))
 						{
 							// Grow the array, if neccessary
 							if (iSize >= pArray->GetSize())
@@ -356,7 +513,7 @@ C4ValueArray *C4FindObject::FindMany(const C4ObjectList &Objs, const C4LSectors
 		for (C4ObjectList *pLst = Area.FirstObjects(&pSct); pLst; pLst = Area.NextObjects(pLst, &pSct))
 			for (C4ObjectLink *pLnk = pLst->First; pLnk; pLnk = pLnk->Next)
 				if (pLnk->Obj->Status)
-					if (Check(pLnk->Obj))
+					if (CountedCheck(pLnk->Obj))
 					{
 						// Grow the array, if neccessary
 						if (iSize >= pArray->GetSize())
@@ -476,6 +633,49 @@ bool C4FindObjectAnd::IsImpossible()
 	return false;
 }
 
+C4ID C4FindObjectAnd::GetIndexID()
+{
+	C4ID idIndex;
+	for (int32_t i = 0; i < iCnt; i++)
+		if ((idIndex = ppConds[i]->GetIndexID()) != C4ID_None)
+			return idIndex;
+	return C4ID_None;
+}
+
+int32_t C4FindObjectAnd::GetIndexCategory()
+{
+	int32_t iIndexCategory;
+	for (int32_t i = 0; i < iCnt; i++)
+		if (iIndexCategory = ppConds[i]->GetIndexCategory())
+			return iIndexCategory;
+	return 0;
+}
+
+C4Object *C4FindObjectAnd::GetIndexContainer()
+{
+	C4Object *pContainer;
+	for (int32_t i = 0; i < iCnt; i++)
+		if (pContainer = ppConds[i]->GetIndexContainer())
+			return pContainer;
+	return nullptr;
+}
+
+bool C4FindObjectAnd::HasSideEffects()
+{
+	for (int32_t i = 0; i < iCnt; i++)
+		if (ppConds[i]->HasSideEffects())
+			return true;
+	return false;
+}
+
+uint32_t C4FindObjectAnd::GetDependencies()
+{
+	uint32_t dwDependencies = 0;
+	for (int32_t i = 0; i < iCnt; i++)
+		dwDependencies |= ppConds[i]->GetDependencies();
+	return dwDependencies;
+}
+
 // *** C4FindObjectOr
 
 C4FindObjectOr::C4FindObjectOr(int32_t inCnt, C4FindObject **ppConds)
@@ -538,6 +738,22 @@ bool C4FindObjectOr::IsEnsured()
 	return false;
 }
 
+bool C4FindObjectOr::HasSideEffects()
+{
+	for (int32_t i = 0; i < iCnt; i++)
+		if (ppConds[i]->HasSideEffects())
+			return true;
+	return false;
+}
+
+uint32_t C4FindObjectOr::GetDependencies()
+{
+	uint32_t dwDependencies = 0;
+	for (int32_t i = 0; i < iCnt; i++)
+		dwDependencies |= ppConds[i]->GetDependencies();
+	return dwDependencies;
+}
+
 // *** C4FindObject* (primitive conditions)
 
 bool C4FindObjectExclude::Check(C4Object *pObj)
@@ -868,6 +1084,22 @@ bool C4SortObjectMultiple::PrepareCache(const C4ValueList *pObjs)
 	return fCaches;
 }
 
+bool C4SortObjectMultiple::HasSideEffects()
+{
+	for (int32_t i = 0; i < iCnt; ++i)
+		if (ppSorts[i]->HasSideEffects())
+			return true;
+	return false;
+}
+
+uint32_t C4SortObjectMultiple::GetDependencies()
+{
+	uint32_t dwDependencies = 0;
+	for (int32_t i = 0; i < iCnt; ++i)
+		dwDependencies |= ppSorts[i]->GetDependencies();
+	return dwDependencies;
+}
+
 int32_t C4SortObjectMultiple::CompareCache(int32_t iObj1, int32_t iObj2, C4Object *pObj1, C4Object *pObj2)
 {
 	// return first comparison that's nonzero
@@ -928,3 +1160,131 @@ int32_t C4SortObjectFunc::CompareGetValue(C4Object *pObj)
 	// Call
 	return pCallFunc->Exec(pObj, &Pars).getInt();
 }
+
+// *** C4FindObjectCache
+
+const size_t C4FOC_MaxEntries = 1024; // per frame
+
+void C4FindObjectCache::Default()
+{
+	Enabled = false;
+	Entries.clear();
+	std::fill(Versions, std::end(Versions), 0);
+	PendingKey.clear();
+	dwPendingDependencies = iPendingCheckCount = 0;
+	fPending = false;
+	ResetStats();
+}
+
+void C4FindObjectCache::Clear()
+{
+	Entries.clear();
+	fPending = false;
+}
+
+// Append a value to a cache key. Criteria that only differ in the order of
+// their And/Or operands yield the same key.
+static bool AppendCacheKey(std::string &rKey, const C4Value &Value)
+{
+	const C4Value &Val = Value.GetRefVal();
+	switch (Val.GetType())
+	{
+	case C4V_Any: rKey += 'n'; return true;
+	case C4V_Int: rKey += 'i'; rKey += std::to_string(Val._getInt()); return true;
+	case C4V_Bool: rKey += Val._getBool() ? 't' : 'f'; return true;
+	case C4V_C4ID: rKey += 'd'; rKey += std::to_string(Val._getC4ID()); return true;
+	case C4V_C4Object:
+		if (!Val._getObj()->Status) return false;
+		rKey += 'o'; rKey += std::to_string(Val._getObj()->Number); return true;
+	case C4V_String:
+		rKey += 's'; rKey += std::to_string(Val._getStr()->Data.getLength()); rKey += ':';
+		rKey.append(Val._getStr()->Data.getData(), Val._getStr()->Data.getLength());
+		return true;
+	case C4V_Array:
+	{
+		const C4ValueArray &Data = *Val._getArray();
+		const C4Value &Type = Data.GetItem(0).GetRefVal();
+		bool fUnordered = Type.GetType() == C4V_Int && (Type._getInt() == C4FO_And || Type._getInt() == C4FO_Or);
+		std::vector<std::string> Items(Data.GetSize());
+		for (int32_t i = 0; i < Data.GetSize(); i++)
+			if (!AppendCacheKey(Items[i], Data.GetItem(i)))
+				return false;
+		if (fUnordered) std::sort(Items.begin() + 1, Items.end());
+		rKey += '[';
+		for (const std::string &Item : Items) { rKey += Item; rKey += ','; }
+		rKey += ']';
+		return true;
+	}
+	default: return false;
+	}
+}
+
+bool C4FindObjectCache::Lookup(char cQuery, C4Value *pPars, C4FindObject *pFO, C4Value &rResult)
+{
+	fPending = false;
+	if (!Enabled) return false;
+	// Results depending on untracked state can't be cached
+	uint32_t dwDependencies = pFO->GetResultDependencies();
+	if (dwDependencies & C4FOD_Uncacheable) return false;
+	// Build key: search criteria in any order, sort criteria in given order
+	std::vector<std::string> Criteria;
+	std::string Key(1, cQuery), SortKey;
+	for (int32_t i = 0; i < C4AUL_MAX_Par; i++)
+	{
+		if (!pPars[i]) break;
+		std::string Item;
+		if (!AppendCacheKey(Item, pPars[i])) return false;
+		const C4ValueArray *pArray = pPars[i].getArray();
+		if (pArray && Inside<int32_t>(C4Value(pArray->GetItem(0)).getInt(), C4SO_First, C4SO_Last))
+			SortKey += Item;
+		else
+			Criteria.push_back(Item);
+	}
+	std::sort(Criteria.begin(), Criteria.end());
+	for (const std::string &Item : Criteria) Key += Item;
+	Key += '|'; Key += SortKey;
+	++iLookups;
+	// Cached result still valid?
+	auto Found = Entries.find(Key);
+	if (Found != Entries.end())
+	{
+		Entry &rEntry = Found->second;
+		bool fValid = true;
+		for (int32_t i = 0; i < C4FOD_Count; i++)
+			if (rEntry.dwDependencies & (1 << i))
+				if (rEntry.Versions[i] != Versions[i])
+					fValid = false;
+		if (fValid)
+		{
+			++iHits;
+			iSavedChecks += rEntry.iCheckCount;
+			rResult = rEntry.Result;
+			return true;
+		}
+		Entries.erase(Found);
+	}
+	// Prepare storing the result
+	if (Entries.size() >= C4FOC_MaxEntries) return false;
+	PendingKey.swap(Key);
+	dwPendingDependencies = dwDependencies;
+	iPendingCheckCount = C4FindObject::CheckCount;
+	fPending = true;
+	return false;
+}
+
+void C4FindObjectCache::Store(const C4Value &Result)
+{
+	if (!fPending) return;
+	fPending = false;
+	Entry &rEntry = Entries[PendingKey];
+	rEntry.Result = Result;
+	rEntry.dwDependencies = dwPendingDependencies;
+	std::copy(Versions, std::end(Versions), rEntry.Versions);
+	rEntry.iCheckCount = C4FindObject::CheckCount - iPendingCheckCount;
+}
+
+void C4FindObjectCache::ShowStats()
+{
+	LogF("FindObject cache: %d lookups, %d hits (%d%%), %u Check calls saved",
+		iLookups, iHits, iLookups ? iHits * 100 / iLookups : 0, iSavedChecks);
+}
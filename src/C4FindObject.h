@@ -21,6 +21,10 @@
 #include "C4Value.h"
 #include "C4Aul.h"
 
+#include <map>
+#include <string>
+#include <vector>
+
 // Condition map
 enum C4FindObjectCondID
 {
@@ -61,6 +65,37 @@ enum C4SortObjectCondID
 	C4SO_Last = 200, // no sort condition larger than this
 };
 
+// Access paths the query planner may choose
+enum C4FindObjectAccess
+{
+	C4FOA_List = 0, // scan the given list
+	C4FOA_Sectors = 1, // scan the sector lists covering the bounds
+	C4FOA_IDIndex = 2, // scan the per-ID object index
+	C4FOA_CategoryIndex = 3, // scan the per-category object index
+	C4FOA_Contents = 4, // scan the contents of the searched container
+};
+
+// Query plan: access path and the candidate list for index and contents access
+struct C4FindObjectPlan
+{
+	C4FindObjectAccess Access;
+	const C4ObjectList *pCandidates;
+	C4Rect *pBounds; bool fUseShapes; // bounds of the sector area candidates must be listed in
+};
+
+// Object state a search result depends on
+enum C4FindObjectDependency
+{
+	C4FOD_Objects = 0, // object creation and removal, list order, ID, category, containment, layer
+	C4FOD_Position = 1, // object positions and shapes
+	C4FOD_OCF = 2,
+	C4FOD_Owner = 3,
+	C4FOD_Action = 4,
+	C4FOD_Count = 5,
+};
+
+const uint32_t C4FOD_Uncacheable = 1u << C4FOD_Count; // result depends on state that isn't tracked
+
 // Base class
 class C4FindObject
 {
@@ -86,6 +121,11 @@ public:
 
 	void SetSort(C4SortObject *pToSort);
 
+	C4FindObjectPlan GetPlan(const C4ObjectList &Objs, bool fSorted); // choose the most selective access path; fSorted: the sort is applied
+	uint32_t GetResultDependencies(); // mask of (1 << C4FOD_*) the result of a search in the main list depends on
+
+	static uint32_t CheckCount; // number of objects checked by searches
+
 protected:
 	// Overridables
 	virtual bool Check(C4Object *pObj) = 0;
@@ -94,8 +134,19 @@ protected:
 	virtual bool IsImpossible() { return false; }
 	virtual bool IsEnsured() { return false; }
 
+	// Query planner hints: restrictions every found object fulfills
+	virtual C4ID GetIndexID() { return C4ID_None; }
+	virtual int32_t GetIndexCategory() { return 0; }
+	virtual C4Object *GetIndexContainer() { return nullptr; }
+	virtual bool HasSideEffects() { return false; } // Check might run script
+
+	// Result cache hint: mask of (1 << C4FOD_*) Check depends on
+	virtual uint32_t GetDependencies() { return C4FOD_Uncacheable; }
+
 private:
+	bool CountedCheck(C4Object *pObj) { ++CheckCount; return Check(pObj); }
 	void CheckObjectStatus(C4ValueArray *pArray);
+	void FindCandidates(const C4FindObjectPlan &Plan, std::vector<C4Object *> &rResult, bool fOrdered); // all matching candidates, optionally in the order of the default scan
 };
 
 // Combinators
@@ -113,6 +164,8 @@ protected:
 	virtual bool Check(C4Object *pObj);
 	virtual bool IsImpossible() { return pCond->IsEnsured(); }
 	virtual bool IsEnsured() { return pCond->IsImpossible(); }
+	virtual bool HasSideEffects() { return pCond->HasSideEffects(); }
+	virtual uint32_t GetDependencies() { return pCond->GetDependencies(); }
 };
 
 class C4FindObjectAnd : public C4FindObject
@@ -132,6 +185,11 @@ protected:
 	virtual bool UseShapes() { return fUseShapes; }
 	virtual bool IsEnsured() { return !iCnt; }
 	virtual bool IsImpossible();
+	virtual C4ID GetIndexID();
+	virtual int32_t GetIndexCategory();
+	virtual C4Object *GetIndexContainer();
+	virtual bool HasSideEffects();
+	virtual uint32_t GetDependencies();
 };
 
 class C4FindObjectOr : public C4FindObject
@@ -150,6 +208,8 @@ protected:
 	virtual C4Rect *GetBounds() { return fHasBounds ? &Bounds : nullptr; }
 	virtual bool IsEnsured();
 	virtual bool IsImpossible() { return !iCnt; }
+	virtual bool HasSideEffects();
+	virtual uint32_t GetDependencies();
 };
 
 // Primitive conditions
@@ -164,6 +224,7 @@ private:
 
 protected:
 	virtual bool Check(C4Object *pObj);
+	virtual uint32_t GetDependencies() { return 0; }
 };
 
 class C4FindObjectID : public C4FindObject
@@ -178,6 +239,8 @@ private:
 protected:
 	virtual bool Check(C4Object *pObj);
 	virtual bool IsImpossible();
+	virtual C4ID GetIndexID() { return id; }
+	virtual uint32_t GetDependencies() { return 1 << C4FOD_Objects; }
 };
 
 class C4FindObjectInRect : public C4FindObject
@@ -192,6 +255,7 @@ private:
 protected:
 	virtual bool Check(C4Object *pObj);
 	virtual C4Rect *GetBounds() { return &rect; }
+	virtual uint32_t GetDependencies() { return 1 << C4FOD_Position; }
 	virtual bool IsImpossible();
 };
 
@@ -207,6 +271,7 @@ private:
 protected:
 	virtual bool Check(C4Object *pObj);
 	virtual C4Rect *GetBounds() { return &bounds; }
+	virtual uint32_t GetDependencies() { return 1 << C4FOD_Position; }
 	virtual bool UseShapes() { return true; }
 };
 
@@ -222,6 +287,7 @@ private:
 protected:
 	virtual bool Check(C4Object *pObj);
 	virtual C4Rect *GetBounds() { return &bounds; }
+	virtual uint32_t GetDependencies() { return 1 << C4FOD_Position; }
 	virtual bool UseShapes() { return true; }
 };
 
@@ -241,6 +307,7 @@ private:
 protected:
 	virtual bool Check(C4Object *pObj);
 	virtual C4Rect *GetBounds() { return &bounds; }
+	virtual uint32_t GetDependencies() { return 1 << C4FOD_Position; }
 	virtual bool UseShapes() { return true; }
 };
 
@@ -257,6 +324,7 @@ private:
 protected:
 	virtual bool Check(C4Object *pObj);
 	virtual C4Rect *GetBounds() { return &bounds; }
+	virtual uint32_t GetDependencies() { return 1 << C4FOD_Position; }
 };
 
 class C4FindObjectOCF : public C4FindObject
@@ -271,6 +339,7 @@ private:
 protected:
 	virtual bool Check(C4Object *pObj);
 	virtual bool IsImpossible();
+	virtual uint32_t GetDependencies() { return 1 << C4FOD_OCF; }
 };
 
 class C4FindObjectCategory : public C4FindObject
@@ -285,6 +354,8 @@ private:
 protected:
 	virtual bool Check(C4Object *pObj);
 	virtual bool IsEnsured();
+	virtual int32_t GetIndexCategory() { return iCategory; }
+	virtual uint32_t GetDependencies() { return 1 << C4FOD_Objects; }
 };
 
 class C4FindObjectAction : public C4FindObject
@@ -298,6 +369,7 @@ private:
 
 protected:
 	virtual bool Check(C4Object *pObj);
+	virtual uint32_t GetDependencies() { return 1 << C4FOD_Action; }
 };
 
 class C4FindObjectActionTarget : public C4FindObject
@@ -325,6 +397,8 @@ private:
 
 protected:
 	virtual bool Check(C4Object *pObj);
+	virtual C4Object *GetIndexContainer() { return pContainer; }
+	virtual uint32_t GetDependencies() { return 1 << C4FOD_Objects; }
 };
 
 class C4FindObjectAnyContainer : public C4FindObject
@@ -334,6 +408,7 @@ public:
 
 protected:
 	virtual bool Check(C4Object *pObj);
+	virtual uint32_t GetDependencies() { return 1 << C4FOD_Objects; }
 };
 
 class C4FindObjectOwner : public C4FindObject
@@ -348,6 +423,7 @@ private:
 protected:
 	virtual bool Check(C4Object *pObj);
 	virtual bool IsImpossible();
+	virtual uint32_t GetDependencies() { return 1 << C4FOD_Owner; }
 };
 
 class C4FindObjectFunc : public C4FindObject
@@ -363,6 +439,7 @@ private:
 protected:
 	virtual bool Check(C4Object *pObj);
 	virtual bool IsImpossible();
+	virtual bool HasSideEffects() { return true; }
 };
 
 class C4FindObjectLayer : public C4FindObject
@@ -376,6 +453,7 @@ private:
 protected:
 	virtual bool Check(C4Object *pObj);
 	virtual bool IsImpossible();
+	virtual uint32_t GetDependencies() { return 1 << C4FOD_Objects; }
 };
 
 class C4FindObjectController : public C4FindObject
@@ -406,6 +484,9 @@ public:
 	virtual bool PrepareCache(const C4ValueList *pObjs) { return false; }
 	virtual int32_t CompareCache(int32_t iObj1, int32_t iObj2, C4Object *pObj1, C4Object *pObj2) { return Compare(pObj1, pObj2); }
 
+	virtual bool HasSideEffects() { return false; } // Compare might run script or consume random numbers
+	virtual uint32_t GetDependencies() { return C4FOD_Uncacheable; } // mask of (1 << C4FOD_*) Compare depends on
+
 public:
 	static C4SortObject *CreateByValue(const C4Value &Data);
 	static C4SortObject *CreateByValue(int32_t iType, const C4ValueArray &Data);
@@ -447,6 +528,8 @@ protected:
 
 	virtual bool PrepareCache(const C4ValueList *pObjs);
 	virtual int32_t CompareCache(int32_t iObj1, int32_t iObj2, C4Object *pObj1, C4Object *pObj2);
+	virtual bool HasSideEffects() { return pSort->HasSideEffects(); }
+	virtual uint32_t GetDependencies() { return pSort->GetDependencies(); }
 };
 
 class C4SortObjectMultiple : public C4SortObject // apply next sort if previous compares to equality
@@ -466,6 +549,8 @@ protected:
 
 	virtual bool PrepareCache(const C4ValueList *pObjs);
 	virtual int32_t CompareCache(int32_t iObj1, int32_t iObj2, C4Object *pObj1, C4Object *pObj2);
+	virtual bool HasSideEffects();
+	virtual uint32_t GetDependencies();
 };
 
 class C4SortObjectDistance : public C4SortObjectByValue // sort by distance from point x/y
@@ -479,6 +564,7 @@ private:
 
 protected:
 	int32_t CompareGetValue(C4Object *pFor);
+	virtual uint32_t GetDependencies() { return 1 << C4FOD_Position; }
 };
 
 class C4SortObjectRandom : public C4SortObjectByValue // randomize order
@@ -488,6 +574,7 @@ public:
 
 protected:
 	int32_t CompareGetValue(C4Object *pFor);
+	virtual bool HasSideEffects() { return true; }
 };
 
 class C4SortObjectSpeed : public C4SortObjectByValue // sort by object xdir/ydir
@@ -515,6 +602,7 @@ public:
 
 protected:
 	int32_t CompareGetValue(C4Object *pFor);
+	virtual bool HasSideEffects() { return true; } // CalcValue/CalcSellValue scripts
 };
 
 class C4SortObjectFunc : public C4SortObjectByValue // sort by script function
@@ -529,4 +617,46 @@ private:
 
 protected:
 	int32_t CompareGetValue(C4Object *pFor);
+	virtual bool HasSideEffects() { return true; }
+};
+
+// Per-frame cache of script search results
+class C4FindObjectCache
+{
+public:
+	C4FindObjectCache() { Default(); }
+
+	bool Enabled; // opt-in: SetFindObjectCache
+
+private:
+	struct Entry
+	{
+		C4Value Result;
+		uint32_t dwDependencies;
+		uint32_t Versions[C4FOD_Count];
+		uint32_t iCheckCount; // Check calls the search took
+	};
+
+	std::map<std::string, Entry> Entries;
+	uint32_t Versions[C4FOD_Count]; // incremented whenever the tracked state changes
+
+	// query between Lookup and Store
+	std::string PendingKey;
+	uint32_t dwPendingDependencies;
+	uint32_t iPendingCheckCount;
+	bool fPending;
+
+	// statistics
+	int32_t iLookups, iHits;
+	uint32_t iSavedChecks;
+
+public:
+	void Default();
+	void Clear(); // drop all results - called every frame
+	void Invalidate(C4FindObjectDependency eDependency) { ++Versions[eDependency]; }
+
+	bool Lookup(char cQuery, C4Value *pPars, C4FindObject *pFO, C4Value &rResult); // get cached result; prepares Store if there is none
+	void Store(const C4Value &Result);
+	void ShowStats();
+	void ResetStats() { iLookups = iHits = 0; iSavedChecks = 0; }
 };
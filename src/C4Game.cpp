@@ -571,6 +571,7 @@ void C4Game::Clear()
 	RecordStream.Clear();
 
 	PathFinder.Clear();
+	PathFinder.ClearCache();
 	TransferZones.Clear();
 #ifndef USE_CONSOLE
 	FontLoader.Clear();
@@ -760,13 +761,19 @@ bool C4Game::Execute() // Returns true if the game is over
 	AddDbgRec(RCT_DbgFrame, &FrameCounter, sizeof(int32_t));
 #endif
 
+	// Script search results are only cached within a frame
+	Objects.FindCache.Clear();
+
 	// Game
 
+	// Particles are simulated by worker threads meanwhile
+	Particles.BeginExec();
+
 	EXEC_S(ExecObjects();, ExecObjectsStat)
 	if (pGlobalEffects)
 		EXEC_S_DR(pGlobalEffects->Execute(nullptr);, GEStats, "GEEx\0");
 	EXEC_S_DR(PXS.Execute();,                     PXSStat,         "PXSEx")
-	EXEC_S_DR(Particles.GlobalParticles.Exec();,  PartStat,        "ParEx")
+	EXEC_S_DR(Particles.EndExec();,               PartStat,        "ParEx")
 	EXEC_S_DR(MassMover.Execute();,               MassMoverStat,   "MMvEx")
 	EXEC_S_DR(Weather.Execute();,                 WeatherStat,     "WtrEx")
 	EXEC_S_DR(Landscape.Execute();,               LandscapeStat,   "LdsEx")
@@ -941,6 +948,21 @@ void C4Game::ClearObjectPtrs(C4Object *pObj)
 	Application.SoundSystem.ClearPointers(pObj);
 }
 
+bool C4Game::IsObjectExecuted(C4Object *pObj)
+{
+	// outside ExecObjects, every object has been executed in the current frame
+	if (!pExecObject) return true;
+	// the executing object itself has yet to reach its timer
+	if (pObj == pExecObject) return false;
+	// ExecObjects runs backwards through the main list
+	for (C4ObjectLink *clnk = Objects.Last; clnk; clnk = clnk->Prev)
+	{
+		if (clnk->Obj == pObj) return true;
+		if (clnk->Obj == pExecObject) return false;
+	}
+	return false;
+}
+
 void C4Game::ClearPointers(C4Object *pObj)
 {
 	BackObjects.ClearPointers(pObj);
@@ -954,7 +976,7 @@ void C4Game::ClearPointers(C4Object *pObj)
 	MouseControl.ClearPointers(pObj);
 	TransferZones.ClearPointers(pObj);
 	if (pGlobalEffects)
-		pGlobalEffects->ClearPointers(pObj);
+		pGlobalEffects->ClearPointers(pObj, nullptr);
 }
 
 bool C4Game::TogglePause()
@@ -1052,7 +1074,7 @@ C4Object *C4Game::NewObject(C4Def *pDef, C4Object *pCreator,
 	// ---- From now on, object is ready to be used in scripts!
 	// Construction callback
 	C4AulParSet pars(C4VObj(pCreator));
-	pObj->Call(PSF_Construction, &pars);
+	pObj->Call(PSFId_Construction, &pars);
 	// AssignRemoval called? (Con 0)
 	if (!pObj->Status) { return nullptr; }
 	// Do initial con
@@ -1504,13 +1526,24 @@ void C4Game::ExecObjects() // Every Tick1 by Execute
 
 	// Execute objects - reverse order to ensure
 	C4Object *cObj; C4ObjectLink *clnk;
+	Objects.AwakeCount = Objects.AsleepCount = 0;
 	for (clnk = Objects.Last; clnk && (cObj = clnk->Obj); clnk = clnk->Prev)
 		if (cObj->Status)
-			// Execute object
-			cObj->Execute();
+		{
+			// Execute object - unless it is asleep and nothing has changed
+			pExecObject = cObj;
+			if (cObj->Asleep && cObj->ExecAsleep())
+				++Objects.AsleepCount;
+			else
+			{
+				cObj->Execute();
+				++Objects.AwakeCount;
+			}
+		}
 		else
 			// Status reset: process removal delay
 			if (cObj->RemovalDelay > 0) cObj->RemovalDelay--;
+	pExecObject = nullptr;
 
 #ifdef DEBUGREC
 	AddDbgRec(RCT_Block, "ObjCC", 6);
@@ -1674,6 +1707,7 @@ void C4Game::Default()
 	HaltCount = 0;
 	Evaluated = false;
 	Verbose = false;
+	ObjectSleepOverride = -1;
 	TimeGo = false;
 	Time = 0;
 	StartTime = 0;
@@ -1721,7 +1755,9 @@ void C4Game::Default()
 	pScenarioSections = pCurrentScenarioSection = nullptr;
 	*CurrentScenarioSection = 0;
 	pGlobalEffects = nullptr;
+	GlobalEffectTiming.Default();
 	fResortAnyObject = false;
+	pExecObject = nullptr;
 	pNetworkStatistics = nullptr;
 	iMusicLevel = 100;
 	PlayList.Clear();
@@ -1853,6 +1889,7 @@ void C4Game::CompileFunc(StdCompiler *pComp, CompileSettings comp)
 		pComp->Value(mkNamingAdapt(PlayList,                                "PlayList",               ""));
 		pComp->Value(mkNamingAdapt(mkStringAdaptMA(CurrentScenarioSection), "CurrentScenarioSection", ""));
 		pComp->Value(mkNamingAdapt(fResortAnyObject,                        "ResortAnyObj",           false));
+		pComp->Value(mkNamingAdapt(Objects.FindCache.Enabled,               "FindObjectCache",        false));
 		pComp->Value(mkNamingAdapt(iMusicLevel,                             "MusicLevel",             100));
 		pComp->Value(mkNamingAdapt(NextMission,                             "NextMission",            StdCopyStrBuf()));
 		pComp->Value(mkNamingAdapt(NextMissionText,                         "NextMissionText",        StdCopyStrBuf()));
@@ -1869,7 +1906,9 @@ void C4Game::CompileFunc(StdCompiler *pComp, CompileSettings comp)
 		pComp->Value(mkNamingAdapt(Landscape.Sky, "Sky"));
 	}
 
+	if (!pComp->isCompiler() && pGlobalEffects) pGlobalEffects->SaveTimes(nullptr);
 	pComp->Value(mkNamingAdapt(mkNamingPtrAdapt(pGlobalEffects, "GlobalEffects"), "Effects"));
+	if (pComp->isCompiler() && pGlobalEffects) pGlobalEffects->LoadTimes(nullptr);
 
 	// scoreboard compiles into main level [Scoreboard]
 	if (!comp.fScenarioSection && comp.fExact)
@@ -2375,7 +2414,7 @@ bool C4Game::InitGame(C4Group &hGroup, C4ScenarioSection *section, bool fLoadSky
 
 	for (C4Def *def = Defs.FirstDef; def; def = def->Next)
 	{
-		def->Script.Call(PSF_InitializeDef, &C4AulParSet(section ? C4VString(section->szName) : C4VNull));
+		def->Script.Call(PSFId_InitializeDef, &C4AulParSet(section ? C4VString(section->szName) : C4VNull));
 	}
 
 	// Load objects
@@ -2926,6 +2965,9 @@ void C4Game::ParseCommandLine(const char *szCmdLine)
 		// record stream
 		if (SEqual2NoCase(szParameter, "/stream:"))
 			RecordStream.Copy(szParameter + 8);
+		// object sleep mode for replays
+		if (SEqual2NoCase(szParameter, "/objectsleep:"))
+			ObjectSleepOverride = BoundBy<int32_t>(atoi(szParameter + 13), C4S_ObjectSleepOff, C4S_ObjectSleepCheck);
 		// startup start screen
 		if (SEqual2NoCase(szParameter, "/startup:"))
 			C4Startup::SetStartScreen(szParameter + 9);
@@ -3487,6 +3529,10 @@ void C4Game::Synchronize(bool fSavePlayerFiles)
 	// TransferZone synchronization: Must do this after dynamic creation to avoid synchronization loss
 	// if UpdateTransferZone-callbacks do sync-relevant changes
 	TransferZones.Synchronize();
+	// cached paths are not saved, so joining clients start without them
+	PathFinder.ClearCache();
+	// the landscape may have been replaced
+	Particles.Landscape.Invalidate();
 }
 
 C4Object *C4Game::FindBase(int32_t iPlayer, int32_t iIndex)
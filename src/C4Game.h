@@ -129,6 +129,7 @@ public:
 	C4GUIScreen *pGUI;
 	C4ScenarioSection *pScenarioSections, *pCurrentScenarioSection;
 	C4Effect *pGlobalEffects;
+	C4EffectTiming GlobalEffectTiming;
 #ifndef USE_CONSOLE
 	// We don't need fonts when we don't have graphics
 	C4FontLoader FontLoader;
@@ -158,6 +159,7 @@ public:
 	bool Verbose; // default false; set to true only by command line
 	StdStrBuf RecordDumpFile;
 	StdStrBuf RecordStream;
+	int32_t ObjectSleepOverride; // C4S_ObjectSleep* mode forced for replays by /objectsleep:, -1 if none
 	bool TempScenarioFile;
 	bool fPreinited; // set after PreInit has been called; unset by Clear and Default
 	int32_t FrameCounter;
@@ -173,6 +175,7 @@ public:
 	int32_t FrameSkip; bool DoSkipFrame;
 	uint32_t FoWColor; // FoW-color; may contain transparency
 	bool fResortAnyObject; // if set, object list will be checked for unsorted objects next frame
+	C4Object *pExecObject; // (NoSave) object currently executed by ExecObjects
 	bool IsRunning; // (NoSave) if set, the game is running; if not, just the startup message board is painted
 	bool PointersDenumerated; // (NoSave) set after object pointers have been denumerated
 	size_t StartupLogPos, QuitLogPos; // current log positions when game was last started and cleared
@@ -205,6 +208,8 @@ public:
 	class C4Player *JoinPlayer(const char *szFilename, int32_t iAtClient, const char *szAtClientName, C4PlayerInfo *pInfo);
 	bool DoGameOver();
 	bool CanQuickSave();
+	// Replays may run with another sleep mode than recorded: their debug records must match anyway
+	int32_t GetObjectSleep() const { return (ObjectSleepOverride >= 0 && Control.isReplay()) ? ObjectSleepOverride : C4S.Game.ObjectSleep; }
 	bool QuickSave(const char *strFilename, const char *strTitle, bool fForceSave = false);
 	void SetInitProgress(float fToProgress);
 	void OnResolutionChanged(); // update anything that's dependent on screen resolution
@@ -227,6 +232,7 @@ public:
 	bool ReloadParticle(const char *szName);
 	// Object functions
 	void ClearPointers(C4Object *cobj);
+	bool IsObjectExecuted(C4Object *pObj); // whether pObj already had its turn in ExecObjects this frame
 	C4Object *CreateObject(C4ID type, C4Object *pCreator, int32_t owner = NO_OWNER,
 		int32_t x = 50, int32_t y = 50, int32_t r = 0,
 		FIXED xdir = Fix0, FIXED ydir = Fix0, FIXED rdir = Fix0, int32_t iController = NO_OWNER);
@@ -45,6 +45,13 @@ void C4GameObjects::Default()
 	ResortProc = nullptr;
 	Sectors.Clear();
 	LastUsedMarker = 0;
+	IDIndex.clear();
+	for (int32_t i = 0; i < C4GO_CategoryIndexCount; i++)
+		CategoryIndex[i].Clear();
+	IndexedCount = 0;
+	fListOrderValid = true;
+	FindCache.Default();
+	AwakeCount = AsleepCount = 0;
 }
 
 void C4GameObjects::Init(int32_t iWidth, int32_t iHeight)
@@ -69,6 +76,8 @@ bool C4GameObjects::Add(C4Object *nObj)
 		return false;
 	// add to sectors
 	Sectors.Add(nObj, this);
+	// add to find indices
+	AddToIndex(nObj);
 	return true;
 }
 
@@ -78,6 +87,8 @@ bool C4GameObjects::Remove(C4Object *pObj)
 	if (pObj->Status == C4OS_INACTIVE) return InactiveObjects.Remove(pObj);
 	// remove from sectors
 	Sectors.Remove(pObj);
+	// remove from find indices
+	RemoveFromIndex(pObj, pObj->id, pObj->Category);
 	// remove from backlist
 	Game.BackObjects.Remove(pObj);
 	// remove from forelist
@@ -132,8 +143,8 @@ void C4GameObjects::CrossCheck() // Every Tick1 by ExecObjects
 								// RejectFight callback
 								C4AulParSet parset1(C4VObj(obj2));
 								C4AulParSet parset2(C4VObj(obj1));
-								if (obj1->Call(PSF_RejectFight, &parset1).getBool()) continue;
-								if (obj2->Call(PSF_RejectFight, &parset2).getBool()) continue;
+								if (obj1->Call(PSFId_RejectFight, &parset1).getBool()) continue;
+								if (obj2->Call(PSFId_RejectFight, &parset2).getBool()) continue;
 								ObjectActionFight(obj1, obj2);
 								ObjectActionFight(obj2, obj1);
 								continue;
@@ -169,7 +180,7 @@ void C4GameObjects::CrossCheck() // Every Tick1 by ExecObjects
 										obj2->Marker = Marker;
 										// Hit
 										if ((obj2->OCF & OCF_HitSpeed2) && (obj1->OCF & OCF_Alive) && (obj2->Category & C4D_Object))
-											if (!obj1->Call(PSF_QueryCatchBlow, &C4AulParSet(C4VObj(obj2))))
+											if (!obj1->Call(PSFId_QueryCatchBlow, &C4AulParSet(C4VObj(obj2))))
 											{
 												// "realistic" hit energy
 												FIXED dXDir = obj2->xdir - obj1->xdir, dYDir = obj2->ydir - obj1->ydir;
@@ -179,7 +190,7 @@ void C4GameObjects::CrossCheck() // Every Tick1 by ExecObjects
 												int tmass = std::max<int32_t>(obj1->Mass, 50);
 												if (!Tick3 || (obj1->Action.Act >= 0 && obj1->Def->ActMap[obj1->Action.Act].Procedure != DFA_FLIGHT))
 													obj1->Fling(obj2->xdir * 50 / tmass, -Abs(obj2->ydir / 2) * 50 / tmass, false, obj2->Controller);
-												obj1->Call(PSF_CatchBlow, &C4AulParSet(C4VInt(-iHitEnergy / 5),
+												obj1->Call(PSFId_CatchBlow, &C4AulParSet(C4VInt(-iHitEnergy / 5),
 													C4VObj(obj2)));
 												// obj1 might have been tampered with
 												if (!obj1->Status || obj1->Contained || !(obj1->OCF & focf))
@@ -326,6 +337,7 @@ void C4GameObjects::DeleteObjects()
 
 void C4GameObjects::Clear(bool fClearInactive)
 {
+	FindCache.Clear();
 	DeleteObjects();
 	if (fClearInactive)
 		InactiveObjects.Clear();
@@ -333,6 +345,24 @@ void C4GameObjects::Clear(bool fClearInactive)
 	LastUsedMarker = 0;
 }
 
+/* C4CountedObjectList */
+
+C4ObjectLink *C4CountedObjectList::AppendLink(C4Object *pObj)
+{
+	C4ObjectLink *pLnk = new C4ObjectLink;
+	pLnk->Obj = pObj;
+	InsertLink(pLnk, Last);
+	++LinkCount;
+	return pLnk;
+}
+
+void C4CountedObjectList::DeleteLink(C4ObjectLink *pLnk)
+{
+	RemoveLink(pLnk);
+	delete pLnk;
+	--LinkCount;
+}
+
 /* C4ObjResort */
 
 C4ObjResort::C4ObjResort()
@@ -665,6 +695,9 @@ int C4GameObjects::Load(C4Group &hGroup, bool fKeepInactive)
 	// make sure list is sorted by category - after sorting out inactives, because inactives aren't sorted into the main list
 	FixObjectOrder();
 
+	// objects were compiled into the main list directly
+	RebuildIndex();
+
 	// misc updates
 	for (cLnk = First; cLnk; cLnk = cLnk->Next)
 		if ((pObj = cLnk->Obj)->Status)
@@ -736,6 +769,7 @@ void C4GameObjects::UpdatePos(C4Object *pObj)
 {
 	// Position might have changed. Update sector lists
 	Sectors.Update(pObj, this);
+	FindCache.Invalidate(C4FOD_Position);
 }
 
 void C4GameObjects::UpdatePosResort(C4Object *pObj)
@@ -743,6 +777,126 @@ void C4GameObjects::UpdatePosResort(C4Object *pObj)
 	// Object order for this object was changed. Readd object to sectors
 	Sectors.Remove(pObj);
 	Sectors.Add(pObj, this);
+	// the main list may have been relinked directly or objects swapped between links
+	fListOrderValid = false;
+	FindCache.Invalidate(C4FOD_Objects);
+}
+
+void C4GameObjects::AddToIndex(C4Object *pObj)
+{
+	// the index lists are unsorted, so objects are just appended
+	if (pObj->IndexLinks[0]) return;
+	FindCache.Invalidate(C4FOD_Objects);
+	pObj->IndexLinks[0] = IDIndex[pObj->id].AppendLink(pObj);
+	for (int32_t i = 0; i < C4GO_CategoryIndexCount; i++)
+		if (pObj->Category & (1 << i))
+			pObj->IndexLinks[1 + i] = CategoryIndex[i].AppendLink(pObj);
+	++IndexedCount;
+}
+
+bool C4GameObjects::RemoveFromIndex(C4Object *pObj, C4ID id, int32_t iCategory)
+{
+	// not indexed (yet)?
+	if (!pObj->IndexLinks[0]) return false;
+	FindCache.Invalidate(C4FOD_Objects);
+	IDIndex[id].DeleteLink(pObj->IndexLinks[0]);
+	pObj->IndexLinks[0] = nullptr;
+	for (int32_t i = 0; i < C4GO_CategoryIndexCount; i++)
+		if (pObj->IndexLinks[1 + i])
+		{
+			CategoryIndex[i].DeleteLink(pObj->IndexLinks[1 + i]);
+			pObj->IndexLinks[1 + i] = nullptr;
+		}
+	--IndexedCount;
+	return true;
+}
+
+// Gap between the order keys of neighbouring objects after renumbering
+const uint64_t C4GO_ListOrderGap = uint64_t(1) << 24;
+
+void C4GameObjects::SetListOrder(C4ObjectLink *pLnk)
+{
+	// everything is renumbered anyway?
+	if (!fListOrderValid) return;
+	// place the key between the neighbours, leaving room at the ends of the list
+	C4ObjectLink *pPrev = pLnk->Prev, *pNext = pLnk->Next;
+	uint64_t iLow = pPrev ? pPrev->Obj->ListOrder : 0;
+	uint64_t iHigh = pNext ? pNext->Obj->ListOrder : UINT64_MAX;
+	if (iHigh <= iLow || iHigh - iLow < 2)
+		// no room left: renumber when needed
+		fListOrderValid = false;
+	else if (!pNext && iHigh - iLow > C4GO_ListOrderGap)
+		pLnk->Obj->ListOrder = iLow + C4GO_ListOrderGap;
+	else if (!pPrev && iHigh - iLow > C4GO_ListOrderGap)
+		pLnk->Obj->ListOrder = iHigh - C4GO_ListOrderGap;
+	else
+		pLnk->Obj->ListOrder = iLow + (iHigh - iLow) / 2;
+}
+
+void C4GameObjects::InsertLinkBefore(C4ObjectLink *pLink, C4ObjectLink *pBefore)
+{
+	C4NotifyingObjectList::InsertLinkBefore(pLink, pBefore);
+	SetListOrder(pLink);
+}
+
+void C4GameObjects::InsertLink(C4ObjectLink *pLink, C4ObjectLink *pAfter)
+{
+	C4NotifyingObjectList::InsertLink(pLink, pAfter);
+	SetListOrder(pLink);
+}
+
+void C4GameObjects::UpdateListOrder()
+{
+	if (fListOrderValid) return;
+	uint64_t iOrder = 0;
+	for (C4ObjectLink *pLnk = First; pLnk; pLnk = pLnk->Next)
+		pLnk->Obj->ListOrder = (iOrder += C4GO_ListOrderGap);
+	fListOrderValid = true;
+}
+
+const C4ObjectList *C4GameObjects::GetIDIndex(C4ID id, int32_t &riCount)
+{
+	std::map<C4ID, C4CountedObjectList>::iterator i = IDIndex.find(id);
+	if (i == IDIndex.end()) { riCount = 0; return nullptr; }
+	riCount = i->second.LinkCount;
+	return &i->second;
+}
+
+const C4ObjectList *C4GameObjects::GetCategoryIndex(int32_t iCategory, int32_t &riCount)
+{
+	// only single sort categories are indexed
+	for (int32_t i = 0; i < C4GO_CategoryIndexCount; i++)
+		if (iCategory == (1 << i))
+		{
+			riCount = CategoryIndex[i].LinkCount;
+			return &CategoryIndex[i];
+		}
+	riCount = 0;
+	return nullptr;
+}
+
+void C4GameObjects::ReIndex(C4Object *pObj, C4ID idOld, int32_t iOldCategory)
+{
+	// only objects in the main list are indexed
+	if (RemoveFromIndex(pObj, idOld, iOldCategory))
+		AddToIndex(pObj);
+}
+
+void C4GameObjects::RebuildIndex()
+{
+	FindCache.Invalidate(C4FOD_Objects);
+	IDIndex.clear();
+	for (int32_t i = 0; i < C4GO_CategoryIndexCount; i++)
+		CategoryIndex[i].Clear();
+	IndexedCount = 0;
+	for (C4ObjectLink *pLnk = First; pLnk; pLnk = pLnk->Next)
+	{
+		std::fill_n(pLnk->Obj->IndexLinks, 1 + C4GO_CategoryIndexCount, nullptr);
+		AddToIndex(pLnk->Obj);
+	}
+	// objects were compiled into the main list directly
+	fListOrderValid = false;
+	UpdateListOrder();
 }
 
 bool C4GameObjects::OrderObjectBefore(C4Object *pObj1, C4Object *pObj2)
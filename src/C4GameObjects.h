@@ -19,12 +19,28 @@
 
 #pragma once
 
+#include <C4Object.h>
 #include <C4ObjectList.h>
 #include <C4FindObject.h>
 #include <C4Sector.h>
 
+#include <map>
+
 class C4ObjResort;
 
+// unsorted object list that keeps track of its link count; the links are kept by the caller, so nothing is searched
+class C4CountedObjectList : public C4ObjectList
+{
+public:
+	C4CountedObjectList() : LinkCount(0) {}
+
+	int32_t LinkCount;
+
+	void Clear() { C4ObjectList::Clear(); LinkCount = 0; }
+	C4ObjectLink *AppendLink(C4Object *pObj); // add object at the end
+	void DeleteLink(C4ObjectLink *pLnk); // remove and delete link returned by AppendLink
+};
+
 // main object list class
 class C4GameObjects : public C4NotifyingObjectList
 {
@@ -38,10 +54,26 @@ public:
 private:
 	uint32_t LastUsedMarker; // last used value for C4Object::Marker
 
+	// find indices: active objects by ID and by sort category, unsorted
+	std::map<C4ID, C4CountedObjectList> IDIndex;
+	C4CountedObjectList CategoryIndex[C4GO_CategoryIndexCount];
+	int32_t IndexedCount; // number of objects in the main list
+	bool fListOrderValid; // C4Object::ListOrder ascends along the main list
+
+	void AddToIndex(C4Object *pObj);
+	bool RemoveFromIndex(C4Object *pObj, C4ID id, int32_t iCategory);
+	void SetListOrder(C4ObjectLink *pLnk); // order key for a link inserted into the main list
+
+protected:
+	virtual void InsertLinkBefore(C4ObjectLink *pLink, C4ObjectLink *pBefore);
+	virtual void InsertLink(C4ObjectLink *pLink, C4ObjectLink *pAfter);
+
 public:
 	C4LSectors Sectors; // section object lists
 	C4ObjectList InactiveObjects; // inactive objects (Status=2)
 	C4ObjResort *ResortProc; // current sheduled user resorts
+	C4FindObjectCache FindCache; // per-frame script search results
+	int32_t AwakeCount, AsleepCount; // objects executed and skipped as asleep in the last frame
 
 	bool Add(C4Object *nObj); // add object
 	bool Remove(C4Object *pObj); // clear pointers to object
@@ -53,6 +85,13 @@ public:
 	void Synchronize(); // network synchronization
 	uint32_t GetNextMarker();
 
+	const C4ObjectList *GetIDIndex(C4ID id, int32_t &riCount); // active objects of given ID, unsorted
+	const C4ObjectList *GetCategoryIndex(int32_t iCategory, int32_t &riCount); // active objects of given single sort category, unsorted
+	int32_t GetIndexedCount() const { return IndexedCount; }
+	void ReIndex(C4Object *pObj, C4ID idOld, int32_t iOldCategory); // object changed its ID or category
+	void RebuildIndex();
+	void UpdateListOrder(); // make C4Object::ListOrder valid for all objects of the main list
+
 	C4Object *FindInternal(C4ID id); // find object in first sector
 	virtual C4Object *ObjectPointer(int32_t iNumber); // object pointer by number
 	long ObjectNumber(C4Object *pObj); // object number by pointer
@@ -84,6 +123,8 @@ public:
 
 	bool ValidateOwners();
 	bool AssignInfo();
+
+	friend class C4ObjResort;
 };
 
 class C4AulFunc;
@@ -171,6 +171,7 @@
 #include "C4MusicFile.h"
 #include "C4MusicSystem.h"
 #include "C4NameList.h"
+#include "C4NavGrid.h"
 #include "C4NetIO.h"
 #include "C4Network2Client.h"
 #include "C4Network2Dialogs.h"
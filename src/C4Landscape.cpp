@@ -254,6 +254,7 @@ void C4Landscape::Clear(bool fClearMapCreator, bool fClearSky)
 	Mode = C4LSC_Undefined;
 	// clear pixel count
 	delete[] PixCnt;         PixCnt           = nullptr;
+	delete[] PixChangeFrame; PixChangeFrame   = nullptr;
 	PixCntPitch = 0;
 }
 
@@ -714,6 +715,7 @@ bool C4Landscape::Init(C4Group &hGroup, bool fOverloadCurrent, bool fLoadSky, bo
 	int32_t PixCntWidth = (Width + 16) / 17;
 	PixCntPitch = (Height + 14) / 15;
 	PixCnt = new uint8_t[PixCntWidth * PixCntPitch];
+	PixChangeFrame = new int32_t[PixCntWidth * PixCntPitch];
 	UpdatePixCnt(C4Rect(0, 0, Width, Height));
 	ClearMatCount();
 	UpdateMatCnt(C4Rect(0, 0, Width, Height), true);
@@ -779,6 +781,7 @@ bool C4Landscape::_SetPix(int32_t x, int32_t y, uint8_t npix)
 	// get and check pixel
 	uint8_t opix = _GetPix(x, y);
 	if (npix == opix) return true;
+	PixChangeFrame[(y / 15) + (x / 17) * PixCntPitch] = Game.FrameCounter;
 	// count pixels
 	if (Pix2Dens[npix])
 	{
@@ -2783,6 +2786,55 @@ void C4Landscape::FinishChange(C4Rect BoundingBox)
 	C4SolidMask::CheckConsistency();
 }
 
+bool C4Landscape::IsChangedSince(const C4Rect &rcArea, int32_t iFrame)
+{
+	// pixels outside the landscape never change
+	int32_t PixCntWidth = (Width + 16) / 17;
+	for (int32_t x = std::max<int32_t>(0, rcArea.x / 17); x < std::min<int32_t>(PixCntWidth, (rcArea.x + rcArea.Wdt + 16) / 17); x++)
+		for (int32_t y = std::max<int32_t>(0, rcArea.y / 15); y < std::min<int32_t>(PixCntPitch, (rcArea.y + rcArea.Hgt + 14) / 15); y++)
+			if (PixChangeFrame[x * PixCntPitch + y] >= iFrame)
+				return true;
+	return false;
+}
+
+int32_t C4Landscape::GetFreeSweep(const C4Rect &rcArea, int32_t iDirX, int32_t iDirY, int32_t iMax)
+{
+	// Area must stay inside the landscape, where the pixel counts are valid
+	if (rcArea.x < 0 || rcArea.y < 0 || rcArea.x + rcArea.Wdt > Width || rcArea.y + rcArea.Hgt > Height) return 0;
+	if (iDirX > 0) iMax = std::min<int32_t>(iMax, Width - rcArea.x - rcArea.Wdt);
+	else if (iDirX < 0) iMax = std::min<int32_t>(iMax, rcArea.x);
+	else if (iDirY > 0) iMax = std::min<int32_t>(iMax, Height - rcArea.y - rcArea.Hgt);
+	else iMax = std::min<int32_t>(iMax, rcArea.y);
+	if (iMax <= 0) return 0;
+	// Swept area, in pixel count blocks of 17x15 pixels
+	C4Rect rcSwept = rcArea;
+	if (iDirX) { rcSwept.Wdt += iMax; if (iDirX < 0) rcSwept.x -= iMax; }
+	else { rcSwept.Hgt += iMax; if (iDirY < 0) rcSwept.y -= iMax; }
+	int32_t iBX1 = rcSwept.x / 17, iBY1 = rcSwept.y / 15, iBX2 = (rcSwept.x + rcSwept.Wdt - 1) / 17, iBY2 = (rcSwept.y + rcSwept.Hgt - 1) / 15;
+	// Find the first block row/column in movement direction that contains any pixel
+	if (iDirX)
+	{
+		for (int32_t i = 0; i <= iBX2 - iBX1; i++)
+		{
+			int32_t bx = (iDirX > 0) ? iBX1 + i : iBX2 - i;
+			for (int32_t by = iBY1; by <= iBY2; by++)
+				if (PixCnt[bx * PixCntPitch + by])
+					return std::max<int32_t>(0, (iDirX > 0) ? bx * 17 - (rcArea.x + rcArea.Wdt) : rcArea.x - (bx * 17 + 17));
+		}
+	}
+	else
+	{
+		for (int32_t i = 0; i <= iBY2 - iBY1; i++)
+		{
+			int32_t by = (iDirY > 0) ? iBY1 + i : iBY2 - i;
+			for (int32_t bx = iBX1; bx <= iBX2; bx++)
+				if (PixCnt[bx * PixCntPitch + by])
+					return std::max<int32_t>(0, (iDirY > 0) ? by * 15 - (rcArea.y + rcArea.Hgt) : rcArea.y - (by * 15 + 15));
+		}
+	}
+	return iMax;
+}
+
 void C4Landscape::UpdatePixCnt(const C4Rect &Rect, bool fCheck)
 {
 	int32_t PixCntWidth = (Width + 16) / 17;
@@ -2796,6 +2848,8 @@ void C4Landscape::UpdatePixCnt(const C4Rect &Rect, bool fCheck)
 						iCnt++;
 			if (fCheck)
 				assert(iCnt == PixCnt[x * PixCntPitch + y]);
+			else
+				PixChangeFrame[x * PixCntPitch + y] = Game.FrameCounter;
 			PixCnt[x * PixCntPitch + y] = iCnt;
 		}
 }
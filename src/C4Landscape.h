@@ -73,6 +73,7 @@ protected:
 	int32_t Pix2Mat[256], Pix2Dens[256], Pix2Place[256];
 	int32_t PixCntPitch;
 	uint8_t *PixCnt;
+	int32_t *PixChangeFrame; // frame of the last change in each PixCnt block
 	C4Rect Relights[C4LS_MaxRelights];
 
 public:
@@ -180,7 +181,19 @@ public:
 	}
 
 	inline int32_t GetPixMat(uint8_t byPix) { return Pix2Mat[byPix]; }
+	inline int32_t GetPixDensity(uint8_t byPix) { return Pix2Dens[byPix]; }
+
+	inline const uint8_t *GetPixBuffer(int32_t x, int32_t y, int32_t wdt, int32_t hgt, int32_t &riPitch) // get landscape pixels for direct access if the area is fully inside; nullptr otherwise
+	{
+		if (!Surface8 || x < 0 || y < 0 || x + wdt > Width || y + hgt > Height) return nullptr;
+		riPitch = Surface8->Pitch;
+		return Surface8->Bits;
+	}
 	bool _PathFree(int32_t x, int32_t y, int32_t x2, int32_t y2); // quickly checks wether there *might* be pixel in the path.
+	bool IsChangedSince(const C4Rect &rcArea, int32_t iFrame); // whether any pixel in the area may have changed in or after the given frame
+	bool IsBlockEmpty(int32_t x, int32_t y) { return !PixCnt[(x / 17) * PixCntPitch + y / 15]; } // whether the PixCnt block around the pixel has no pixel with density
+	int32_t GetBlockChangeFrame(int32_t iBlockX, int32_t iBlockY) { return PixChangeFrame[iBlockX * PixCntPitch + iBlockY]; } // frame of the last change in a PixCnt block
+	int32_t GetFreeSweep(const C4Rect &rcArea, int32_t iDirX, int32_t iDirY, int32_t iMax); // how far the area can be moved along an axis without covering any pixel with density
 	int32_t GetMatHeight(int32_t x, int32_t y, int32_t iYDir, int32_t iMat, int32_t iMax);
 	int32_t DigFreePix(int32_t tx, int32_t ty);
 	int32_t ShakeFreePix(int32_t tx, int32_t ty);
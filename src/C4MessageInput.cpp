@@ -442,6 +442,7 @@ bool C4MessageInput::ProcessCommand(const char *szCommand)
 		LogF("/set maxplayer [4] - %s", LoadResStr("IDS_TEXT_SETANEWMAXIMUMNUMBEROFPLA"));
 		LogF("/script [script] - %s", LoadResStr("IDS_TEXT_EXECUTEASCRIPTCOMMAND"));
 		LogF("/clear - %s", LoadResStr("IDS_MSG_CLEARTHEMESSAGEBOARD"));
+		LogF("/profile [start [ID]|stop] - %s", LoadResStr("IDS_TEXT_STARTORSTOPTHESCRIPTPROFI"));
 		return true;
 	}
 	// dev-scripts
@@ -455,6 +456,39 @@ bool C4MessageInput::ProcessCommand(const char *szCommand)
 		Game.Control.DoInput(CID_Script, new C4ControlScript(pCmdPar, C4ControlScript::SCOPE_Console, false), CDT_Decide);
 		return true;
 	}
+	// script profiler; only measures locally, so it needs no synchronization
+	if (SEqual(szCmdName, "profile"))
+	{
+		if (!Game.IsRunning) return false;
+		if (SEqual2(pCmdPar, "start"))
+		{
+			// profile a definition or all scripts
+			C4AulScript *pScript = &Game.ScriptEngine;
+			if (pCmdPar[5] == ' ')
+			{
+				C4Def *pDef = Game.Defs.ID2Def(C4Id(pCmdPar + 6));
+				if (!pDef)
+				{
+					LogF("Definition %s not found", pCmdPar + 6);
+					return false;
+				}
+				pScript = &pDef->Script;
+			}
+			else if (pCmdPar[5])
+				return false;
+			C4AulProfiler::StartProfiling(pScript);
+			Log("Script profiler started");
+			return true;
+		}
+		if (SEqual(pCmdPar, "stop"))
+		{
+			if (!C4AulProfiler::IsProfiling()) return false;
+			C4AulProfiler::StopProfiling(Config.AtExePath(C4CFN_ScriptProfile));
+			return true;
+		}
+		Log("Syntax: /profile start [ID] or /profile stop");
+		return false;
+	}
 	// set runtimte properties
 	if (SEqual(szCmdName, "set"))
 	{
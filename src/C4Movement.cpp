@@ -126,6 +126,23 @@ void C4Object::DoMotion(int32_t mx, int32_t my)
 	if (pSolidMaskData) pSolidMaskData->Remove(true, true);
 	x += mx; y += my;
 	motion_x += mx; motion_y += my;
+	// Sectors are updated after the movement, but contact calls may search before that
+	Game.Objects.FindCache.Invalidate(C4FOD_Position);
+}
+
+void C4Object::SkipFreeMotion(int32_t mx, int32_t my)
+{
+	// Only worth it for more than two steps; contacts with density zero can't be ruled out by the pixel counts
+	if (Abs(mx + my) <= 2 || Shape.ContactDensity <= 0) return;
+	// Area covered by the vertices
+	C4Rect rcVertices;
+	Shape.GetVertexOutline(rcVertices);
+	rcVertices.x += x; rcVertices.y += y; rcVertices.Wdt++; rcVertices.Hgt++;
+	// Positions up to iFree steps away are contact-free. The last of these
+	// is left to the regular contact check, which sets the vertex contacts.
+	int32_t iFree = Game.Landscape.GetFreeSweep(rcVertices, Sign(mx), Sign(my), Abs(mx + my));
+	if (iFree > 1)
+		DoMotion(Sign(mx) * (iFree - 1), Sign(my) * (iFree - 1));
 }
 
 void C4Object::TargetBounds(int32_t &ctco, int32_t limit_low, int32_t limit_hi, int32_t cnat_low, int32_t cnat_hi)
@@ -247,6 +264,7 @@ void C4Object::DoMovement()
 		SideBounds(ctcox);
 
 		// Move to target
+		SkipFreeMotion(ctcox - x, 0);
 		while (x != ctcox)
 		{
 			// Next step
@@ -274,6 +292,7 @@ void C4Object::DoMovement()
 		VerticalBounds(ctcoy);
 
 		// Move to target
+		SkipFreeMotion(0, ctcoy - y);
 		while (y != ctcoy)
 		{
 			// Next step
@@ -412,6 +431,7 @@ void C4Object::DoMovement()
 			{
 				fTurned = true;
 				x = ctx; y = cty;
+				Game.Objects.FindCache.Invalidate(C4FOD_Position);
 			}
 		}
 		// Circle bounds
@@ -456,9 +476,9 @@ void C4Object::DoMovement()
 	if (fAnyContact)
 	{
 		C4AulParSet pars(C4VInt(fixtoi(oldxdir, 100)), C4VInt(fixtoi(oldydir, 100)));
-		if (old_ocf & OCF_HitSpeed1) Call(PSF_Hit,  &pars);
-		if (old_ocf & OCF_HitSpeed2) Call(PSF_Hit2, &pars);
-		if (old_ocf & OCF_HitSpeed3) Call(PSF_Hit3, &pars);
+		if (old_ocf & OCF_HitSpeed1) Call(PSFId_Hit,  &pars);
+		if (old_ocf & OCF_HitSpeed2) Call(PSFId_Hit2, &pars);
+		if (old_ocf & OCF_HitSpeed3) Call(PSFId_Hit3, &pars);
 	}
 
 	// Rotation gfx
@@ -489,6 +509,7 @@ void C4Object::Stabilize()
 				// Undo rotation
 				Shape = lshape;
 				r = lcobjr;
+				Game.Objects.FindCache.Invalidate(C4FOD_Position);
 			}
 			else
 			{
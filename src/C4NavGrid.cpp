@@ -0,0 +1,518 @@
+/*
+ * LegacyClonk
+ *
+ * Copyright (c) 2017-2019, The LegacyClonk Team and contributors
+ *
+ * Distributed under the terms of the ISC license; see accompanying file
+ * "COPYING" for details.
+ *
+ * "Clonk" is a registered trademark of Matthes Bender, used with permission.
+ * See accompanying file "TRADEMARK" for details.
+ *
+ * To redistribute this file separately, substitute the full license texts
+ * for the above references.
+ */
+
+/* Coarse navigation grid: hierarchical A* over landscape blocks */
+
+#include <C4Include.h>
+#include <C4NavGrid.h>
+
+#ifndef BIG_C4INCLUDE
+#include <C4Game.h>
+#include <C4Wrappers.h>
+#endif
+
+#include <algorithm>
+#include <climits>
+
+const int32_t C4NG_CellWdt     = 17, // landscape PixCnt block size
+              C4NG_CellHgt     = 15,
+              C4NG_ClusterSize = 8,  // cells per cluster side
+              C4NG_MaxRegions  = C4NG_ClusterSize * C4NG_ClusterSize,
+              C4NG_MinFree     = 3,  // cells are passable if at least 1/C4NG_MinFree of them is free
+              C4NG_MaxAttach   = 5,  // distance a way may keep from the ground or a wall
+              C4NG_LookAhead   = 16; // waypoints skipped at most when straightening the path
+
+const uint8_t C4NG_NoRegion = 0xff;
+
+C4NavGrid::C4NavGrid()
+{
+	Default();
+}
+
+C4NavGrid::~C4NavGrid()
+{
+	Clear();
+}
+
+void C4NavGrid::Default()
+{
+	PointFree = nullptr;
+	TransferZones = nullptr;
+	LandscapeWdt = LandscapeHgt = 0;
+	Wdt = Hgt = 0;
+	ClusterCols = ClusterRows = 0;
+	SearchMark = 0;
+	UseZones = false;
+	GoalX = GoalY = 0;
+	SearchArea.Default();
+	SearchSteps = 0;
+}
+
+void C4NavGrid::Clear()
+{
+	Cells.clear();
+	Clusters.clear();
+	CellNodes.clear();
+	RegionNodes.clear();
+	LandscapeWdt = LandscapeHgt = 0;
+	Wdt = Hgt = 0;
+	ClusterCols = ClusterRows = 0;
+}
+
+void C4NavGrid::Init(bool(*fnPointFree)(int32_t, int32_t), C4TransferZones *pTransferZones)
+{
+	Clear();
+	PointFree = fnPointFree;
+	TransferZones = pTransferZones;
+}
+
+void C4NavGrid::Invalidate()
+{
+	for (Cluster &rCluster : Clusters)
+		rCluster.Valid = false;
+}
+
+void C4NavGrid::UpdateSize()
+{
+	if (LandscapeWdt == GBackWdt && LandscapeHgt == GBackHgt) return;
+	LandscapeWdt = GBackWdt; LandscapeHgt = GBackHgt;
+	Wdt = (LandscapeWdt + C4NG_CellWdt - 1) / C4NG_CellWdt;
+	Hgt = (LandscapeHgt + C4NG_CellHgt - 1) / C4NG_CellHgt;
+	ClusterCols = (Wdt + C4NG_ClusterSize - 1) / C4NG_ClusterSize;
+	ClusterRows = (Hgt + C4NG_ClusterSize - 1) / C4NG_ClusterSize;
+	Cells.assign(Wdt * Hgt, Cell());
+	Clusters.assign(ClusterCols * ClusterRows, Cluster());
+	CellNodes.assign(Cells.size(), Node());
+	RegionNodes.assign(Clusters.size() * C4NG_MaxRegions, Node());
+	SearchMark = 0;
+}
+
+C4Rect C4NavGrid::GetClusterRect(int32_t iCluster)
+{
+	C4Rect rcCluster((iCluster % ClusterCols) * C4NG_ClusterSize * C4NG_CellWdt, (iCluster / ClusterCols) * C4NG_ClusterSize * C4NG_CellHgt,
+		C4NG_ClusterSize * C4NG_CellWdt, C4NG_ClusterSize * C4NG_CellHgt);
+	rcCluster.Intersect(C4Rect(0, 0, LandscapeWdt, LandscapeHgt));
+	return rcCluster;
+}
+
+C4Rect C4NavGrid::GetCellRect(int32_t iCellX, int32_t iCellY)
+{
+	C4Rect rcCell(iCellX * C4NG_CellWdt, iCellY * C4NG_CellHgt, C4NG_CellWdt, C4NG_CellHgt);
+	rcCell.Intersect(C4Rect(0, 0, LandscapeWdt, LandscapeHgt));
+	return rcCell;
+}
+
+int32_t C4NavGrid::GetCellCluster(int32_t iCellX, int32_t iCellY)
+{
+	return (iCellY / C4NG_ClusterSize) * ClusterCols + iCellX / C4NG_ClusterSize;
+}
+
+C4NavGrid::Cell *C4NavGrid::GetPointCell(int32_t iX, int32_t iY, int32_t *piCell)
+{
+	if (!Inside<int32_t>(iX, 0, LandscapeWdt - 1) || !Inside<int32_t>(iY, 0, LandscapeHgt - 1)) return nullptr;
+	int32_t iCellX = iX / C4NG_CellWdt, iCellY = iY / C4NG_CellHgt;
+	EnsureCluster(GetCellCluster(iCellX, iCellY));
+	if (piCell) *piCell = iCellX + iCellY * Wdt;
+	return &Cells[iCellX + iCellY * Wdt];
+}
+
+void C4NavGrid::EnsureCluster(int32_t iCluster)
+{
+	Cluster &rCluster = Clusters[iCluster];
+	// Checked in this search already?
+	if (rCluster.CheckMark == SearchMark) return;
+	rCluster.CheckMark = SearchMark;
+	// Cells and links also look at pixels around the cluster: ground below, walls beside
+	C4Rect rcCluster = GetClusterRect(iCluster);
+	rcCluster.Enlarge(C4NG_MaxAttach);
+	SearchArea.Add(rcCluster);
+	// Rebuild if the landscape changed since
+	if (!rCluster.Valid || Game.Landscape.IsChangedSince(rcCluster, rCluster.Frame))
+		BuildCluster(iCluster);
+}
+
+void C4NavGrid::BuildCluster(int32_t iCluster)
+{
+	int32_t iX1 = (iCluster % ClusterCols) * C4NG_ClusterSize, iY1 = (iCluster / ClusterCols) * C4NG_ClusterSize;
+	int32_t iX2 = std::min<int32_t>(iX1 + C4NG_ClusterSize, Wdt), iY2 = std::min<int32_t>(iY1 + C4NG_ClusterSize, Hgt);
+	int32_t iX, iY;
+	for (iY = iY1; iY < iY2; iY++)
+		for (iX = iX1; iX < iX2; iX++)
+			BuildCell(iX, iY);
+	// Flood fill regions
+	uint8_t iRegion = 0;
+	std::vector<int32_t> Stack;
+	for (iY = iY1; iY < iY2; iY++)
+		for (iX = iX1; iX < iX2; iX++)
+		{
+			Cell &rCell = Cells[iX + iY * Wdt];
+			if (!rCell.Passable || rCell.Region != C4NG_NoRegion) continue;
+			rCell.Region = iRegion;
+			Stack.push_back(iX + iY * Wdt);
+			while (!Stack.empty())
+			{
+				int32_t iCell = Stack.back(); Stack.pop_back();
+				int32_t iCellX = iCell % Wdt, iCellY = iCell / Wdt;
+				const int32_t iDirX[4] = { -1, +1, 0, 0 }, iDirY[4] = { 0, 0, -1, +1 };
+				for (int32_t iDir = 0; iDir < 4; iDir++)
+				{
+					int32_t iNX = iCellX + iDirX[iDir], iNY = iCellY + iDirY[iDir];
+					if (!Inside(iNX, iX1, iX2 - 1) || !Inside(iNY, iY1, iY2 - 1)) continue;
+					Cell &rNeighbour = Cells[iNX + iNY * Wdt];
+					if (rNeighbour.Region == C4NG_NoRegion && IsLinked(iCell, iNX + iNY * Wdt))
+					{
+						rNeighbour.Region = iRegion;
+						Stack.push_back(iNX + iNY * Wdt);
+					}
+				}
+			}
+			iRegion++;
+		}
+	Clusters[iCluster].Valid = true;
+	Clusters[iCluster].Frame = Game.FrameCounter;
+}
+
+void C4NavGrid::BuildCell(int32_t iCellX, int32_t iCellY)
+{
+	Cell &rCell = Cells[iCellX + iCellY * Wdt];
+	C4Rect rcCell = GetCellRect(iCellX, iCellY);
+	int32_t iMidX = rcCell.GetMiddleX(), iMidY = rcCell.GetMiddleY();
+	rCell.Region = C4NG_NoRegion;
+	// Nothing with density in here: completely free, only the border may touch ground or walls
+	bool fEmpty = Game.Landscape.IsBlockEmpty(rcCell.x, rcCell.y);
+	// Count free pixels and find the standable one closest to the center;
+	// points clinging to a wall are only used if there is no ground
+	int32_t iFree = 0, iBestDist = -1;
+	bool fBestGround = false;
+	for (int32_t iY = rcCell.y; iY < rcCell.y + rcCell.Hgt; iY++)
+		for (int32_t iX = rcCell.x; iX < rcCell.x + rcCell.Wdt; iX++)
+		{
+			if (fEmpty)
+			{
+				iFree++;
+				if (iY < rcCell.y + rcCell.Hgt - 1 && iX > rcCell.x && iX < rcCell.x + rcCell.Wdt - 1) continue;
+			}
+			else
+			{
+				if (!PointFree(iX, iY)) continue;
+				iFree++;
+			}
+			bool fGround = !PointFree(iX, iY + 1);
+			if (!fGround && PointFree(iX - 1, iY) && PointFree(iX + 1, iY)) continue;
+			int32_t iDist = Abs(iX - iMidX) + Abs(iY - iMidY);
+			if (iBestDist < 0 || (fGround && !fBestGround) || (fGround == fBestGround && iDist < iBestDist))
+			{
+				iBestDist = iDist; fBestGround = fGround;
+				rCell.WayX = iX; rCell.WayY = iY;
+			}
+		}
+	rCell.Passable = iBestDist >= 0 && iFree * C4NG_MinFree >= rcCell.Wdt * rcCell.Hgt;
+}
+
+C4NavGrid::Node &C4NavGrid::GetNode(std::vector<Node> &rNodes, int32_t iIndex)
+{
+	Node &rNode = rNodes[iIndex];
+	if (rNode.Mark != SearchMark)
+	{
+		rNode.Mark = SearchMark;
+		rNode.Cost = INT_MAX;
+		rNode.From = -1;
+		rNode.Zone = nullptr;
+		rNode.Closed = rNode.Corridor = false;
+	}
+	return rNode;
+}
+
+bool C4NavGrid::GetCellRange(const C4Rect &rcArea, int32_t iCluster, int32_t &rX1, int32_t &rY1, int32_t &rX2, int32_t &rY2)
+{
+	if (rcArea.x + rcArea.Wdt <= 0 || rcArea.y + rcArea.Hgt <= 0) return false;
+	int32_t iX1 = (iCluster % ClusterCols) * C4NG_ClusterSize, iY1 = (iCluster / ClusterCols) * C4NG_ClusterSize;
+	rX1 = std::max<int32_t>(iX1, rcArea.x / C4NG_CellWdt);
+	rY1 = std::max<int32_t>(iY1, rcArea.y / C4NG_CellHgt);
+	rX2 = std::min<int32_t>(std::min<int32_t>(iX1 + C4NG_ClusterSize, Wdt) - 1, (rcArea.x + rcArea.Wdt - 1) / C4NG_CellWdt);
+	rY2 = std::min<int32_t>(std::min<int32_t>(iY1 + C4NG_ClusterSize, Hgt) - 1, (rcArea.y + rcArea.Hgt - 1) / C4NG_CellHgt);
+	return rX1 <= rX2 && rY1 <= rY2;
+}
+
+int32_t C4NavGrid::GetRegionNode(int32_t iCellX, int32_t iCellY)
+{
+	return GetCellCluster(iCellX, iCellY) * C4NG_MaxRegions + Cells[iCellX + iCellY * Wdt].Region;
+}
+
+bool C4NavGrid::IsCorridor(int32_t iCellX, int32_t iCellY)
+{
+	// Cluster not looked at: cannot be on the way
+	if (Clusters[GetCellCluster(iCellX, iCellY)].CheckMark != SearchMark) return false;
+	if (!Cells[iCellX + iCellY * Wdt].Passable) return false;
+	const Node &rNode = RegionNodes[GetRegionNode(iCellX, iCellY)];
+	return rNode.Mark == SearchMark && rNode.Corridor;
+}
+
+bool C4NavGrid::CanFind(int32_t iFromX, int32_t iFromY, int32_t iToX, int32_t iToY, bool fUseZones)
+{
+	UpdateSize();
+	// New search
+	if (!++SearchMark)
+	{
+		for (Node &rNode : CellNodes) rNode.Mark = 0;
+		for (Node &rNode : RegionNodes) rNode.Mark = 0;
+		for (Cluster &rCluster : Clusters) rCluster.CheckMark = 0;
+		SearchMark = 1;
+	}
+	UseZones = fUseZones && TransferZones;
+	SearchArea.Default();
+	SearchSteps = 0;
+	// Start and target must be in passable cells
+	Cell *pFrom = GetPointCell(iFromX, iFromY), *pTo = GetPointCell(iToX, iToY);
+	return pFrom && pTo && pFrom->Passable && pTo->Passable;
+}
+
+bool C4NavGrid::Find(int32_t iFromX, int32_t iFromY, int32_t iToX, int32_t iToY, bool(*fnSetWaypoint)(int32_t, int32_t, intptr_t, intptr_t), intptr_t iWaypointParameter)
+{
+	int32_t iFromCell, iToCell;
+	GetPointCell(iFromX, iFromY, &iFromCell);
+	GetPointCell(iToX, iToY, &iToCell);
+	// Find regions first, then the cells within them
+	if (!FindRegions(iFromCell, iToCell)) return false;
+	if (!FindCells(iFromCell, iToCell, iToX, iToY)) return false;
+	// Collect cell path, start first
+	std::vector<Waypoint> Points;
+	for (int32_t iCell = iToCell; iCell >= 0; iCell = CellNodes[iCell].From)
+	{
+		Waypoint Point = { Cells[iCell].WayX, Cells[iCell].WayY, CellNodes[iCell].Zone };
+		if (iCell == iToCell) { Point.X = iToX; Point.Y = iToY; }
+		if (iCell == iFromCell) { Point.X = iFromX; Point.Y = iFromY; }
+		Points.push_back(Point);
+	}
+	std::reverse(Points.begin(), Points.end());
+	// Straighten: skip waypoints that can be seen directly, but never skip transfers
+	std::vector<Waypoint> Path;
+	size_t i = 0;
+	while (i + 1 < Points.size())
+	{
+		size_t j = std::min<size_t>(Points.size() - 1, i + C4NG_LookAhead);
+		for (size_t k = i + 1; k < j; k++)
+			if (Points[k].Zone) { j = k; break; }
+		if (!Points[j].Zone)
+			while (j > i + 1 && !WalkFree(Points[i].X, Points[i].Y, Points[j].X, Points[j].Y))
+				j--;
+		Path.push_back(Points[j]);
+		i = j;
+	}
+	// Set waypoints, target first; the target itself only if reached by transfer
+	for (size_t k = Path.size(); k--; )
+	{
+		if (k + 1 == Path.size() && !Path[k].Zone) continue;
+		fnSetWaypoint(Path[k].X, Path[k].Y, Path[k].Zone ? (intptr_t)Path[k].Zone->Object : 0, iWaypointParameter);
+	}
+	return true;
+}
+
+bool C4NavGrid::FindRegions(int32_t iFromCell, int32_t iToCell)
+{
+	int32_t iFromNode = GetRegionNode(iFromCell % Wdt, iFromCell / Wdt);
+	int32_t iToNode = GetRegionNode(iToCell % Wdt, iToCell / Wdt);
+	C4Rect rcGoal = GetClusterRect(iToNode / C4NG_MaxRegions);
+	GoalX = rcGoal.GetMiddleX(); GoalY = rcGoal.GetMiddleY();
+	std::vector<OpenNode> Open;
+	std::vector<C4TransferZone *> Zones;
+	GetNode(RegionNodes, iFromNode).Cost = 0;
+	OpenNode Start = { 0, iFromNode };
+	Open.push_back(Start);
+	while (!Open.empty())
+	{
+		std::pop_heap(Open.begin(), Open.end());
+		int32_t iNode = Open.back().Index; Open.pop_back();
+		Node &rNode = GetNode(RegionNodes, iNode);
+		if (rNode.Closed) continue;
+		rNode.Closed = true;
+		SearchSteps++;
+		// Target region reached: mark the way
+		if (iNode == iToNode)
+		{
+			for (; iNode >= 0; iNode = RegionNodes[iNode].From)
+				RegionNodes[iNode].Corridor = true;
+			return true;
+		}
+		int32_t iCluster = iNode / C4NG_MaxRegions;
+		uint8_t iRegion = iNode % C4NG_MaxRegions;
+		int32_t iClusterX = iCluster % ClusterCols, iClusterY = iCluster / ClusterCols;
+		int32_t iX1 = iClusterX * C4NG_ClusterSize, iY1 = iClusterY * C4NG_ClusterSize;
+		int32_t iX2 = std::min<int32_t>(iX1 + C4NG_ClusterSize, Wdt) - 1, iY2 = std::min<int32_t>(iY1 + C4NG_ClusterSize, Hgt) - 1;
+		// Neighbouring clusters: connected where passable cells of the region touch
+		const int32_t iDirX[4] = { -1, +1, 0, 0 }, iDirY[4] = { 0, 0, -1, +1 };
+		for (int32_t iDir = 0; iDir < 4; iDir++)
+		{
+			if (!Inside<int32_t>(iClusterX + iDirX[iDir], 0, ClusterCols - 1) || !Inside<int32_t>(iClusterY + iDirY[iDir], 0, ClusterRows - 1)) continue;
+			EnsureCluster(iCluster + iDirX[iDir] + iDirY[iDir] * ClusterCols);
+			// Border cells of this cluster on that side
+			int32_t iBX1 = iX1, iBY1 = iY1, iBX2 = iX2, iBY2 = iY2;
+			if (iDirX[iDir] < 0) iBX2 = iX1;
+			if (iDirX[iDir] > 0) iBX1 = iX2;
+			if (iDirY[iDir] < 0) iBY2 = iY1;
+			if (iDirY[iDir] > 0) iBY1 = iY2;
+			for (int32_t iY = iBY1; iY <= iBY2; iY++)
+				for (int32_t iX = iBX1; iX <= iBX2; iX++)
+				{
+					const Cell &rCell = Cells[iX + iY * Wdt];
+					if (!rCell.Passable || rCell.Region != iRegion) continue;
+					int32_t iNX = iX + iDirX[iDir], iNY = iY + iDirY[iDir];
+					if (IsLinked(iX + iY * Wdt, iNX + iNY * Wdt))
+						AddRegionNeighbour(Open, iNode, GetRegionNode(iNX, iNY), nullptr);
+				}
+		}
+		// Transfer zones: connect all regions they touch
+		if (UseZones)
+		{
+			TransferZones->Find(GetClusterRect(iCluster), Zones);
+			for (C4TransferZone *pZone : Zones)
+			{
+				C4Rect rcZone(pZone->X, pZone->Y, pZone->Wdt, pZone->Hgt);
+				int32_t iZX1, iZY1, iZX2, iZY2, iX, iY;
+				if (!GetCellRange(rcZone, iCluster, iZX1, iZY1, iZX2, iZY2)) continue;
+				bool fTouches = false;
+				for (iY = iZY1; iY <= iZY2 && !fTouches; iY++)
+					for (iX = iZX1; iX <= iZX2 && !fTouches; iX++)
+						if (Cells[iX + iY * Wdt].Passable && Cells[iX + iY * Wdt].Region == iRegion)
+							fTouches = true;
+				if (!fTouches) continue;
+				// Clusters covered by the zone
+				int32_t iCX1 = std::max<int32_t>(0, rcZone.x / (C4NG_ClusterSize * C4NG_CellWdt)), iCY1 = std::max<int32_t>(0, rcZone.y / (C4NG_ClusterSize * C4NG_CellHgt));
+				int32_t iCX2 = std::min<int32_t>(ClusterCols - 1, (rcZone.x + rcZone.Wdt - 1) / (C4NG_ClusterSize * C4NG_CellWdt));
+				int32_t iCY2 = std::min<int32_t>(ClusterRows - 1, (rcZone.y + rcZone.Hgt - 1) / (C4NG_ClusterSize * C4NG_CellHgt));
+				for (int32_t iCY = iCY1; iCY <= iCY2; iCY++)
+					for (int32_t iCX = iCX1; iCX <= iCX2; iCX++)
+					{
+						int32_t iOther = iCX + iCY * ClusterCols;
+						if (!GetCellRange(rcZone, iOther, iZX1, iZY1, iZX2, iZY2)) continue;
+						EnsureCluster(iOther);
+						for (iY = iZY1; iY <= iZY2; iY++)
+							for (iX = iZX1; iX <= iZX2; iX++)
+								if (Cells[iX + iY * Wdt].Passable)
+									AddRegionNeighbour(Open, iNode, GetRegionNode(iX, iY), pZone);
+					}
+			}
+		}
+	}
+	return false;
+}
+
+void C4NavGrid::AddRegionNeighbour(std::vector<OpenNode> &rOpen, int32_t iFrom, int32_t iTo, C4TransferZone *pZone)
+{
+	Node &rTo = GetNode(RegionNodes, iTo);
+	if (rTo.Closed) return;
+	C4Rect rcFrom = GetClusterRect(iFrom / C4NG_MaxRegions), rcTo = GetClusterRect(iTo / C4NG_MaxRegions);
+	int32_t iCost = GetNode(RegionNodes, iFrom).Cost + Distance(rcFrom.GetMiddleX(), rcFrom.GetMiddleY(), rcTo.GetMiddleX(), rcTo.GetMiddleY());
+	if (iCost >= rTo.Cost) return;
+	rTo.Cost = iCost;
+	rTo.From = iFrom;
+	rTo.Zone = pZone;
+	OpenNode Open = { iCost + Distance(rcTo.GetMiddleX(), rcTo.GetMiddleY(), GoalX, GoalY), iTo };
+	rOpen.push_back(Open);
+	std::push_heap(rOpen.begin(), rOpen.end());
+}
+
+bool C4NavGrid::FindCells(int32_t iFromCell, int32_t iToCell, int32_t iToX, int32_t iToY)
+{
+	GoalX = iToX; GoalY = iToY;
+	std::vector<OpenNode> Open;
+	std::vector<C4TransferZone *> Zones;
+	GetNode(CellNodes, iFromCell).Cost = 0;
+	OpenNode Start = { 0, iFromCell };
+	Open.push_back(Start);
+	while (!Open.empty())
+	{
+		std::pop_heap(Open.begin(), Open.end());
+		int32_t iCell = Open.back().Index; Open.pop_back();
+		Node &rNode = GetNode(CellNodes, iCell);
+		if (rNode.Closed) continue;
+		rNode.Closed = true;
+		SearchSteps++;
+		if (iCell == iToCell) return true;
+		int32_t iCellX = iCell % Wdt, iCellY = iCell / Wdt;
+		// Adjacent cells within the corridor
+		const int32_t iDirX[4] = { -1, +1, 0, 0 }, iDirY[4] = { 0, 0, -1, +1 };
+		for (int32_t iDir = 0; iDir < 4; iDir++)
+		{
+			int32_t iNX = iCellX + iDirX[iDir], iNY = iCellY + iDirY[iDir];
+			if (!Inside<int32_t>(iNX, 0, Wdt - 1) || !Inside<int32_t>(iNY, 0, Hgt - 1)) continue;
+			if (IsCorridor(iNX, iNY) && IsLinked(iCell, iNX + iNY * Wdt))
+				AddCellNeighbour(Open, iCell, iNX + iNY * Wdt, nullptr);
+		}
+		// Transfer zones covering this cell
+		if (UseZones)
+		{
+			TransferZones->Find(GetCellRect(iCellX, iCellY), Zones);
+			for (C4TransferZone *pZone : Zones)
+			{
+				C4Rect rcZone(pZone->X, pZone->Y, pZone->Wdt, pZone->Hgt);
+				int32_t iZX1 = std::max<int32_t>(0, rcZone.x / C4NG_CellWdt), iZY1 = std::max<int32_t>(0, rcZone.y / C4NG_CellHgt);
+				int32_t iZX2 = std::min<int32_t>(Wdt - 1, (rcZone.x + rcZone.Wdt - 1) / C4NG_CellWdt), iZY2 = std::min<int32_t>(Hgt - 1, (rcZone.y + rcZone.Hgt - 1) / C4NG_CellHgt);
+				for (int32_t iY = iZY1; iY <= iZY2; iY++)
+					for (int32_t iX = iZX1; iX <= iZX2; iX++)
+						if (IsCorridor(iX, iY))
+							AddCellNeighbour(Open, iCell, iX + iY * Wdt, pZone);
+			}
+		}
+	}
+	return false;
+}
+
+void C4NavGrid::AddCellNeighbour(std::vector<OpenNode> &rOpen, int32_t iFrom, int32_t iTo, C4TransferZone *pZone)
+{
+	if (iFrom == iTo) return;
+	Node &rTo = GetNode(CellNodes, iTo);
+	if (rTo.Closed) return;
+	const Cell &rFrom = Cells[iFrom], &rToCell = Cells[iTo];
+	int32_t iCost = GetNode(CellNodes, iFrom).Cost + Distance(rFrom.WayX, rFrom.WayY, rToCell.WayX, rToCell.WayY);
+	if (iCost >= rTo.Cost) return;
+	rTo.Cost = iCost;
+	rTo.From = iFrom;
+	rTo.Zone = pZone;
+	OpenNode Open = { iCost + Distance(rToCell.WayX, rToCell.WayY, GoalX, GoalY), iTo };
+	rOpen.push_back(Open);
+	std::push_heap(rOpen.begin(), rOpen.end());
+}
+
+bool C4NavGrid::IsLinked(int32_t iCell1, int32_t iCell2)
+{
+	// Same way in both directions
+	if (iCell1 > iCell2) std::swap(iCell1, iCell2);
+	const Cell &rCell1 = Cells[iCell1], &rCell2 = Cells[iCell2];
+	return rCell1.Passable && rCell2.Passable && WalkFree(rCell1.WayX, rCell1.WayY, rCell2.WayX, rCell2.WayY);
+}
+
+bool C4NavGrid::IsAttached(int32_t iX, int32_t iY)
+{
+	// Ground below or a wall to either side
+	for (int32_t i = 1; i <= C4NG_MaxAttach; i++)
+		if (!PointFree(iX, iY + i) || !PointFree(iX - i, iY) || !PointFree(iX + i, iY))
+			return true;
+	return false;
+}
+
+bool C4NavGrid::WalkFree(int32_t iFromX, int32_t iFromY, int32_t iToX, int32_t iToY)
+{
+	// Free and never far from something to walk or climb on
+	int32_t iDX = iToX - iFromX, iDY = iToY - iFromY;
+	int32_t iSteps = std::max<int32_t>(Abs(iDX), Abs(iDY));
+	for (int32_t i = 1; i < iSteps; i++)
+	{
+		int32_t iX = iFromX + iDX * i / iSteps, iY = iFromY + iDY * i / iSteps;
+		if (!PointFree(iX, iY) || !IsAttached(iX, iY))
+			return false;
+	}
+	return true;
+}
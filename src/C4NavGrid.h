@@ -0,0 +1,126 @@
+/*
+ * LegacyClonk
+ *
+ * Copyright (c) 2017-2019, The LegacyClonk Team and contributors
+ *
+ * Distributed under the terms of the ISC license; see accompanying file
+ * "COPYING" for details.
+ *
+ * "Clonk" is a registered trademark of Matthes Bender, used with permission.
+ * See accompanying file "TRADEMARK" for details.
+ *
+ * To redistribute this file separately, substitute the full license texts
+ * for the above references.
+ */
+
+/* Coarse navigation grid: hierarchical A* over landscape blocks */
+
+#pragma once
+
+#include <C4TransferZone.h>
+#include <C4Shape.h>
+
+#include <vector>
+
+// The grid consists of cells the size of the landscape PixCnt blocks. Cells
+// are grouped into clusters; within a cluster, connected passable cells form
+// regions. A search first finds a sequence of regions on the cluster level
+// and then a cell path restricted to these regions.
+// Waypoints are points a clonk can stand or cling to a wall at, and adjacent
+// cells are only linked if the way between their waypoints stays close to
+// the ground or a wall. Jumps and drops are not known to the grid.
+// Clusters are rebuilt lazily when the landscape in them changes, so the grid
+// always matches a fresh build and needs no synchronization.
+class C4NavGrid
+{
+public:
+	C4NavGrid();
+	~C4NavGrid();
+
+protected:
+	struct Cell
+	{
+		bool Passable;
+		uint8_t Region; // connected passable cells within the cluster
+		int32_t WayX, WayY; // standable point closest to the cell center
+	};
+
+	struct Cluster
+	{
+		bool Valid;
+		int32_t Frame; // frame the cluster was built in
+		uint32_t CheckMark; // checked for landscape changes in search SearchMark
+	};
+
+	struct Waypoint
+	{
+		int32_t X, Y;
+		C4TransferZone *Zone; // transfer zone used to get here
+	};
+
+	// search state for a cell or a region, valid if Mark == SearchMark
+	struct Node
+	{
+		uint32_t Mark;
+		int32_t Cost;
+		int32_t From;
+		C4TransferZone *Zone; // zone used to get here
+		bool Closed;
+		bool Corridor; // region on the path found by the cluster level search
+	};
+
+	struct OpenNode
+	{
+		int32_t Estimate, Index;
+		bool operator<(const OpenNode &rOther) const { return Estimate != rOther.Estimate ? Estimate > rOther.Estimate : Index > rOther.Index; }
+	};
+
+	bool(*PointFree)(int32_t, int32_t);
+	C4TransferZones *TransferZones;
+	int32_t LandscapeWdt, LandscapeHgt;
+	int32_t Wdt, Hgt; // in cells
+	int32_t ClusterCols, ClusterRows;
+	std::vector<Cell> Cells;
+	std::vector<Cluster> Clusters;
+	std::vector<Node> CellNodes, RegionNodes;
+	uint32_t SearchMark;
+
+	// current search
+	bool UseZones;
+	int32_t GoalX, GoalY;
+	C4Rect SearchArea; // all clusters looked at
+	int32_t SearchSteps;
+
+public:
+	void Default();
+	void Clear();
+	void Init(bool(*fnPointFree)(int32_t, int32_t), C4TransferZones *pTransferZones);
+	void Invalidate(); // rebuild all clusters when used next
+	// Starts a search; false if start or target lie in cells too solid for the grid
+	bool CanFind(int32_t iFromX, int32_t iFromY, int32_t iToX, int32_t iToY, bool fUseZones);
+	// Finds the path; calls fnSetWaypoint like C4PathFinder, target first
+	bool Find(int32_t iFromX, int32_t iFromY, int32_t iToX, int32_t iToY, bool(*fnSetWaypoint)(int32_t, int32_t, intptr_t, intptr_t), intptr_t iWaypointParameter);
+	const C4Rect &GetSearchArea() const { return SearchArea; }
+	int32_t GetSearchSteps() const { return SearchSteps; }
+
+protected:
+	void UpdateSize();
+	C4Rect GetClusterRect(int32_t iCluster);
+	C4Rect GetCellRect(int32_t iCellX, int32_t iCellY);
+	int32_t GetCellCluster(int32_t iCellX, int32_t iCellY);
+	Cell *GetPointCell(int32_t iX, int32_t iY, int32_t *piCell = nullptr);
+	void EnsureCluster(int32_t iCluster);
+	void BuildCluster(int32_t iCluster);
+	void BuildCell(int32_t iCellX, int32_t iCellY);
+	Node &GetNode(std::vector<Node> &rNodes, int32_t iIndex);
+	bool GetCellRange(const C4Rect &rcArea, int32_t iCluster, int32_t &rX1, int32_t &rY1, int32_t &rX2, int32_t &rY2);
+	bool IsCorridor(int32_t iCellX, int32_t iCellY);
+	int32_t GetRegionNode(int32_t iCellX, int32_t iCellY);
+	bool FindRegions(int32_t iFromCell, int32_t iToCell);
+	bool FindCells(int32_t iFromCell, int32_t iToCell, int32_t iToX, int32_t iToY);
+	void AddRegionNeighbour(std::vector<OpenNode> &rOpen, int32_t iFrom, int32_t iTo, C4TransferZone *pZone);
+	void AddCellNeighbour(std::vector<OpenNode> &rOpen, int32_t iFrom, int32_t iTo, C4TransferZone *pZone);
+	bool IsLinked(int32_t iCell1, int32_t iCell2);
+	bool IsAttached(int32_t iX, int32_t iY);
+	bool WalkFree(int32_t iFromX, int32_t iFromY, int32_t iToX, int32_t iToY);
+};
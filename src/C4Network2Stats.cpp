@@ -302,6 +302,8 @@ C4Network2Stats::C4Network2Stats() : pSec1Timer(nullptr)
 	ControlCounter = 0;
 	// init graphs
 	statObjCount.SetTitle(LoadResStr("IDS_MSG_OBJCOUNT"));
+	statObjAwake.SetTitle(LoadResStr("IDS_MSG_OBJAWAKE"));
+	statObjAsleep.SetTitle(LoadResStr("IDS_MSG_OBJASLEEP"));
 	statFPS.SetTitle(LoadResStr("IDS_MSG_FPS"));
 	statNetI.SetTitle(LoadResStr("IDS_NET_INPUT"));
 	statNetI.SetColorDw(0x00ff00);
@@ -328,6 +330,8 @@ C4Network2Stats::~C4Network2Stats()
 void C4Network2Stats::ExecuteFrame()
 {
 	statObjCount.RecordValue(C4Graph::ValueType(Game.Objects.ObjectCount()));
+	statObjAwake.RecordValue(C4Graph::ValueType(Game.Objects.AwakeCount));
+	statObjAsleep.RecordValue(C4Graph::ValueType(Game.Objects.AsleepCount));
 }
 
 void C4Network2Stats::ExecuteSecond()
@@ -374,6 +378,8 @@ C4Graph *C4Network2Stats::GetGraphByName(const StdStrBuf &rszName, bool &rfIsTem
 	// compare against default graph names
 	rfIsTemp = false;
 	if (SEqualNoCase(rszName.getData(), "oc")) return &statObjCount;
+	if (SEqualNoCase(rszName.getData(), "awake")) return &statObjAwake;
+	if (SEqualNoCase(rszName.getData(), "asleep")) return &statObjAsleep;
 	if (SEqualNoCase(rszName.getData(), "fps")) return &statFPS;
 	if (SEqualNoCase(rszName.getData(), "netio")) return &graphNetIO;
 	if (SEqualNoCase(rszName.getData(), "pings")) return &statPings;
@@ -171,6 +171,7 @@ private:
 
 	// per-frame stats
 	C4TableGraph statObjCount;
+	C4TableGraph statObjAwake, statObjAsleep;
 
 	// per-second stats
 	C4TableGraph statFPS;
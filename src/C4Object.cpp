@@ -112,6 +112,8 @@ void C4Object::Default()
 	Audible = 0;
 	NeedEnergy = 0;
 	Timer = 0;
+	TimerFrame = -1;
+	TimerDue = 0;
 	t_contact = 0;
 	OCF = 0;
 	Action.Default();
@@ -134,6 +136,8 @@ void C4Object::Default()
 	Visibility = VIS_All;
 	LocalNamed.Reset();
 	Marker = 0;
+	ListOrder = 0;
+	std::fill_n(IndexLinks, 1 + C4GO_CategoryIndexCount, nullptr);
 	ColorMod = BlitMode = 0;
 	CrewDisabled = false;
 	pLayer = nullptr;
@@ -141,6 +145,9 @@ void C4Object::Default()
 	pGraphics = nullptr;
 	pDrawTransform = nullptr;
 	pEffects = nullptr;
+	EffectTiming.Default();
+	Asleep = false;
+	OCFInputs.pDef = nullptr;
 	FirstRef = nullptr;
 	pGfxOverlay = nullptr;
 	iLastAttachMovementFrame = -1;
@@ -249,11 +256,11 @@ void C4Object::AssignRemoval(bool fExitContents)
 	if (Contained)
 	{
 		C4AulParSet pars(C4VObj(this));
-		Contained->Call(PSF_ContentsDestruction, &pars);
+		Contained->Call(PSFId_ContentsDestruction, &pars);
 		if (!Status) return;
 	}
 	// Destruction call
-	Call(PSF_Destruction);
+	Call(PSFId_Destruction);
 	// Destruction-callback might have deleted the object already
 	if (!Status) return;
 	// remove all effects (extinguishes as well)
@@ -280,6 +287,7 @@ void C4Object::AssignRemoval(bool fExitContents)
 		Game.Objects.Add(this);
 	}
 	Status = 0;
+	Game.Objects.FindCache.Invalidate(C4FOD_Objects);
 	// count decrease
 	Def->Count--;
 	// Kill contents
@@ -303,6 +311,7 @@ void C4Object::AssignRemoval(bool fExitContents)
 		pCont->UpdateMass();
 		pCont->SetOCF();
 		Contained = nullptr;
+		Game.Objects.FindCache.Invalidate(C4FOD_Objects);
 	}
 	// Object info
 	if (Info) Info->Retire();
@@ -516,9 +525,7 @@ void C4Object::ComponentConGain()
 
 void C4Object::SetOCF()
 {
-#ifdef DEBUGREC_OCF
 	uint32_t dwOCFOld = OCF;
-#endif
 	// Update the object character flag according to the object's current situation
 	FIXED cspeed = GetSpeed();
 #ifdef _DEBUG
@@ -649,6 +656,8 @@ void C4Object::SetOCF()
 	// OCF_Container
 	if ((Def->GrabPutGet & C4D_Grab_Put) || (Def->GrabPutGet & C4D_Grab_Get) || (OCF & OCF_Entrance))
 		OCF |= OCF_Container;
+	SaveOCFInputs();
+	if (OCF != dwOCFOld) Game.Objects.FindCache.Invalidate(C4FOD_OCF);
 #ifdef DEBUGREC_OCF
 	assert(!dwOCFOld || ((dwOCFOld & OCF_Carryable) == (OCF & OCF_Carryable)));
 	C4RCOCF rc = { dwOCFOld, OCF, false };
@@ -656,11 +665,48 @@ void C4Object::SetOCF()
 #endif
 }
 
+// OCF flags UpdateOCF recomputes only if their inputs changed since the last update
+const uint32_t OCF_StateFlags = OCF_Construct | OCF_Entrance | OCF_Collection | OCF_FightReady | OCF_PowerSupply | OCF_Container;
+
+void C4Object::SaveOCFInputs()
+{
+	OCFInputs.pDef = Def;
+	OCFInputs.Con = Con;
+	OCFInputs.r = r;
+	OCFInputs.Act = Action.Act;
+	OCFInputs.OnFire = OnFire;
+	OCFInputs.Alive = !!(OCF & OCF_Alive);
+	OCFInputs.FullCon = !!(OCF & OCF_FullCon);
+	OCFInputs.NoCollectDelay = !!NoCollectDelay;
+	OCFInputs.Energy = Energy > 0;
+}
+
+uint32_t C4Object::GetDirtyOCF()
+{
+	// new def (or def reload, which clears the stored def): everything
+	if (Def != OCFInputs.pDef) return OCF_StateFlags;
+	uint32_t dwDirty = 0;
+	if (Con != OCFInputs.Con || r != OCFInputs.r || OnFire != OCFInputs.OnFire)
+		dwDirty |= OCF_Construct | OCF_Entrance | OCF_Container;
+	if (!!(OCF & OCF_FullCon) != OCFInputs.FullCon)
+		dwDirty |= OCF_Entrance | OCF_Collection | OCF_PowerSupply | OCF_Container;
+	if (!!(OCF & OCF_Alive) != OCFInputs.Alive)
+		dwDirty |= OCF_FightReady;
+	if (Action.Act != OCFInputs.Act)
+		dwDirty |= OCF_Collection | OCF_FightReady;
+	if (!!NoCollectDelay != OCFInputs.NoCollectDelay)
+		dwDirty |= OCF_Collection;
+	if ((Energy > 0) != OCFInputs.Energy)
+		dwDirty |= OCF_PowerSupply;
+	// contents are not tracked: a collection limit needs checking every time
+	if (Def->CollectionLimit)
+		dwDirty |= OCF_Collection;
+	return dwDirty;
+}
+
 void C4Object::UpdateOCF()
 {
-#ifdef DEBUGREC_OCF
 	uint32_t dwOCFOld = OCF;
-#endif
 	// Update the object character flag according to the object's current situation
 	FIXED cspeed = GetSpeed();
 #ifdef _DEBUG
@@ -677,20 +723,24 @@ void C4Object::UpdateOCF()
 		InMat = Contained->Def->ClosedContainer ? MNone : Contained->InMat;
 	else
 		InMat = GBackMat(x, y);
+	// Flags depending on the object's state are only recomputed if their inputs changed
+	uint32_t dwDirty = GetDirtyOCF();
 	// Keep the bits that only have to be updated with SetOCF (def, category, con, alive, onfire)
-	OCF = OCF & (OCF_Normal | OCF_Carryable | OCF_Exclusive | OCF_Edible | OCF_Grab | OCF_FullCon
+	OCF = OCF & ((OCF_Normal | OCF_Carryable | OCF_Exclusive | OCF_Edible | OCF_Grab | OCF_FullCon
 		/*| OCF_Chop - now updated regularly, see below */
 		| OCF_Rotate | OCF_OnFire | OCF_Inflammable | OCF_Living | OCF_Alive
 		| OCF_LineConstruct | OCF_Prey | OCF_CrewMember | OCF_AttractLightning
-		| OCF_PowerConsumer);
+		| OCF_PowerConsumer) | (OCF_StateFlags & ~dwDirty));
 	// OCF_Construct: Can be built outside
-	if (Def->Constructable && (Con < FullCon)
-		&& (r == 0) && !OnFire)
-		OCF |= OCF_Construct;
+	if (dwDirty & OCF_Construct)
+		if (Def->Constructable && (Con < FullCon)
+			&& (r == 0) && !OnFire)
+			OCF |= OCF_Construct;
 	// OCF_Entrance: Can currently be entered/activated
-	if ((Def->Entrance.Wdt > 0) && (Def->Entrance.Hgt > 0))
-		if ((OCF & OCF_FullCon) && ((Def->RotatedEntrance == 1) || (r <= Def->RotatedEntrance)))
-			OCF |= OCF_Entrance;
+	if (dwDirty & OCF_Entrance)
+		if ((Def->Entrance.Wdt > 0) && (Def->Entrance.Hgt > 0))
+			if ((OCF & OCF_FullCon) && ((Def->RotatedEntrance == 1) || (r <= Def->RotatedEntrance)))
+				OCF |= OCF_Entrance;
 	// OCF_Chop: Can be chopped
 	uint32_t cocf = OCF_Exclusive;
 	if (Def->Chopable)
@@ -703,17 +753,19 @@ void C4Object::UpdateOCF()
 	if (cspeed >= HitSpeed3) OCF |= OCF_HitSpeed3;
 	if (cspeed >= HitSpeed4) OCF |= OCF_HitSpeed4;
 	// OCF_Collection
-	if ((OCF & OCF_FullCon) || Def->IncompleteActivity)
-		if ((Def->Collection.Wdt > 0) && (Def->Collection.Hgt > 0))
-			if (!Def->CollectionLimit || (Contents.ObjectCount() < Def->CollectionLimit))
-				if ((Action.Act <= ActIdle) || (!Def->ActMap[Action.Act].Disabled))
-					if (NoCollectDelay == 0)
-						OCF |= OCF_Collection;
+	if (dwDirty & OCF_Collection)
+		if ((OCF & OCF_FullCon) || Def->IncompleteActivity)
+			if ((Def->Collection.Wdt > 0) && (Def->Collection.Hgt > 0))
+				if (!Def->CollectionLimit || (Contents.ObjectCount() < Def->CollectionLimit))
+					if ((Action.Act <= ActIdle) || (!Def->ActMap[Action.Act].Disabled))
+						if (NoCollectDelay == 0)
+							OCF |= OCF_Collection;
 	// OCF_FightReady
-	if (OCF & OCF_Alive)
-		if ((Action.Act <= ActIdle) || (!Def->ActMap[Action.Act].Disabled))
-			if (!Def->NoFight)
-				OCF |= OCF_FightReady;
+	if (dwDirty & OCF_FightReady)
+		if (OCF & OCF_Alive)
+			if ((Action.Act <= ActIdle) || (!Def->ActMap[Action.Act].Disabled))
+				if (!Def->NoFight)
+					OCF |= OCF_FightReady;
 	// OCF_NotContained
 	if (!Contained)
 		OCF |= OCF_NotContained;
@@ -734,21 +786,27 @@ void C4Object::UpdateOCF()
 		if (!GBackSemiSolid(x, y - 1) || (!GBackSolid(x, y - 1) && !GBackSemiSolid(x, y - 8)))
 			OCF |= OCF_Available;
 	// OCF_PowerSupply
-	if ((Def->LineConnect & C4D_Power_Generator)
-		|| ((Def->LineConnect & C4D_Power_Output) && (Energy > 0)))
-		if (OCF & OCF_FullCon)
-			OCF |= OCF_PowerSupply;
+	if (dwDirty & OCF_PowerSupply)
+		if ((Def->LineConnect & C4D_Power_Generator)
+			|| ((Def->LineConnect & C4D_Power_Output) && (Energy > 0)))
+			if (OCF & OCF_FullCon)
+				OCF |= OCF_PowerSupply;
 	// OCF_Container
-	if ((Def->GrabPutGet & C4D_Grab_Put) || (Def->GrabPutGet & C4D_Grab_Get) || (OCF & OCF_Entrance))
-		OCF |= OCF_Container;
+	if (dwDirty & OCF_Container)
+		if ((Def->GrabPutGet & C4D_Grab_Put) || (Def->GrabPutGet & C4D_Grab_Get) || (OCF & OCF_Entrance))
+			OCF |= OCF_Container;
+	if (dwDirty) SaveOCFInputs();
+	if (OCF != dwOCFOld) Game.Objects.FindCache.Invalidate(C4FOD_OCF);
 #ifdef DEBUGREC_OCF
 	C4RCOCF rc = { dwOCFOld, OCF, true };
 	AddDbgRec(RCT_OCF, &rc, sizeof(rc));
 #endif
-#ifdef _DEBUG
+#if defined(_DEBUG) || defined(DEBUGREC_OCF)
+	// verify the incremental update against a full computation
 	DEBUGREC_OFF
 		uint32_t updateOCF = OCF;
 	SetOCF();
+	if (updateOCF != OCF) LogF("Warning: incremental OCF update of %s (#%d) differs: %x instead of %x", GetName(), Number, updateOCF, OCF);
 	assert(updateOCF == OCF);
 	DEBUGREC_ON
 #endif
@@ -906,7 +964,7 @@ bool C4Object::ExecLife()
 				// Take breath
 				int32_t takebreath = GetPhysical()->Breath - Breath;
 				if (takebreath > GetPhysical()->Breath / 2)
-					Call(PSF_DeepBreath);
+					Call(PSFId_DeepBreath);
 				Breath += takebreath;
 			}
 		}
@@ -1026,6 +1084,125 @@ void C4Object::ExecBase()
 	}
 }
 
+void C4Object::ExecTimer()
+{
+	// Timer is only updated when due: count all executions since then, including this one
+	Timer += (TimerFrame < 0) ? 1 : Game.FrameCounter - TimerFrame;
+	TimerFrame = Game.FrameCounter;
+	if (Timer < Def->Timer)
+	{
+		TimerDue = TimerFrame + Def->Timer - Timer;
+		return;
+	}
+	Timer = 0;
+	TimerDue = TimerFrame + std::max<int32_t>(Def->Timer, 1);
+	// TimerCall
+	if (Def->TimerCall) Def->TimerCall->Exec(this);
+}
+
+void C4Object::UpdateTimer()
+{
+	if (TimerFrame < 0) return;
+	Timer += Game.FrameCounter - TimerFrame;
+	TimerFrame = Game.FrameCounter;
+}
+
+bool C4Object::CanSleep()
+{
+	// only static objects at rest, with nothing in Execute left to do but the timer
+	if (Status != C4OS_NORMAL || Contained) return false;
+	if (!(Category & C4D_StaticBack) || (Category & C4D_Structure) || Mobile) return false;
+	if (Action.Act > ActIdle || Command || pEffects || Menu || ViewEnergy) return false;
+	if (FrontParticles || BackParticles) return false;
+	// no life or base execution
+	if (Alive || Energy || ValidPlr(Base) || Def->CanBeBase) return false;
+	if (Def->Growth && Con < FullCon && !OnFire) return false;
+	if (InMat != MNone && Game.Material.Map[InMat].Incindiary && Def->ContactIncinerate) return false;
+	// would be mobilized by upright attachment
+	if (Def->UprightAttach && Inside<int32_t>(r, -StableRange, +StableRange)) return false;
+	return true;
+}
+
+bool C4Object::ExecAsleep()
+{
+	// anything changed since the object fell asleep? Then it has to be executed again
+	if (Game.GetObjectSleep() == C4S_ObjectSleepOff || !CanSleep() || !SleepState.Check(this)
+		// the pixels UpdateOCF looks at
+		|| Game.Landscape.IsChangedSince(C4Rect(x, y - 8, 1, 9), SleepState.iFrame))
+	{
+		Asleep = false;
+		return false;
+	}
+	// chop flag depends on other objects
+	if (Def->Chopable)
+	{
+		uint32_t cocf = OCF_Exclusive;
+		if (!Game.Objects.AtObject(x, y, cocf) != !!(OCF & OCF_Chop))
+		{
+			Asleep = false;
+			return false;
+		}
+	}
+	// check mode: execute anyway; nothing but the timer may change, and the object must fall asleep again
+	if (Game.GetObjectSleep() == C4S_ObjectSleepCheck)
+	{
+		C4ObjectSleepState AsleepState = SleepState;
+		int32_t iNumber = Number; StdStrBuf sName(GetName(), true);
+		Asleep = false;
+		Execute();
+		if (!Status || !Asleep || !AsleepState.Check(this))
+			LogF("Warning: %s (#%d) changed in frame %d while asleep", sName.getData(), iNumber, Game.FrameCounter);
+		return true;
+	}
+#ifdef DEBUGREC
+	// record debug
+	C4RCExecObj rc;
+	rc.Number = Number;
+	rc.id = Def->id;
+	rc.fx = fix_x;
+	rc.fy = fix_y;
+	rc.fr = fix_r;
+	AddDbgRec(RCT_ExecObj, &rc, sizeof(rc));
+#endif
+	// Timer
+	if (Game.FrameCounter >= TimerDue) ExecTimer();
+	// The timer call may have opened a menu or set a view delay; those are done like in Execute
+	// and keep the object from sleeping on
+	if (Menu) Menu->Execute();
+	if (ViewEnergy > 0) ViewEnergy--;
+	return true;
+}
+
+void C4ObjectSleepState::Save(C4Object *pObj)
+{
+	pDef = pObj->Def;
+	x = pObj->x; y = pObj->y; r = pObj->r;
+	Con = pObj->GetCon(); Category = pObj->Category;
+	InLiquid = pObj->InLiquid; NoCollectDelay = pObj->NoCollectDelay;
+	xdir = pObj->xdir; ydir = pObj->ydir;
+	OCF = pObj->OCF;
+	iFrame = Game.FrameCounter;
+}
+
+bool C4ObjectSleepState::Check(C4Object *pObj) const
+{
+	return pDef == pObj->Def
+		&& x == pObj->x && y == pObj->y && r == pObj->r
+		&& Con == pObj->GetCon() && Category == pObj->Category
+		&& InLiquid == pObj->InLiquid && NoCollectDelay == pObj->NoCollectDelay
+		&& xdir == pObj->xdir && ydir == pObj->ydir
+		&& OCF == pObj->OCF;
+}
+
+void C4Object::StopTimer()
+{
+	// count the executions up to now; the current frame only if this object has been executed already
+	if (TimerFrame >= 0 && TimerFrame < Game.FrameCounter)
+		Timer += Game.FrameCounter - TimerFrame - (Game.IsObjectExecuted(this) ? 0 : 1);
+	TimerFrame = -1;
+	TimerDue = 0;
+}
+
 void C4Object::Execute()
 {
 #ifdef DEBUGREC
@@ -1040,6 +1217,9 @@ void C4Object::Execute()
 #endif
 	// OCF
 	UpdateOCF();
+	// Remember the state the OCF has been computed for: if nothing changes, the object may fall asleep
+	bool fMaySleep = Game.GetObjectSleep() != C4S_ObjectSleepOff && CanSleep();
+	if (fMaySleep) SleepState.Save(this);
 	// Command
 	ExecuteCommand();
 	// Action
@@ -1051,9 +1231,6 @@ void C4Object::Execute()
 	// Movement
 	ExecMovement();
 	if (!Status) return;
-	// particles
-	if (BackParticles) BackParticles.Exec(this);
-	if (FrontParticles) FrontParticles.Exec(this);
 	// effects
 	if (pEffects)
 	{
@@ -1065,17 +1242,13 @@ void C4Object::Execute()
 	// Base
 	ExecBase();
 	// Timer
-	Timer++;
-	if (Timer >= Def->Timer)
-	{
-		Timer = 0;
-		// TimerCall
-		if (Def->TimerCall) Def->TimerCall->Exec(this);
-	}
+	if (Game.FrameCounter >= TimerDue) ExecTimer();
 	// Menu
 	if (Menu) Menu->Execute();
 	// View delays
 	if (ViewEnergy > 0) ViewEnergy--;
+	// Sleep
+	if (fMaySleep && CanSleep() && SleepState.Check(this)) Asleep = true;
 }
 
 bool C4Object::At(int32_t ctx, int32_t cty)
@@ -1155,7 +1328,7 @@ void C4Object::AssignDeath(bool fForced)
 		SetPlrViewRange(0);
 	// Engine script call
 	C4AulParSet pars(C4VInt(iDeathCausingPlayer));
-	Call(PSF_Death, &pars);
+	Call(PSFId_Death, &pars);
 	// Update OCF. Done here because previously it would have been done in the next frame
 	// Whats worse: Having the OCF change because of some unrelated script-call like
 	// SetCategory, or slightly breaking compatibility?
@@ -1174,6 +1347,7 @@ bool C4Object::ChangeDef(C4ID idNew)
 	// Pre change resets
 	SetAction(ActIdle);
 	Action.Act = ActIdle; // Enforce ActIdle because SetAction may have failed due to NoOtherAction
+	Game.Objects.FindCache.Invalidate(C4FOD_Action);
 	SetDir(0); // will drop any outdated flipdir
 	if (pSolidMaskData) pSolidMaskData->Remove(true, false);
 	delete pSolidMaskData; pSolidMaskData = nullptr;
@@ -1181,9 +1355,13 @@ bool C4Object::ChangeDef(C4ID idNew)
 	// change the name to the name of the new def, if the name of the old def was in use before
 	if (Name.getData() == Def->Name.getData()) Name = pDef->Name;
 	// Def change
+	C4ID idOld = id;
 	Def = pDef;
 	id = pDef->id;
 	Def->Count++;
+	// recheck timer against the new def
+	TimerDue = 0;
+	Game.Objects.ReIndex(this, idOld, Category);
 	LocalNamed.SetNameList(&pDef->Script.LocalNamed);
 	// new def: Needs to be resorted
 	Unsorted = true;
@@ -1272,7 +1450,7 @@ void C4Object::DoDamage(int32_t iChange, int32_t iCausedBy, int32_t iCause)
 	// Change value
 	Damage = std::max<int32_t>(Damage + iChange, 0);
 	// Engine script call
-	Call(PSF_Damage, &C4AulParSet(C4VInt(iChange), C4VInt(iCausedBy)));
+	Call(PSFId_Damage, &C4AulParSet(C4VInt(iChange), C4VInt(iCausedBy)));
 }
 
 void C4Object::DoEnergy(int32_t iChange, bool fExact, int32_t iCause, int32_t iCausedByPlr)
@@ -1412,8 +1590,8 @@ void C4Object::DoCon(int32_t iChange, bool fInitial, bool fNoComponentChange)
 	// Completion (after bottom y-adjust for correct position)
 	if (!fWasFull && (Con >= FullCon))
 	{
-		Call(PSF_Completion);
-		Call(PSF_Initialize);
+		Call(PSFId_Completion);
+		Call(PSFId_Initialize);
 	}
 
 	// Con Zero Removal
@@ -1447,10 +1625,12 @@ bool C4Object::Exit(int32_t iX, int32_t iY, int32_t iR, FIXED iXDir, FIXED iYDir
 	if (!pContainer) return false;
 	// Remove object from container
 	pContainer->Contents.Remove(this);
+	pContainer->WakeUp();
 	pContainer->UpdateMass();
 	pContainer->SetOCF();
 	// No container
 	Contained = nullptr;
+	Game.Objects.FindCache.Invalidate(C4FOD_Objects);
 	// Position/motion
 	BoundsCheck(iX, iY);
 	x = iX; y = iY; r = iR;
@@ -1463,8 +1643,8 @@ bool C4Object::Exit(int32_t iX, int32_t iY, int32_t iR, FIXED iXDir, FIXED iYDir
 	UpdateFace(true);
 	SetOCF();
 	// Engine calls
-	if (fCalls) pContainer->Call(PSF_Ejection, &C4AulParSet(C4VObj(this)));
-	if (fCalls) Call(PSF_Departure, &C4AulParSet(C4VObj(pContainer)));
+	if (fCalls) pContainer->Call(PSFId_Ejection, &C4AulParSet(C4VObj(this)));
+	if (fCalls) Call(PSFId_Departure, &C4AulParSet(C4VObj(pContainer)));
 	// Success (if the obj wasn't "re-entered" by script)
 	return !Contained;
 }
@@ -1481,14 +1661,14 @@ bool C4Object::Enter(C4Object *pTarget, bool fCalls, bool fCopyMotion, bool *pfR
 	// No target or target is self
 	if (!pTarget || (pTarget == this)) return false;
 	// check if entrance is allowed
-	if (!!Call(PSF_RejectEntrance, &C4AulParSet(C4VObj(pTarget)))) return false;
+	if (!!Call(PSFId_RejectEntrance, &C4AulParSet(C4VObj(pTarget)))) return false;
 	// check if we end up in an endless container-recursion
 	for (C4Object *pCnt = pTarget->Contained; pCnt; pCnt = pCnt->Contained)
 		if (pCnt == this) return false;
 	// Check RejectCollect, if desired
 	if (pfRejectCollect)
 	{
-		if (!!pTarget->Call(PSF_RejectCollection, &C4AulParSet(C4VID(Def->id), C4VObj(this))))
+		if (!!pTarget->Call(PSFId_RejectCollection, &C4AulParSet(C4VID(Def->id), C4VObj(this))))
 		{
 			*pfRejectCollect = true;
 			return false;
@@ -1503,12 +1683,14 @@ bool C4Object::Enter(C4Object *pTarget, bool fCalls, bool fCopyMotion, bool *pfR
 	SetOCF();
 	// Set container
 	Contained = pTarget;
+	Game.Objects.FindCache.Invalidate(C4FOD_Objects);
 	// Enter
 	if (!Contained->Contents.Add(this, C4ObjectList::stContents))
 	{
 		Contained = nullptr;
 		return false;
 	}
+	Contained->WakeUp();
 	// Assume that the new container controls this object, if it cannot control itself (i.e.: Alive)
 	// So it can be traced back who caused the damage, if a projectile hits its target
 	if (!(Alive && (Category & C4D_Living)))
@@ -1529,10 +1711,10 @@ bool C4Object::Enter(C4Object *pTarget, bool fCalls, bool fCopyMotion, bool *pfR
 	Contained->UpdateMass();
 	Contained->SetOCF();
 	// Collection call
-	if (fCalls) pTarget->Call(PSF_Collection2, &C4AulParSet(C4VObj(this)));
+	if (fCalls) pTarget->Call(PSFId_Collection2, &C4AulParSet(C4VObj(this)));
 	if (!Contained || !Contained->Status || !pTarget->Status) return true;
 	// Entrance call
-	if (fCalls) Call(PSF_Entrance, &C4AulParSet(C4VObj(Contained)));
+	if (fCalls) Call(PSFId_Entrance, &C4AulParSet(C4VObj(Contained)));
 	if (!Contained || !Contained->Status || !pTarget->Status) return true;
 	// Base auto sell contents
 	if (ValidPlr(Contained->Base))
@@ -1571,7 +1753,7 @@ bool C4Object::ActivateEntrance(int32_t by_plr, C4Object *by_obj)
 	}
 	// Try entrance activation
 	if (OCF & OCF_Entrance)
-		if (!!Call(PSF_ActivateEntrance, &C4AulParSet(C4VObj(by_obj))))
+		if (!!Call(PSFId_ActivateEntrance, &C4AulParSet(C4VObj(by_obj))))
 			return true;
 	// Failure
 	return false;
@@ -1641,7 +1823,7 @@ bool C4Object::Build(int32_t iLevel, C4Object *pBuilder)
 	if (NeededMaterialCount)
 	{
 		// BuildNeedsMaterial call to builder script...
-		if (!pBuilder->Call(PSF_BuildNeedsMaterial,
+		if (!pBuilder->Call(PSFId_BuildNeedsMaterial,
 			&C4AulParSet(C4VID(NeededMaterial), C4VInt(NeededMaterialCount))))
 		{
 			// Builder is a crew member...
@@ -1737,7 +1919,7 @@ bool C4Object::Push(FIXED txdir, FIXED dforce, bool fStraighten)
 		{
 			sprintf(OSTR, LoadResStr("IDS_OBJ_STUCK"), GetName());
 			GameMsgObject(OSTR, this);
-			Call(PSF_Stuck);
+			Call(PSFId_Stuck);
 		}
 
 	return true;
@@ -1768,7 +1950,7 @@ bool C4Object::Lift(FIXED tydir, FIXED dforce)
 		{
 			sprintf(OSTR, LoadResStr("IDS_OBJ_STUCK"), GetName());
 			GameMsgObject(OSTR, this);
-			Call(PSF_Stuck);
+			Call(PSFId_Stuck);
 		}
 	return true;
 }
@@ -1813,7 +1995,7 @@ bool C4Object::ActivateMenu(int32_t iMenu, int32_t iMenuSelect,
 		// No target specified: use own container as target
 		if (!pTarget) if (!(pTarget = Contained)) break;
 		// Opening contents menu blocked by RejectContents
-		if (!!pTarget->Call(PSF_RejectContents)) return false;
+		if (!!pTarget->Call(PSFId_RejectContents)) return false;
 		// Create symbol
 		fctSymbol.Create(C4SymbolSize, C4SymbolSize);
 		pTarget->Def->Draw(fctSymbol, false, pTarget->Color, pTarget);
@@ -1856,7 +2038,7 @@ bool C4Object::ActivateMenu(int32_t iMenu, int32_t iMenuSelect,
 		// No target specified
 		if (!pTarget) break;
 		// Opening contents menu blocked by RejectContents
-		if (!!pTarget->Call(PSF_RejectContents)) return false;
+		if (!!pTarget->Call(PSFId_RejectContents)) return false;
 		// Create symbol & init
 		fctSymbol.Create(C4SymbolSize, C4SymbolSize);
 		pTarget->Def->Draw(fctSymbol, false, pTarget->Color, pTarget);
@@ -2099,7 +2281,7 @@ bool C4Object::Promote(int32_t torank, bool fForceRankName)
 void C4Object::ClearPointers(C4Object *pObj)
 {
 	// effects
-	if (pEffects) pEffects->ClearPointers(pObj);
+	if (pEffects) pEffects->ClearPointers(pObj, this);
 	// contents/contained: not necessary, because it's done in AssignRemoval and StatusDeactivate
 	// Action targets
 	if (Action.Target == pObj) Action.Target = nullptr;
@@ -2132,6 +2314,12 @@ C4Value C4Object::Call(const char *szFunctionCall, C4AulParSet *pPars, bool fPas
 	return Def->Script.ObjectCall(this, this, szFunctionCall, pPars, fPassError);
 }
 
+C4Value C4Object::Call(C4PSFId eCallback, C4AulParSet *pPars, bool fPassError)
+{
+	if (!Status || !Def) return C4VNull;
+	return Def->Script.ObjectCall(this, this, eCallback, pPars, fPassError);
+}
+
 bool C4Object::SetPhase(int32_t iPhase)
 {
 	if (Action.Act <= ActIdle) return false;
@@ -2657,6 +2845,7 @@ void C4Object::CompileFunc(StdCompiler *pComp)
 	pComp->Value(mkNamingAdapt(Status,                                  "Status",             1));
 	pComp->Value(mkNamingAdapt(toC4CStrBuf(nInfo),                      "Info",               ""));
 	pComp->Value(mkNamingAdapt(Owner,                                   "Owner",              NO_OWNER));
+	if (!fCompiler) UpdateTimer();
 	pComp->Value(mkNamingAdapt(Timer,                                   "Timer",              0));
 	pComp->Value(mkNamingAdapt(Controller,                              "Controller",         NO_OWNER));
 	pComp->Value(mkNamingAdapt(LastEnergyLossCausePlayer,               "LastEngLossPlr",     NO_OWNER));
@@ -2714,7 +2903,9 @@ void C4Object::CompileFunc(StdCompiler *pComp)
 	pComp->Value(mkNamingAdapt(nLayer,                                  "Layer",              0));
 	pComp->Value(mkNamingAdapt(C4DefGraphicsAdapt(pGraphics),           "Graphics",           &Def->Graphics));
 	pComp->Value(mkNamingPtrAdapt(pDrawTransform,                       "DrawTransform"));
+	if (!pComp->isCompiler() && pEffects) pEffects->SaveTimes(this);
 	pComp->Value(mkNamingPtrAdapt(pEffects,                             "Effects"));
+	if (pComp->isCompiler() && pEffects) pEffects->LoadTimes(this);
 	pComp->Value(mkNamingAdapt(C4GraphicsOverlayListAdapt(pGfxOverlay), "GfxOverlay",         (C4GraphicsOverlay *)nullptr));
 
 	if (PhysicalTemporary)
@@ -2756,6 +2947,12 @@ void C4Object::CompileFunc(StdCompiler *pComp)
 		// add to def count
 		Def->Count++;
 
+		// timer starts counting at the first execution
+		TimerFrame = -1;
+		TimerDue = 0;
+		// loaded OCF has to be recomputed completely
+		OCFInputs.pDef = nullptr;
+
 		// set local variable names
 		LocalNamed.SetNameList(&Def->Script.LocalNamed);
 
@@ -3071,7 +3268,7 @@ void C4Object::Picture2Facet(C4FacetExSurface &cgo)
 bool C4Object::ValidateOwner()
 {
 	// Check owner and controller
-	if (!ValidPlr(Owner)) Owner = NO_OWNER;
+	if (!ValidPlr(Owner)) { Owner = NO_OWNER; Game.Objects.FindCache.Invalidate(C4FOD_Owner); }
 	if (!ValidPlr(Base)) Base = NO_OWNER;
 	if (!ValidPlr(Controller)) Controller = NO_OWNER;
 	// Color is not reset any more, because many scripts change colors to non-owner-colors these days
@@ -3180,7 +3377,7 @@ bool C4Object::ContainedControl(uint8_t byCom)
 				C4VInt(Coms2ComDir(PressedComs)),
 				C4VBool(!!(PressedComs & (1 << COM_Dig))),
 				C4VBool(!!(PressedComs & (1 << COM_Throw))));
-			Contained->Call(PSF_ContainedControlUpdate, &set);
+			Contained->Call(PSFId_ContainedControlUpdate, &set);
 		}
 	}
 	if (result) return true;
@@ -3218,7 +3415,7 @@ bool C4Object::ContainedControl(uint8_t byCom)
 				C4VInt(Coms2ComDir(PressedComs)),
 				C4VBool(!!(PressedComs & (1 << COM_Dig))),
 				C4VBool(!!(PressedComs & (1 << COM_Throw))));
-			Contained->Call(PSF_ContainedControlUpdate, &set);
+			Contained->Call(PSFId_ContainedControlUpdate, &set);
 		}
 	}
 	// Take/Take2
@@ -3251,7 +3448,7 @@ bool C4Object::CallControl(C4Player *pPlr, uint8_t byCom, C4AulParSet *pPars)
 			C4VBool(!!(PressedComs & (1 << COM_Throw))),
 			C4VBool(!!(PressedComs & (1 << COM_Special))),
 			C4VBool(!!(PressedComs & (1 << COM_Special2))));
-		Call(PSF_ControlUpdate, &set);
+		Call(PSFId_ControlUpdate, &set);
 	}
 	return result;
 }
@@ -3677,7 +3874,7 @@ C4Object *C4Object::ComposeContents(C4ID id)
 	if (fInsufficient)
 	{
 		// BuildNeedsMaterial call to object...
-		if (!Call(PSF_BuildNeedsMaterial, &C4AulParSet(C4VID(idNeeded), C4VInt(iNeeded))))
+		if (!Call(PSFId_BuildNeedsMaterial, &C4AulParSet(C4VID(idNeeded), C4VInt(iNeeded))))
 			// ...game message if not overloaded
 			GameMsgObject(Needs.getData(), this);
 		// Return
@@ -3837,7 +4034,7 @@ void C4Object::SetCommand(int32_t iCommand, C4Object *pTarget, C4Value iTx, int3
 		if (!CloseMenu(false)) return;
 	// Script overload
 	if (fControl)
-		if (!!Call(PSF_ControlCommand, &C4AulParSet(C4VString(CommandName(iCommand)),
+		if (!!Call(PSFId_ControlCommand, &C4AulParSet(C4VString(CommandName(iCommand)),
 			C4VObj(pTarget),
 			iTx,
 			C4VInt(iTy),
@@ -3849,7 +4046,7 @@ void C4Object::SetCommand(int32_t iCommand, C4Object *pTarget, C4Value iTx, int3
 		if (Contained->Def->VehicleControl & C4D_VehicleControl_Inside)
 		{
 			Contained->Controller = Controller;
-			if (!!Contained->Call(PSF_ControlCommand, &C4AulParSet(C4VString(CommandName(iCommand)),
+			if (!!Contained->Call(PSFId_ControlCommand, &C4AulParSet(C4VString(CommandName(iCommand)),
 				C4VObj(pTarget),
 				iTx,
 				C4VInt(iTy),
@@ -3863,7 +4060,7 @@ void C4Object::SetCommand(int32_t iCommand, C4Object *pTarget, C4Value iTx, int3
 		if (Action.Target) if (Action.Target->Def->VehicleControl & C4D_VehicleControl_Outside)
 		{
 			Action.Target->Controller = Controller;
-			if (!!Action.Target->Call(PSF_ControlCommand, &C4AulParSet(C4VString(CommandName(iCommand)),
+			if (!!Action.Target->Call(PSFId_ControlCommand, &C4AulParSet(C4VString(CommandName(iCommand)),
 				C4VObj(pTarget),
 				iTx,
 				C4VInt(iTy),
@@ -3890,7 +4087,7 @@ bool C4Object::ExecuteCommand()
 	if (Command) Command->Execute();
 	// Command finished: engine call
 	if (Command && Command->Finished)
-		Call(PSF_ControlCommandFinished, &C4AulParSet(C4VString(CommandName(Command->Command)), C4VObj(Command->Target), Command->Tx, C4VInt(Command->Ty), C4VObj(Command->Target2), C4Value(Command->Data, C4V_Any)));
+		Call(PSFId_ControlCommandFinished, &C4AulParSet(C4VString(CommandName(Command->Command)), C4VObj(Command->Target), Command->Tx, C4VInt(Command->Ty), C4VObj(Command->Target2), C4Value(Command->Data, C4V_Any)));
 	// Clear finished commands
 	while (Command && Command->Finished) ClearCommand(Command);
 	// Done
@@ -3981,6 +4178,15 @@ void C4Object::DrawCommand(C4Facet &cgoBar, int32_t iAlign, const char *szFuncti
 		pRegions->Add(cgoLeft.X, cgoLeft.Y, cgoLeft.Wdt * 2, cgoLeft.Hgt, cpDesc ? cpDesc : GetName(), iCom);
 }
 
+void C4Object::SetCategory(int32_t iCategory)
+{
+	int32_t iOldCategory = Category;
+	Category = iCategory;
+	Game.Objects.ReIndex(this, id, iOldCategory);
+	Resort();
+	SetOCF();
+}
+
 void C4Object::Resort()
 {
 	// Flag resort
@@ -4031,6 +4237,7 @@ bool C4Object::SetAction(int32_t iAct, C4Object *pTarget, C4Object *pTarget2, in
 
 	// Set new action
 	Action.Act = iAct;
+	Game.Objects.FindCache.Invalidate(C4FOD_Action);
 	std::fill(Action.Name, std::end(Action.Name), '\0');
 	if (Action.Act > ActIdle) SCopy(Def->ActMap[Action.Act].Name, Action.Name);
 	Action.Phase = Action.PhaseDelay = 0;
@@ -4168,7 +4375,7 @@ int32_t C4Object::GetProcedure()
 void GrabLost(C4Object *cObj)
 {
 	// Grab lost script call on target (quite hacky stuff...)
-	cObj->Action.Target->Call(PSF_GrabLost);
+	cObj->Action.Target->Call(PSFId_GrabLost);
 	// Clear commands down to first PushTo (if any) in command stack
 	for (C4Command *pCom = cObj->Command; pCom; pCom = pCom->Next)
 		if (pCom->Next && pCom->Next->Command == C4CMD_PushTo)
@@ -5177,7 +5384,7 @@ void C4Object::ExecAction()
 		if (Def->LiftTop)
 			if (Action.Target->y <= (y + Def->LiftTop))
 				if (Action.ComDir == COMD_Up)
-					Call(PSF_LiftTop);
+					Call(PSFId_LiftTop);
 		// General
 		DoGravity(this);
 		break;
@@ -5213,7 +5420,7 @@ void C4Object::ExecAction()
 			if (Status)
 			{
 				SetAction(ActIdle);
-				Call(PSF_AttachTargetLost);
+				Call(PSFId_AttachTargetLost);
 			}
 			return;
 		}
@@ -5238,7 +5445,7 @@ void C4Object::ExecAction()
 				if (Status)
 				{
 					SetAction(ActIdle);
-					Call(PSF_AttachTargetLost);
+					Call(PSFId_AttachTargetLost);
 				}
 				return;
 			}
@@ -5264,7 +5471,7 @@ void C4Object::ExecAction()
 		if (!Action.Target2 || (Action.Target2->Con < FullCon)) fBroke = true;
 		if (fBroke)
 		{
-			Call(PSF_LineBreak, &C4AulParSet(C4VBool(true)));
+			Call(PSFId_LineBreak, &C4AulParSet(C4VBool(true)));
 			AssignRemoval();
 			return;
 		}
@@ -5329,7 +5536,7 @@ void C4Object::ExecAction()
 		// Line fBroke
 		if (fBroke)
 		{
-			Call(PSF_LineBreak, 0);
+			Call(PSFId_LineBreak, 0);
 			AssignRemoval();
 			return;
 		}
@@ -5410,6 +5617,7 @@ bool C4Object::SetOwner(int32_t iOwner)
 	// set new owner
 	int32_t iOldOwner = Owner;
 	Owner = iOwner;
+	Game.Objects.FindCache.Invalidate(C4FOD_Owner);
 	if (Owner != NO_OWNER)
 		// add to plr view
 		PlrFoWActualize();
@@ -5422,7 +5630,7 @@ bool C4Object::SetOwner(int32_t iOwner)
 			Action.Target->Base = Owner;
 		}
 	// script callback
-	Call(PSF_OnOwnerChanged, &C4AulParSet(C4VInt(Owner), C4VInt(iOldOwner)));
+	Call(PSFId_OnOwnerChanged, &C4AulParSet(C4VInt(Owner), C4VInt(iOldOwner)));
 	// done
 	return true;
 }
@@ -5576,11 +5784,11 @@ bool C4Object::Collect(C4Object *pObj)
 	// Cancel attach (hacky)
 	ObjectComCancelAttach(pObj);
 	// Container Collection call
-	Call(PSF_Collection, &C4AulParSet(C4VObj(pObj)));
+	Call(PSFId_Collection, &C4AulParSet(C4VObj(pObj)));
 	// Object Hit call
-	if (pObj->Status && pObj->OCF & OCF_HitSpeed1) pObj->Call(PSF_Hit);
-	if (pObj->Status && pObj->OCF & OCF_HitSpeed2) pObj->Call(PSF_Hit2);
-	if (pObj->Status && pObj->OCF & OCF_HitSpeed3) pObj->Call(PSF_Hit3);
+	if (pObj->Status && pObj->OCF & OCF_HitSpeed1) pObj->Call(PSFId_Hit);
+	if (pObj->Status && pObj->OCF & OCF_HitSpeed2) pObj->Call(PSFId_Hit2);
+	if (pObj->Status && pObj->OCF & OCF_HitSpeed3) pObj->Call(PSFId_Hit3);
 	// post-copy the motion of the new container
 	if (pObj->Contained == this) pObj->CopyMotion(this);
 	// done, success
@@ -5692,7 +5900,7 @@ bool C4Object::DoSelect(bool fCursor)
 	// select
 	if (!fCursor) Select = 1;
 	// do callback
-	Call(PSF_CrewSelection, &C4AulParSet(C4VBool(false), C4VBool(!!fCursor)));
+	Call(PSFId_CrewSelection, &C4AulParSet(C4VBool(false), C4VBool(!!fCursor)));
 	// done
 	return true;
 }
@@ -5702,7 +5910,7 @@ void C4Object::UnSelect(bool fCursor)
 	// unselect
 	if (!fCursor) Select = 0;
 	// do callback
-	Call(PSF_CrewSelection, &C4AulParSet(C4VBool(true), C4VBool(!!fCursor)));
+	Call(PSFId_CrewSelection, &C4AulParSet(C4VBool(true), C4VBool(!!fCursor)));
 }
 
 void C4Object::GetViewPosPar(int32_t &riX, int32_t &riY, int32_t tx, int32_t ty, const C4Facet &fctViewport)
@@ -5848,11 +6056,15 @@ bool C4Object::StatusActivate()
 	Game.Objects.InactiveObjects.Remove(this);
 	Status = C4OS_NORMAL;
 	Game.Objects.Add(this);
+	WakeUp();
+	// no executions while inactive
+	TimerFrame = -1;
+	TimerDue = 0;
 	// update some values
 	UpdateGraphics(false);
 	UpdateFace(true);
 	UpdatePos();
-	Call(PSF_UpdateTransferZone);
+	Call(PSFId_UpdateTransferZone);
 	// done, success
 	return true;
 }
@@ -5863,6 +6075,7 @@ bool C4Object::StatusDeactivate(bool fClearPointers)
 	if (FrontParticles) FrontParticles.Clear();
 	if (BackParticles) BackParticles.Clear();
 	// put into inactive list
+	StopTimer();
 	Game.Objects.Remove(this);
 	Status = C4OS_INACTIVE;
 	Game.Objects.InactiveObjects.Add(this, C4ObjectList::stMain);
@@ -5985,22 +6198,22 @@ void C4Object::UpdateInLiquid()
 
 void C4Object::AddRef(C4Value *pRef)
 {
-	pRef->NextRef = FirstRef;
+	pRef->SetNextRef(FirstRef);
 	FirstRef = pRef;
 }
 
 void C4Object::DelRef(const C4Value *pRef, C4Value *pNextRef)
 {
-	// References to objects never have HasBaseArray set
+	// References to objects never have a base array
 	if (pRef == FirstRef)
 		FirstRef = pNextRef;
 	else
 	{
 		C4Value *pVal = FirstRef;
-		while (pVal->NextRef && pVal->NextRef != pRef)
-			pVal = pVal->NextRef;
-		assert(pVal->NextRef);
-		pVal->NextRef = pNextRef;
+		while (pVal->GetNextRef() && pVal->GetNextRef() != pRef)
+			pVal = pVal->GetNextRef();
+		assert(pVal->GetNextRef());
+		pVal->SetNextRef(pNextRef);
 	}
 }
 
@@ -26,9 +26,15 @@
 #include "C4ValueList.h"
 #include "C4Effects.h"
 #include "C4Particles.h"
+#include "C4Script.h"
 
 #include <array>
 
+class C4ObjectLink;
+
+// number of sort category bits (C4D_SortLimit) indexed by C4GameObjects
+const int32_t C4GO_CategoryIndexCount = 5;
+
 /* Object status */
 
 #define C4OS_DELETED  0
@@ -107,6 +113,28 @@ public:
 	void GetBridgeData(int32_t &riBridgeTime, bool &rfMoveClonk, bool &rfWall, int32_t &riBridgeMaterial);
 };
 
+// state an object at rest is compared against while it is asleep
+struct C4ObjectSleepState
+{
+	C4Def *pDef;
+	int32_t x, y, r, Con, Category;
+	int32_t InLiquid, NoCollectDelay;
+	FIXED xdir, ydir;
+	uint32_t OCF;
+	int32_t iFrame; // frame in which the state was taken
+
+	void Save(C4Object *pObj);
+	bool Check(C4Object *pObj) const; // whether pObj still is in the saved state
+};
+
+// inputs of the state dependent OCF flags, as of their last computation
+struct C4OCFInputs
+{
+	C4Def *pDef; // nullptr if the flags have to be recomputed
+	int32_t Con, r, Act;
+	bool OnFire, Alive, FullCon, NoCollectDelay, Energy;
+};
+
 class C4Object
 {
 public:
@@ -117,6 +145,8 @@ public:
 	StdStrBuf Name;
 	int32_t Status; // NoSave //
 	int32_t RemovalDelay; // NoSave //
+	uint64_t ListOrder; // ascending along Game.Objects, with gaps - NoSave
+	C4ObjectLink *IndexLinks[1 + C4GO_CategoryIndexCount]; // links in the find indices of Game.Objects: by ID, then by sort category - NoSave
 	int32_t Owner;
 	int32_t Controller;
 	int32_t LastEnergyLossCausePlayer; // last player that caused an energy loss to this Clonk (used to trace kills when player tumbles off a cliff, etc.)
@@ -135,7 +165,9 @@ public:
 	int32_t FirePhase;
 	int32_t InMat; // SyncClearance-NoSave //
 	uint32_t Color;
-	int32_t Timer;
+	int32_t Timer; // executions since the last TimerCall, counted up to TimerFrame
+	int32_t TimerFrame; // NoSave // last frame counted into Timer; -1 if the timer is not running
+	int32_t TimerDue; // NoSave // frame in which the timer has to be checked next
 	int32_t ViewEnergy; // NoSave //
 	int32_t Audible, AudiblePan; // NoSave //
 	C4ValueList Local;
@@ -181,7 +213,11 @@ public:
 	std::array<int32_t, C4MaxMaterial> MaterialContents; // SyncClearance-NoSave //
 	C4DefGraphics *pGraphics; // currently set object graphics
 	C4Effect *pEffects; // linked list of effects
+	C4EffectTiming EffectTiming; // execution timing of effects
 	C4ParticleList FrontParticles, BackParticles; // lists of object local particles
+	bool Asleep; // NoSave // object is at rest and not executed while its sleep state stays unchanged
+	C4ObjectSleepState SleepState; // NoSave //
+	C4OCFInputs OCFInputs; // NoSave //
 
 	bool PhysicalTemporary; // physical temporary counter
 	C4TempPhysicalInfo TemporaryPhysical;
@@ -237,6 +273,7 @@ public:
 
 	bool CallControl(C4Player *pPlr, uint8_t byCom, C4AulParSet *pPars = nullptr);
 	C4Value Call(const char *szFunctionCall, C4AulParSet *pPars = nullptr, bool fPassError = false);
+	C4Value Call(C4PSFId eCallback, C4AulParSet *pPars = nullptr, bool fPassError = false);
 
 	bool ContainedControl(uint8_t byCom);
 
@@ -277,6 +314,12 @@ public:
 	bool ExecLife();
 	bool ExecuteCommand();
 	void ExecBase();
+	void ExecTimer();
+	void UpdateTimer(); // count all frames executed so far into Timer
+	void StopTimer(); // update Timer before the object stops being executed every frame
+	bool CanSleep(); // whether executing the object would change nothing but its timer
+	bool ExecAsleep(); // execute sleeping object; returns false if it has woken up and needs to be executed
+	void WakeUp() { Asleep = false; }
 	void AssignDeath(bool fForced); // assigns death - if forced, it's killed even if an effect stopped this
 	void ContactAction();
 	void NoAttachAction();
@@ -284,6 +327,8 @@ public:
 	void Stabilize();
 	void SetOCF();
 	void UpdateOCF(); // Update fluctuant OCF
+	void SaveOCFInputs();
+	uint32_t GetDirtyOCF(); // state dependent OCF flags whose inputs changed since they were computed
 	void UpdateShape(bool bUpdateVertices = true);
 	void UpdatePos(); // pos/shape changed
 	void UpdateSolidMask(bool fRestoreAttachedObjects);
@@ -307,7 +352,7 @@ public:
 	bool SetAction(int32_t iAct, C4Object *pTarget = nullptr, C4Object *pTarget2 = nullptr, int32_t iCalls = SAC_StartCall | SAC_AbortCall, bool fForce = false);
 	bool SetActionByName(const char *szActName, C4Object *pTarget = nullptr, C4Object *pTarget2 = nullptr, int32_t iCalls = SAC_StartCall | SAC_AbortCall, bool fForce = false);
 	void SetDir(int32_t tdir);
-	void SetCategory(int32_t Category) { this->Category = Category; Resort(); SetOCF(); }
+	void SetCategory(int32_t iCategory);
 	int32_t GetProcedure();
 	bool Enter(C4Object *pTarget, bool fCalls = true, bool fCopyMotion = true, bool *pfRejectCollect = nullptr);
 	bool Exit(int32_t iX = 0, int32_t iY = 0, int32_t iR = 0, FIXED iXDir = Fix0, FIXED iYDir = Fix0, FIXED iRDir = Fix0, bool fCalls = true);
@@ -315,6 +360,7 @@ public:
 	void ForcePosition(int32_t tx, int32_t ty);
 	void MovePosition(int32_t dx, int32_t dy);
 	void DoMotion(int32_t mx, int32_t my);
+	void SkipFreeMotion(int32_t mx, int32_t my); // move along an axis as far as no contact is possible, leaving the last free step
 	bool ActivateEntrance(int32_t by_plr, C4Object *by_obj);
 	bool Incinerate(int32_t iCausedBy, bool fBlasted = false, C4Object *pIncineratingObject = nullptr);
 	bool Extinguish(int32_t iFireNumber);
@@ -629,6 +629,10 @@ void C4ObjectList::UpdateDefPointers(C4Def *pDef)
 		if (cLnk->Obj->Def == pDef)
 		{
 			cLnk->Obj->SetName(nullptr);
+			// timer interval, sleep conditions and OCF may have changed
+			cLnk->Obj->TimerDue = 0;
+			cLnk->Obj->WakeUp();
+			cLnk->Obj->OCFInputs.pDef = nullptr;
 		}
 }
 
@@ -775,7 +779,7 @@ void C4ObjectList::UpdateTransferZones()
 {
 	C4Object *cobj; C4ObjectLink *clnk;
 	for (clnk = First; clnk && (cobj = clnk->Obj); clnk = clnk->Next)
-		cobj->Call(PSF_UpdateTransferZone);
+		cobj->Call(PSFId_UpdateTransferZone);
 }
 
 void C4ObjectList::ResetAudibility()
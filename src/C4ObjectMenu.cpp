@@ -55,7 +55,7 @@ bool C4ObjectMenu::IsCloseDenied()
 		C4AulParSet pars(C4VInt(Selection), C4VObj(ParentObject));
 		if (eCallbackType == CB_Object)
 		{
-			if (Object) fResult = !!Object->Call(PSF_MenuQueryCancel, &pars);
+			if (Object) fResult = !!Object->Call(PSFId_MenuQueryCancel, &pars);
 		}
 		else if (eCallbackType == CB_Scenario)
 			fResult = !!Game.Script.Call(PSF_MenuQueryCancel, &pars);
@@ -88,7 +88,7 @@ void C4ObjectMenu::OnSelectionChanged(int32_t iNewSelection)
 	{
 		C4AulParSet pars(C4VInt(iNewSelection), C4VObj(ParentObject));
 		if (eCallbackType == CB_Object && Object)
-			Object->Call(PSF_MenuSelection, &pars);
+			Object->Call(PSFId_MenuSelection, &pars);
 		else if (eCallbackType == CB_Scenario)
 			Game.Script.Call(PSF_MenuSelection, &pars);
 	}
@@ -268,7 +268,7 @@ bool C4ObjectMenu::DoRefillInternal(bool &rfRefilled)
 				if (Identification == C4MN_Contents)
 				{
 					if (Object && Object->Def->CollectionLimit && (Object->Contents.ObjectCount() >= Object->Def->CollectionLimit)) fGet = false; // collection limit reached
-					if (Object && !!Object->Call(PSF_RejectCollection, &C4AulParSet(C4VID(pObj->Def->id), C4VObj(pObj)))) fGet = false; // collection rejected
+					if (Object && !!Object->Call(PSFId_RejectCollection, &C4AulParSet(C4VID(pObj->Def->id), C4VObj(pObj)))) fGet = false; // collection rejected
 				}
 				if (!(pTarget->OCF & OCF_Entrance)) fGet = true; // target object has no entrance: cannot activate - force get
 				// Caption
@@ -29,6 +29,9 @@
 #include <C4Wrappers.h>
 #endif
 
+#include <StdScheduler.h>
+#include <StdSync.h>
+
 void C4ParticleDefCore::CompileFunc(StdCompiler *pComp)
 {
 	pComp->Value(mkNamingAdapt(toC4CStrBuf(Name),                "Name",         ""));
@@ -206,114 +209,473 @@ bool C4ParticleDef::Reload()
 	return Load(hGroup);
 }
 
-void C4Particle::MoveList(C4ParticleList &rFrom, C4ParticleList &rTo)
+void C4ParticleBlock::Get(int32_t i, C4Particle &rPrt) const
 {
-	// remove from current list
-	if (pPrev)
-		pPrev->pNext = pNext;
-	else
-		// is it the first item in the list? then set this to the next one
-		if (rFrom.pFirst == this) rFrom.pFirst = pNext;
-	if (pNext) pNext->pPrev = pPrev;
-	// add to the other list - insert before first
-	if (pNext = rTo.pFirst) pNext->pPrev = this;
-	rTo.pFirst = this; pPrev = nullptr;
+	rPrt.pDef = pDef;
+	rPrt.x = x[i]; rPrt.y = y[i];
+	rPrt.xdir = xdir[i]; rPrt.ydir = ydir[i];
+	rPrt.life = life[i];
+	rPrt.a = a[i]; rPrt.b = b[i];
 }
 
-C4ParticleChunk::C4ParticleChunk()
+void C4ParticleBlock::Set(int32_t i, const C4Particle &rPrt)
 {
-	// zero linked list
-	pNext = nullptr;
-	// zero buffer
-	Clear();
+	x[i] = rPrt.x; y[i] = rPrt.y;
+	xdir[i] = rPrt.xdir; ydir[i] = rPrt.ydir;
+	life[i] = rPrt.life;
+	a[i] = rPrt.a; b[i] = rPrt.b;
+}
+
+void C4ParticleBlock::Add(const C4Particle &rPrt)
+{
+	x.push_back(rPrt.x); y.push_back(rPrt.y);
+	xdir.push_back(rPrt.xdir); ydir.push_back(rPrt.ydir);
+	life.push_back(rPrt.life);
+	a.push_back(rPrt.a); b.push_back(rPrt.b);
+	++Count;
 }
 
-C4ParticleChunk::~C4ParticleChunk()
+void C4ParticleBlock::Remove(int32_t i)
 {
-	// list stuff done by C4ParticleSystem
+	// move last particle into the gap
+	int32_t iLast = --Count;
+	x[i] = x[iLast]; y[i] = y[iLast];
+	xdir[i] = xdir[iLast]; ydir[i] = ydir[iLast];
+	life[i] = life[iLast];
+	a[i] = a[iLast]; b[i] = b[iLast];
+	x.pop_back(); y.pop_back();
+	xdir.pop_back(); ydir.pop_back();
+	life.pop_back();
+	a.pop_back(); b.pop_back();
 }
 
-void C4ParticleChunk::Clear()
+void C4ParticleBlock::Exec(const C4ParticleTarget &rTarget)
 {
-	// note that this method is called in ctor with uninitialized data!
-	// simply clear mem - this won't adjust any counts!
-	std::memset(Data, 0, sizeof(Data));
-	// init list
-	C4Particle *pPrt = Data;
-	for (int32_t i = 0; i < C4Px_BufSize; ++i)
+	// standard procedure: run over the arrays
+	if (pDef->ExecProc == &fxStdExec)
 	{
-		pPrt->pPrev = pPrt - 1;
-		pPrt->pNext = pPrt + 1;
-		++pPrt;
+		ExecStd(rTarget);
+		Removed += RemoveDead();
+		return;
+	}
+	// any other: execute one by one
+	C4Particle Prt;
+	for (int32_t i = 0; i < Count; )
+	{
+		Get(i, Prt);
+		if (pDef->ExecProc(&Prt, nullptr))
+		{
+			Set(i, Prt);
+			++i;
+		}
+		else
+		{
+			// sorry, life is over for you :P
+			Remove(i);
+			++Removed;
+		}
 	}
-	Data[0].pPrev = Data[C4Px_BufSize - 1].pNext = nullptr;
 }
 
-void C4ParticleList::Exec(C4Object *pObj)
+void C4ParticleBlock::ExecStd(const C4ParticleTarget &rTarget)
 {
-	// execute all particles
-	C4Particle *pPrtNext = pFirst, *pPrt;
-	while (pPrt = pPrtNext)
+	// this does the same as fxStdExec, but pass by pass for all particles
+	const int32_t iCount = Count;
+	Keep.assign(iCount, 1);
+	float *px = x.data(), *py = y.data(), *pxdir = xdir.data(), *pydir = ydir.data(), *pa = a.data();
+	int32_t *plife = life.data(), *pb = b.data();
+	uint8_t *pKeep = Keep.data();
+	int32_t i;
+	// rel. position & movement
+	float fTX = 0.0f, fTY = 0.0f, fTXDir = 0.0f, fTYDir = 0.0f;
+	if (pDef->Attach)
 	{
-		// get next now, because destruction could corrupt the list
-		pPrtNext = pPrt->pNext;
-		// execute it
-		if (!pPrt->pDef->ExecProc(pPrt, pObj))
+		fTX = rTarget.x; fTY = rTarget.y;
+		fTXDir = rTarget.xdir; fTYDir = rTarget.ydir;
+	}
+	const C4ParticleLandscape &rLandscape = ParticleSystem.Landscape;
+	const float fGravity = pDef->GravityAcc ? fixtof(rLandscape.GetGravity() * pDef->GravityAcc) / 100.0f : 0.0f;
+	const float fYOff = float(pDef->YOff), fWdt = float(rLandscape.GetWidth()), fHgt = float(rLandscape.GetHeight());
+	// outside landscape range? (checked with position and movement before this frame)
+	if (!pDef->Delay)
+		for (i = 0; i < iCount; ++i)
 		{
-			// sorry, life is over for you :P
-			--pPrt->pDef->Count;
-			pPrt->MoveList(*this, Game.Particles.FreeParticles);
+			float dx = px[i] + fTX, dy = py[i] + fTY;
+			bool kp = (pxdir[i] + fTXDir > 0) ? (dx - pa[i] < fWdt) : (dx + pa[i] > 0);
+			kp = kp && ((pydir[i] + fTYDir > 0) ? (dy - pa[i] < fHgt) : (dy + pa[i] > fYOff));
+			pKeep[i] = kp;
+		}
+	// move and apply gravity
+	if (!pDef->VertexCount && !pDef->WindDrift)
+	{
+		// no landscape involved
+		if (pDef->RByV != 2)
+			for (i = 0; i < iCount; ++i)
+			{
+				px[i] += pxdir[i];
+				py[i] += pydir[i];
+			}
+		if (pDef->GravityAcc)
+			for (i = 0; i < iCount; ++i)
+				pydir[i] += fGravity;
+	}
+	else
+	{
+		const int32_t iWindDrift = (std::max)(pDef->WindDrift - 20, 0);
+		for (i = 0; i < iCount; ++i)
+		{
+			float dx = px[i] + fTX, dy = py[i] + fTY;
+			float dxdir = pxdir[i] + fTXDir, dydir = pydir[i] + fTYDir;
+			// move
+			if (pxdir[i] || pydir[i])
+			{
+				if (pDef->VertexCount && rLandscape.GetSolid(int32_t(dx + pxdir[i]), int32_t(dy + pydir[i] + pDef->VertexY * pa[i] / 100.0f)))
+				{
+					// collision
+					if (pDef->CollisionProc)
+					{
+						C4Particle Prt;
+						Get(i, Prt);
+						bool fAlive = pDef->CollisionProc(&Prt, nullptr);
+						Set(i, Prt);
+						if (!fAlive) { pKeep[i] = 0; continue; }
+					}
+				}
+				else if (pDef->RByV != 2)
+				{
+					px[i] += pxdir[i];
+					py[i] += pydir[i];
+				}
+			}
+			// apply gravity
+			pydir[i] += fGravity;
+			// apply WindDrift
+			if (pDef->WindDrift && !rLandscape.GetSolid(int32_t(dx), int32_t(dy)))
+			{
+				// Air speed: Wind plus some random
+				float txdir = rLandscape.GetWind(int32_t(dx), int32_t(dy)) / 15.0f;
+				float tydir = 0;
+				// Air friction, based on WindDrift.
+				pxdir[i] += ((txdir - dxdir) * iWindDrift) / 800;
+				pydir[i] += ((tydir - dydir) * iWindDrift) / 800;
+			}
+		}
+	}
+	// fade out
+	int32_t iFade = pDef->AlphaFade;
+	if (iFade < 0) if (Game.FrameCounter % -iFade == 0) iFade = 1; else iFade = 0;
+	if (iFade)
+		for (i = 0; i < iCount; ++i)
+		{
+			uint32_t dwClr = pb[i];
+			int32_t iAlpha = (dwClr >> 24) + pDef->AlphaFade;
+			if (iAlpha >= 0xff)
+				pKeep[i] = 0;
+			else
+				pb[i] = (dwClr & 0xffffff) | (iAlpha << 24);
+		}
+	// if delay is given, advance lifetime
+	if (pDef->Delay)
+	{
+		const int32_t iFadeOutEnd = -pDef->FadeOutLen * pDef->FadeOutDelay;
+		const int32_t iLength = pDef->Length - pDef->Reverse;
+		const int32_t iEndPhase = iLength * pDef->Repeats + pDef->Reverse;
+		for (i = 0; i < iCount; ++i)
+		{
+			if (plife[i] < 0)
+			{
+				// decay
+				if (plife[i]-- < iFadeOutEnd) pKeep[i] = 0;
+				continue;
+			}
+			++plife[i];
+			// check if still alive
+			if (plife[i] / pDef->Delay >= iEndPhase)
+			{
+				// do fadeout, if assigned
+				if (!pDef->FadeOutLen) pKeep[i] = 0;
+				else plife[i] = -1;
+			}
 		}
 	}
+}
+
+int32_t C4ParticleBlock::RemoveDead()
+{
+	// backwards, so particles moved into gaps have been checked already
+	int32_t iRemoved = 0;
+	for (int32_t i = Count; i--; )
+		if (!Keep[i])
+		{
+			Remove(i);
+			++iRemoved;
+		}
+	return iRemoved;
+}
+
+void C4ParticleBlock::Draw(C4FacetEx &cgo, C4Object *pObj)
+{
+	C4Particle Prt;
+	for (int32_t i = Count; i--; )
+	{
+		Get(i, Prt);
+		pDef->DrawProc(&Prt, cgo, pObj);
+	}
+}
+
+void C4ParticleBlock::Push(float dxdir, float dydir)
+{
+	for (int32_t i = 0; i < Count; ++i)
+	{
+		xdir[i] += dxdir;
+		ydir[i] += dydir;
+	}
+}
+
+C4ParticleList::~C4ParticleList()
+{
+	// the exec job must not touch the list any more
+	Finish();
+	ParticleSystem.ReleaseList(this);
+}
+
+void C4ParticleList::BeginExec(C4Object *pObj)
+{
+	// remember the object; the workers must not look at it
+	if (pObj)
+	{
+		Target.x = float(pObj->x); Target.y = float(pObj->y);
+		Target.xdir = fixtof(pObj->xdir); Target.ydir = fixtof(pObj->ydir);
+	}
+	else
+		Target = C4ParticleTarget();
+	fExecuting = true;
+}
+
+void C4ParticleList::Exec()
+{
+	// execute all particles
+	for (C4ParticleBlock &rBlock : Blocks)
+		if (rBlock.Count)
+			rBlock.Exec(Target);
 	// done
 }
 
+void C4ParticleList::EndExec()
+{
+	if (!fExecuting) return;
+	fExecuting = false;
+	// account removed particles
+	for (C4ParticleBlock &rBlock : Blocks)
+	{
+		rBlock.pDef->Count -= rBlock.Removed;
+		Count -= rBlock.Removed;
+		rBlock.Removed = 0;
+	}
+	// add particles created meanwhile
+	for (const C4Particle &rPrt : Spawned)
+		Add(rPrt);
+	Spawned.clear();
+}
+
+void C4ParticleList::Finish()
+{
+	if (!fExecuting) return;
+	ParticleSystem.WaitExec();
+	EndExec();
+}
+
 void C4ParticleList::Draw(C4FacetEx &cgo, C4Object *pObj)
 {
+	Finish();
 	// draw all particles
-	for (C4Particle *pPrt = pFirst; pPrt; pPrt = pPrt->pNext)
-		pPrt->pDef->DrawProc(pPrt, cgo, pObj);
+	for (C4ParticleBlock &rBlock : Blocks)
+		rBlock.Draw(cgo, pObj);
 	// done
 }
 
 void C4ParticleList::Clear()
 {
+	Finish();
 	// remove all particles
-	C4Particle *pPrtNext = pFirst, *pPrt;
-	while (pPrt = pPrtNext)
-	{
-		// get next now, because destruction could corrupt the list
-		pPrtNext = pPrt->pNext;
-		// sorry, life is over for you :P
-		--pPrt->pDef->Count;
-		pPrt->MoveList(*this, Game.Particles.FreeParticles);
-	}
+	for (C4ParticleBlock &rBlock : Blocks)
+		rBlock.pDef->Count -= rBlock.Count;
+	Reset();
+}
+
+void C4ParticleList::Reset()
+{
+	Finish();
+	Blocks.clear();
+	Count = 0;
 }
 
 int32_t C4ParticleList::Remove(C4ParticleDef *pOfDef)
 {
+	Finish();
 	int32_t iNumRemoved = 0;
-	// check all particles for def
-	C4Particle *pPrtNext = pFirst, *pPrt;
-	while (pPrt = pPrtNext)
-	{
-		// get next now, because destruction could corrupt the list
-		pPrtNext = pPrt->pNext;
-		// execute it
-		if (!pOfDef || pPrt->pDef == pOfDef)
+	// check all blocks for def
+	for (auto it = Blocks.begin(); it != Blocks.end(); )
+		if (!pOfDef || it->pDef == pOfDef)
 		{
 			// sorry, life is over for you :P
-			--pPrt->pDef->Count;
-			pPrt->MoveList(*this, Game.Particles.FreeParticles);
+			it->pDef->Count -= it->Count;
+			Count -= it->Count;
+			iNumRemoved += it->Count;
+			it = Blocks.erase(it);
 		}
-	}
+		else
+			++it;
 	// done
 	return iNumRemoved;
 }
 
-C4ParticleSystem::C4ParticleSystem()
+int32_t C4ParticleList::Push(C4ParticleDef *pOfDef, float dxdir, float dydir)
+{
+	Finish();
+	int32_t iNumPushed = 0;
+	for (C4ParticleBlock &rBlock : Blocks)
+		if (!pOfDef || rBlock.pDef == pOfDef)
+		{
+			rBlock.Push(dxdir, dydir);
+			iNumPushed += rBlock.Count;
+		}
+	return iNumPushed;
+}
+
+void C4ParticleList::Add(const C4Particle &rPrt)
+{
+	// list in use by the workers? add later
+	if (fExecuting)
+	{
+		Spawned.push_back(rPrt);
+		return;
+	}
+	// add to the block of the def
+	C4ParticleBlock *pBlock = nullptr;
+	for (C4ParticleBlock &rBlock : Blocks)
+		if (rBlock.pDef == rPrt.pDef)
+		{
+			pBlock = &rBlock;
+			break;
+		}
+	if (!pBlock)
+	{
+		Blocks.push_back(C4ParticleBlock(rPrt.pDef));
+		pBlock = &Blocks.back();
+	}
+	pBlock->Add(rPrt);
+	++Count;
+}
+
+void C4ParticleLandscape::Default()
+{
+	Width = Height = 0;
+	pSource = nullptr;
+	UpdateFrame = 0;
+	LeftOpen = RightOpen = TopOpen = BottomOpen = 0;
+	std::fill_n(Pix2Dens, 256, 0);
+	Wind = 0;
+	Gravity = Fix0;
+}
+
+void C4ParticleLandscape::Clear()
+{
+	Pix.clear();
+	Default();
+}
+
+void C4ParticleLandscape::Update()
+{
+	C4Landscape &rLandscape = Game.Landscape;
+	int32_t iPitch;
+	const uint8_t *pBuf = rLandscape.GetPixBuffer(0, 0, rLandscape.Width, rLandscape.Height, iPitch);
+	if (!pBuf) { Clear(); return; }
+	// other landscape? copy everything
+	bool fAll = (pBuf != pSource || Width != rLandscape.Width || Height != rLandscape.Height || Game.FrameCounter < UpdateFrame);
+	if (fAll)
+	{
+		Width = rLandscape.Width; Height = rLandscape.Height;
+		Pix.resize(Width * Height);
+		pSource = pBuf;
+		for (int32_t y = 0; y < Height; ++y)
+			std::copy_n(pBuf + y * iPitch, Width, Pix.data() + y * Width);
+	}
+	else
+	{
+		// copy the pixel blocks changed since the last update
+		for (int32_t bx = 0; bx < (Width + 16) / 17; ++bx)
+			for (int32_t by = 0; by < (Height + 14) / 15; ++by)
+				if (rLandscape.GetBlockChangeFrame(bx, by) >= UpdateFrame)
+				{
+					int32_t iX = bx * 17, iWdt = std::min<int32_t>(17, Width - iX);
+					for (int32_t y = by * 15; y < std::min<int32_t>(by * 15 + 15, Height); ++y)
+						std::copy_n(pBuf + y * iPitch + iX, iWdt, Pix.data() + y * Width + iX);
+				}
+	}
+	UpdateFrame = Game.FrameCounter;
+	// everything else the particles look at
+	LeftOpen = rLandscape.LeftOpen; RightOpen = rLandscape.RightOpen;
+	TopOpen = rLandscape.TopOpen; BottomOpen = rLandscape.BottomOpen;
+	for (int32_t i = 0; i < 256; ++i) Pix2Dens[i] = rLandscape.GetPixDensity(i);
+	Wind = Game.Weather.Wind;
+	Gravity = GravAccel;
+}
+
+uint8_t C4ParticleLandscape::GetPix(int32_t x, int32_t y) const
+{
+	extern uint8_t MCVehic;
+	// Border checks
+	if (x < 0) return (y < LeftOpen) ? 0 : MCVehic;
+	if (x >= Width) return (y < RightOpen) ? 0 : MCVehic;
+	if (y < 0) return TopOpen ? 0 : MCVehic;
+	if (y >= Height) return BottomOpen ? 0 : MCVehic;
+	return Pix[y * Width + x];
+}
+
+bool C4ParticleLandscape::GetSolid(int32_t x, int32_t y) const
+{
+	return DensitySolid(Pix2Dens[GetPix(x, y)]);
+}
+
+int32_t C4ParticleLandscape::GetWind(int32_t x, int32_t y) const
+{
+	return PixColIFT(GetPix(x, y)) ? 0 : Wind;
+}
+
+// worker thread of the particle exec job
+class C4ParticleThread : public StdThread
+{
+public:
+	C4ParticleThread() : StartEvent(false), DoneEvent(false) {}
+	virtual ~C4ParticleThread() { Stop(); }
+
+	CStdEvent StartEvent; // set by the main thread to start the job
+	CStdEvent DoneEvent; // set by the worker when no list is left
+
+	void Stop()
+	{
+		// wake up to notice
+		SignalStop();
+		StartEvent.Set();
+		StdThread::Stop();
+	}
+
+protected:
+	virtual void Execute()
+	{
+		if (!StartEvent.WaitFor(INFINITE)) return;
+		if (IsStopSignaled()) return;
+		ParticleSystem.ExecJob();
+		DoneEvent.Set();
+	}
+};
+
+C4ParticleSystem::C4ParticleSystem() : NextExecList(0)
 {
 	// zero fields
+	JobThreads = 0;
+	fExecuting = false;
 	pDef0 = pDefL = nullptr;
 	pSmoke = nullptr;
 	pBlast = nullptr;
@@ -328,39 +690,109 @@ C4ParticleSystem::~C4ParticleSystem()
 	Clear();
 }
 
-C4ParticleChunk *C4ParticleSystem::AddChunk()
+void C4ParticleSystem::StartThreads(int32_t iCount)
+{
+	StopThreads();
+	while (iCount-- > 0)
+	{
+		C4ParticleThread *pThread = new C4ParticleThread();
+		if (!pThread->Start()) { delete pThread; break; }
+		Threads.push_back(pThread);
+	}
+}
+
+void C4ParticleSystem::StopThreads()
+{
+	for (C4ParticleThread *pThread : Threads)
+		delete pThread;
+	Threads.clear();
+}
+
+void C4ParticleSystem::BeginExec()
+{
+	EndExec();
+	// the workers see the landscape as it is now
+	Landscape.Update();
+	// collect lists
+	if (GlobalParticles)
+	{
+		GlobalParticles.BeginExec(nullptr);
+		ExecLists.push_back(&GlobalParticles);
+	}
+	for (C4ObjectLink *pLnk = Game.Objects.First; pLnk; pLnk = pLnk->Next)
+	{
+		C4Object *pObj = pLnk->Obj;
+		if (!pObj->Status) continue;
+		if (pObj->BackParticles)
+		{
+			pObj->BackParticles.BeginExec(pObj);
+			ExecLists.push_back(&pObj->BackParticles);
+		}
+		if (pObj->FrontParticles)
+		{
+			pObj->FrontParticles.BeginExec(pObj);
+			ExecLists.push_back(&pObj->FrontParticles);
+		}
+	}
+	if (ExecLists.empty()) return;
+	fExecuting = true;
+	NextExecList = 0;
+	// start workers
+	int32_t iThreads = std::max<int32_t>(Config.Graphics.ParticleThreads, 0);
+	if (static_cast<int32_t>(Threads.size()) != iThreads) StartThreads(iThreads);
+	JobThreads = std::min<int32_t>(Threads.size(), ExecLists.size());
+	for (int32_t i = 0; i < JobThreads; ++i)
+		Threads[i]->StartEvent.Set();
+	// no threads? do it right away
+	if (!JobThreads) ExecJob();
+}
+
+void C4ParticleSystem::ExecJob()
+{
+	size_t iList;
+	while ((iList = NextExecList++) < ExecLists.size())
+		ExecLists[iList]->Exec();
+}
+
+void C4ParticleSystem::WaitExec()
 {
-	// add another chunk
-	C4ParticleChunk *pNewChnk = new C4ParticleChunk();
-	pNewChnk->pNext = Chunk.pNext;
-	Chunk.pNext = pNewChnk;
-	// register into free-particle-list
-	if (pNewChnk->Data[C4Px_BufSize - 1].pNext = FreeParticles.pFirst)
-		FreeParticles.pFirst->pPrev = &pNewChnk->Data[C4Px_BufSize - 1];
-	FreeParticles.pFirst = &pNewChnk->Data[0];
-	// return it
-	return pNewChnk;
+	for (int32_t i = 0; i < JobThreads; ++i)
+		Threads[i]->DoneEvent.WaitFor(INFINITE);
+	JobThreads = 0;
+}
+
+void C4ParticleSystem::EndExec()
+{
+	if (!fExecuting) return;
+	WaitExec();
+	fExecuting = false;
+	for (C4ParticleList *pList : ExecLists)
+		if (pList) pList->EndExec();
+	ExecLists.clear();
+}
+
+void C4ParticleSystem::ReleaseList(C4ParticleList *pList)
+{
+	if (!fExecuting) return;
+	std::replace(ExecLists.begin(), ExecLists.end(), pList, static_cast<C4ParticleList *>(nullptr));
 }
 
 void C4ParticleSystem::ClearParticles()
 {
+	EndExec();
 	// clear particle lists
 	C4ObjectLink *pLnk;
 	for (pLnk = Game.Objects.First; pLnk; pLnk = pLnk->Next)
-		pLnk->Obj->FrontParticles.pFirst = pLnk->Obj->BackParticles.pFirst = nullptr;
+	{
+		pLnk->Obj->FrontParticles.Reset();
+		pLnk->Obj->BackParticles.Reset();
+	}
 	for (pLnk = Game.Objects.InactiveObjects.First; pLnk; pLnk = pLnk->Next)
-		pLnk->Obj->FrontParticles.pFirst = pLnk->Obj->BackParticles.pFirst = nullptr;
-	GlobalParticles.pFirst = nullptr;
-	// reset chunks
-	C4ParticleChunk *pNextChnk = Chunk.pNext, *pChnk;
-	while (pChnk = pNextChnk)
-	{
-		pNextChnk = pChnk->pNext;
-		delete pChnk;
-	}
-	Chunk.pNext = nullptr;
-	Chunk.Clear();
-	FreeParticles.pFirst = Chunk.Data;
+	{
+		pLnk->Obj->FrontParticles.Reset();
+		pLnk->Obj->BackParticles.Reset();
+	}
+	GlobalParticles.Reset();
 	// adjust counts
 	for (C4ParticleDef *pDef = pDef0; pDef; pDef = pDef->pNext)
 		pDef->Count = 0;
@@ -368,6 +800,10 @@ void C4ParticleSystem::ClearParticles()
 
 void C4ParticleSystem::Clear()
 {
+	// stop the workers
+	EndExec();
+	StopThreads();
+	Landscape.Clear();
 	// clear particles first
 	ClearParticles();
 	// clear defs
@@ -377,47 +813,45 @@ void C4ParticleSystem::Clear()
 	// done
 }
 
-C4Particle *C4ParticleSystem::Create(C4ParticleDef *pOfDef,
+bool C4ParticleSystem::Create(C4ParticleDef *pOfDef,
 	float x, float y,
 	float xdir, float ydir,
 	float a, int32_t b, C4ParticleList *pPxList,
 	C4Object *pObj)
 {
 	// safety
-	if (!pOfDef) return nullptr;
+	if (!pOfDef) return false;
 	// default to global list
 	if (!pPxList) pPxList = &GlobalParticles;
 	// check count
 	int32_t MaxCount = pOfDef->MaxCount * (Config.Graphics.SmokeLevel + 20) / 150;
 	int32_t iRoom = MaxCount - pOfDef->Count;
-	if (iRoom <= 0) return nullptr;
+	if (iRoom <= 0) return false;
 	// reduce creation if limit is nearly reached
 	if (iRoom < (MaxCount >> 1))
-		if (SafeRandom(iRoom) < SafeRandom(MaxCount)) return nullptr;
-	// get free particle
-	if (!FreeParticles.pFirst) AddChunk();
-	C4Particle *pPrt = FreeParticles.pFirst;
-	if (!pPrt) return nullptr;
+		if (SafeRandom(iRoom) < SafeRandom(MaxCount)) return false;
 	// set values
-	pPrt->x = x; pPrt->y = y;
-	pPrt->xdir = xdir; pPrt->ydir = ydir;
-	pPrt->a = a; pPrt->b = b;
-	pPrt->pDef = pOfDef;
-	if (pPrt->pDef->Attach && pObj != nullptr)
+	C4Particle Prt;
+	Prt.x = x; Prt.y = y;
+	Prt.xdir = xdir; Prt.ydir = ydir;
+	Prt.a = a; Prt.b = b;
+	Prt.life = 0;
+	Prt.pDef = pOfDef;
+	if (Prt.pDef->Attach && pObj != nullptr)
 	{
-		pPrt->x -= pObj->x;
-		pPrt->y -= pObj->y;
+		Prt.x -= pObj->x;
+		Prt.y -= pObj->y;
 	}
 	// call initialization
-	if (!pOfDef->InitProc(pPrt, pObj))
+	if (!pOfDef->InitProc(&Prt, pObj))
 		// failed :(
-		return nullptr;
+		return false;
 	// count particle
 	++pOfDef->Count;
-	// more to desired list
-	pPrt->MoveList(Game.Particles.FreeParticles, *pPxList);
-	// return newly created particle
-	return pPrt;
+	// add to desired list
+	pPxList->Add(Prt);
+	// success
+	return true;
 }
 
 bool C4ParticleSystem::Cast(C4ParticleDef *pOfDef, int32_t iAmount,
@@ -496,26 +930,19 @@ void C4ParticleSystem::SetDefParticles()
 int32_t C4ParticleSystem::Push(C4ParticleDef *pOfDef, float dxdir, float dydir)
 {
 	int32_t iNumPushed = 0;
-	// go through all particle chunks
-	for (C4ParticleChunk *pChnk = &Chunk; pChnk; pChnk = pChnk->pNext)
+	// go through all particle lists
+	C4ObjectLink *pLnk;
+	for (pLnk = Game.Objects.First; pLnk; pLnk = pLnk->Next)
 	{
-		// go through all particles
-		C4Particle *pPrt = pChnk->Data; int32_t i = C4Px_BufSize;
-		while (i--)
-		{
-			// def fits?
-			if (!pOfDef || pPrt->pDef == pOfDef)
-			{
-				// push it!
-				pPrt->xdir += dxdir;
-				pPrt->ydir += dydir;
-				// count pushed
-				++iNumPushed;
-			}
-			// next particle
-			++pPrt;
-		}
+		iNumPushed += pLnk->Obj->FrontParticles.Push(pOfDef, dxdir, dydir);
+		iNumPushed += pLnk->Obj->BackParticles.Push(pOfDef, dxdir, dydir);
+	}
+	for (pLnk = Game.Objects.InactiveObjects.First; pLnk; pLnk = pLnk->Next)
+	{
+		iNumPushed += pLnk->Obj->FrontParticles.Push(pOfDef, dxdir, dydir);
+		iNumPushed += pLnk->Obj->BackParticles.Push(pOfDef, dxdir, dydir);
 	}
+	iNumPushed += GlobalParticles.Push(pOfDef, dxdir, dydir);
 	// done
 	return iNumPushed;
 }
@@ -558,15 +985,15 @@ bool fxSmokeExec(C4Particle *pPrt, C4Object *pTarget)
 	// wind to float
 	if (!(pPrt->b % 12) || fBuilding)
 	{
-		pPrt->xdir = 0.025f * Game.Weather.GetWind(int32_t(pPrt->x), int32_t(pPrt->y));
+		pPrt->xdir = 0.025f * ParticleSystem.Landscape.GetWind(int32_t(pPrt->x), int32_t(pPrt->y));
 		if (pPrt->xdir < -2.0f) pPrt->xdir = -2.0f; else if (pPrt->xdir > 2.0f) pPrt->xdir = 2.0f;
 		pPrt->xdir += 0.1f * SafeRandom(41) - 2.0f;
 	}
 	// float
-	if (GBackSolid(int32_t(pPrt->x), int32_t(pPrt->y - pPrt->a)))
+	if (ParticleSystem.Landscape.GetSolid(int32_t(pPrt->x), int32_t(pPrt->y - pPrt->a)))
 	{
 		// if stuck, decay; otherwise, move down
-		if (!GBackSolid(int32_t(pPrt->x), int32_t(pPrt->y))) pPrt->y += 0.4f; else pPrt->a -= 2;
+		if (!ParticleSystem.Landscape.GetSolid(int32_t(pPrt->x), int32_t(pPrt->y))) pPrt->y += 0.4f; else pPrt->a -= 2;
 	}
 	else
 		--pPrt->y;
@@ -629,7 +1056,7 @@ bool fxStdExec(C4Particle *pPrt, C4Object *pTarget)
 	// move
 	if (pPrt->xdir || pPrt->ydir)
 	{
-		if (pPrt->pDef->VertexCount && GBackSolid(int32_t(dx + pPrt->xdir), int32_t(dy + pPrt->ydir + pPrt->pDef->VertexY * pPrt->a / 100.0f)))
+		if (pPrt->pDef->VertexCount && ParticleSystem.Landscape.GetSolid(int32_t(dx + pPrt->xdir), int32_t(dy + pPrt->ydir + pPrt->pDef->VertexY * pPrt->a / 100.0f)))
 		{
 			// collision
 			if (pPrt->pDef->CollisionProc)
@@ -646,12 +1073,12 @@ bool fxStdExec(C4Particle *pPrt, C4Object *pTarget)
 		}
 	}
 	// apply gravity
-	if (pPrt->pDef->GravityAcc) pPrt->ydir += fixtof(GravAccel * pPrt->pDef->GravityAcc) / 100.0f;
+	if (pPrt->pDef->GravityAcc) pPrt->ydir += fixtof(ParticleSystem.Landscape.GetGravity() * pPrt->pDef->GravityAcc) / 100.0f;
 	// apply WindDrift
-	if (pPrt->pDef->WindDrift && !GBackSolid(int32_t(dx), int32_t(dy)))
+	if (pPrt->pDef->WindDrift && !ParticleSystem.Landscape.GetSolid(int32_t(dx), int32_t(dy)))
 	{
 		// Air speed: Wind plus some random
-		int32_t iWind = GBackWind(int32_t(dx), int32_t(dy));
+		int32_t iWind = ParticleSystem.Landscape.GetWind(int32_t(dx), int32_t(dy));
 		float txdir = iWind / 15.0f;
 		float tydir = 0;
 
@@ -693,8 +1120,8 @@ bool fxStdExec(C4Particle *pPrt, C4Object *pTarget)
 	}
 	// outside landscape range?
 	bool kp;
-	if (dxdir > 0) kp =       (dx - pPrt->a < GBackWdt); else kp =       (dx + pPrt->a > 0);
-	if (dydir > 0) kp = kp && (dy - pPrt->a < GBackHgt); else kp = kp && (dy + pPrt->a > pPrt->pDef->YOff);
+	if (dxdir > 0) kp =       (dx - pPrt->a < ParticleSystem.Landscape.GetWidth()); else kp =       (dx + pPrt->a > 0);
+	if (dydir > 0) kp = kp && (dy - pPrt->a < ParticleSystem.Landscape.GetHeight()); else kp = kp && (dy + pPrt->a > pPrt->pDef->YOff);
 	return kp;
 }
 
@@ -32,18 +32,23 @@
 #include <C4Group.h>
 #include <C4Shape.h>
 
+#include <atomic>
+#include <vector>
+
 // class predefs
 class C4ParticleDefCore;
 class C4ParticleDef;
 class C4Particle;
-class C4ParticleChunk;
+class C4ParticleBlock;
 class C4ParticleList;
+class C4ParticleLandscape;
 class C4ParticleSystem;
+class C4ParticleThread;
 
 typedef bool(*C4ParticleProc)(C4Particle *, C4Object *); // generic particle proc
 typedef C4ParticleProc C4ParticleInitProc; // particle init proc - init and return whether particle could be created
-typedef C4ParticleProc C4ParticleExecProc; // particle execution proc - returns whether particle died
-typedef C4ParticleProc C4ParticleCollisionProc; // particle collision proc - returns whether particle died
+typedef C4ParticleProc C4ParticleExecProc; // particle execution proc - returns whether particle died; runs on a worker thread without object
+typedef C4ParticleProc C4ParticleCollisionProc; // particle collision proc - returns whether particle died; runs on a worker thread without object
 typedef void(*C4ParticleDrawProc)(C4Particle *, C4FacetEx &, C4Object *); // particle drawing code
 
 #define ParticleSystem Game.Particles
@@ -112,74 +117,141 @@ public:
 };
 
 // one tiny little particle
-// note: list management done by the chunk, which spares one ptr here
-// the chunk initializes the values to zero here, too; so no ctors here...
+// note: particles are stored in the arrays of a C4ParticleBlock; the procs get
+//  a copy of one particle, which is written back afterwards
 class C4Particle
 {
-protected:
-	C4Particle *pPrev, *pNext; // previous/next particle of the same list in the buffer
-
-	void MoveList(C4ParticleList &rFrom, C4ParticleList &rTo); // move from one list to another
-
 public:
 	C4ParticleDef *pDef; // kind of particle
 	float x, y, xdir, ydir; // position and movement
 	int32_t life; // lifetime remaining for this particle
 	float a; int32_t b; // all-purpose values
+};
 
-	friend class C4ParticleChunk;
-	friend class C4ParticleList;
-	friend class C4ParticleSystem;
+// position and movement of the object a list is attached to, taken when the exec job starts
+struct C4ParticleTarget
+{
+	float x, y, xdir, ydir;
 };
 
-// one chunk of particles
-// linked list is managed by owner
-class C4ParticleChunk
+// all particles of one kind within a list
+// stored as one array per member, so the standard procs can run over them
+// in tight loops
+class C4ParticleBlock
 {
+public:
+	C4ParticleDef *pDef; // kind of particles
+	int32_t Count; // number of particles
+	int32_t Removed; // particles removed by the exec job, not yet subtracted from the def count
+	std::vector<float> x, y, xdir, ydir, a;
+	std::vector<int32_t> life, b;
+
 protected:
-	C4ParticleChunk *pNext; // single linked list
-	C4Particle Data[C4Px_BufSize]; // the particles
+	std::vector<uint8_t> Keep; // exec: whether the particle survives this frame
 
 public:
-	C4ParticleChunk();
-	~C4ParticleChunk();
+	C4ParticleBlock(C4ParticleDef *pOfDef) : pDef(pOfDef), Count(0), Removed(0) {}
+
+	void Get(int32_t i, C4Particle &rPrt) const; // copy particle out for the procs
+	void Set(int32_t i, const C4Particle &rPrt); // write it back
+	void Add(const C4Particle &rPrt);
+	void Remove(int32_t i); // the last particle takes its place
 
-	void Clear(); // clear all particles
+	void Exec(const C4ParticleTarget &rTarget); // execute all particles
+	void Draw(C4FacetEx &cgo, C4Object *pObj);
+	void Push(float dxdir, float dydir);
 
-	friend class C4ParticleSystem;
+protected:
+	void ExecStd(const C4ParticleTarget &rTarget); // fxStdExec for all particles
+	int32_t RemoveDead(); // remove all particles not kept
 };
 
 // a subset of particles
+// lists are executed by the exec job of the particle system; while a list is
+//  part of the job, new particles are kept aside and all other changes wait
+//  for the job to finish
 class C4ParticleList
 {
-public:
-	C4Particle *pFirst; // first particle in list - others follow in linked list
+protected:
+	std::vector<C4ParticleBlock> Blocks; // one per kind of particle in this list
+	std::vector<C4Particle> Spawned; // particles created while the list is executed
+	int32_t Count; // number of particles in all blocks
+	bool fExecuting; // list is part of the running exec job
+	C4ParticleTarget Target; // owning object at the start of the job
 
-	C4ParticleList() { pFirst = nullptr; }
+public:
+	C4ParticleList() : Count(0), fExecuting(false), Target() {}
+	~C4ParticleList();
 
-	void Exec(C4Object *pObj = nullptr); // execute all particles
+	void BeginExec(C4Object *pObj); // main thread: add list to the exec job
+	void Exec(); // worker thread: execute all particles
+	void EndExec(); // main thread: account removed particles and add spawned ones
 	void Draw(C4FacetEx &cgo, C4Object *pObj = nullptr); // draw all particles
 	void Clear(); // remove all particles
+	void Reset(); // drop all particles without adjusting the def counts
 	int32_t Remove(C4ParticleDef *pOfDef); // remove all particles of def
+	int32_t Push(C4ParticleDef *pOfDef, float dxdir, float dydir); // add movement to all particles of def
+	void Add(const C4Particle &rPrt); // add one particle
+
+	operator bool() { return Count > 0 || !Spawned.empty(); } // checks whether list contains particles
 
-	operator bool() { return !!pFirst; } // checks whether list contains particles
+protected:
+	void Finish(); // wait for the exec job if it contains this list
+};
+
+// copy of the landscape pixels for the particle simulation
+// updated by the main thread before each exec job, so the workers never read
+//  pixels that are being changed
+class C4ParticleLandscape
+{
+protected:
+	std::vector<uint8_t> Pix;
+	int32_t Width, Height;
+	const uint8_t *pSource; // landscape pixels the copy was made of
+	int32_t UpdateFrame; // frame of the last update
+	int32_t LeftOpen, RightOpen, TopOpen, BottomOpen;
+	int32_t Pix2Dens[256];
+	int32_t Wind;
+	FIXED Gravity;
+
+public:
+	C4ParticleLandscape() { Default(); }
+
+	void Default();
+	void Clear();
+	void Update(); // copy all pixel blocks changed since the last update
+	void Invalidate() { pSource = nullptr; } // copy everything in the next update
+
+	uint8_t GetPix(int32_t x, int32_t y) const; // bounds checked like C4Landscape::GetPix
+	bool GetSolid(int32_t x, int32_t y) const; // like GBackSolid
+	int32_t GetWind(int32_t x, int32_t y) const; // like GBackWind
+	FIXED GetGravity() const { return Gravity; }
+	int32_t GetWidth() const { return Width; }
+	int32_t GetHeight() const { return Height; }
 };
 
 // the main particle system
 class C4ParticleSystem
 {
 protected:
-	C4ParticleChunk Chunk; // linked list for particle chunks
 	C4ParticleDef *pDef0, *pDefL; // linked list for particle defs
 
-	C4ParticleChunk *AddChunk(); // add a new chunk to the list
+	// exec job: all lists are executed on the worker threads while the objects are executed
+	std::vector<C4ParticleThread *> Threads;
+	std::vector<C4ParticleList *> ExecLists; // lists in the current job
+	std::atomic<size_t> NextExecList; // next list to be taken by a worker
+	int32_t JobThreads; // workers running the current job; 0 if none
+	bool fExecuting; // job started and not yet ended
 
 	C4ParticleProc GetProc(const char *szName); // get init/exec proc for a particle type
 	C4ParticleDrawProc GetDrawProc(const char *szName); // get draw proc for a particle type
 
+	void StartThreads(int32_t iCount);
+	void StopThreads();
+
 public:
-	C4ParticleList FreeParticles; // list of free particles
-	C4ParticleList GlobalParticles; // list of free particles
+	C4ParticleList GlobalParticles; // list of particles not attached to any object
+	C4ParticleLandscape Landscape; // landscape as seen by the exec job
 
 	C4ParticleDef *pSmoke;  // default particle: smoke
 	C4ParticleDef *pBlast;  // default particle: blast
@@ -193,7 +265,13 @@ public:
 	void ClearParticles(); // remove all particles
 	void Clear(); // remove all particle definitions and particles
 
-	C4Particle *Create(C4ParticleDef *pOfDef, // create one particle of given type
+	void BeginExec(); // start executing all particle lists of this frame
+	void EndExec(); // wait for the exec job and apply its results
+	void WaitExec(); // wait for the exec job only
+	void ExecJob(); // run by the workers: execute lists until none is left
+	void ReleaseList(C4ParticleList *pList); // list is destroyed during the job
+
+	bool Create(C4ParticleDef *pOfDef, // create one particle of given type
 		float x, float y, float xdir = 0.0f, float ydir = 0.0f,
 		float a = 0.0f, int32_t b = 0, C4ParticleList *pPxList = nullptr, C4Object *pObj = nullptr);
 	bool Cast(C4ParticleDef *pOfDef, // create several particles with different speeds and params
@@ -210,8 +288,6 @@ public:
 	bool IsFireParticleLoaded() { return pFire1 && pFire2; }
 
 	friend class C4ParticleDef;
-	friend class C4Particle;
-	friend class C4ParticleChunk;
 };
 
 // default particle execution/drawing functions
@@ -47,11 +47,13 @@
 #ifndef BIG_C4INCLUDE
 #include <C4FacetEx.h>
 #include <C4Game.h>
+#include <C4Wrappers.h>
 #endif
 
 const int32_t C4PF_MaxDepth  = 35,
               C4PF_MaxCrawl  = 800,
               C4PF_MaxRay    = 350,
+              C4PF_MaxLevel  = 10,
               C4PF_Threshold = 10,
 
               C4PF_Direction_Left  = -1,
@@ -70,7 +72,10 @@ const int32_t C4PF_MaxDepth  = 35,
               C4PF_Crawl_Bottom   = 3,
               C4PF_Crawl_Left     = 4,
 
-              C4PF_Draw_Rate = 10;
+              C4PF_Draw_Rate = 10,
+
+              C4PF_MaxCacheSize = 256,
+              C4PF_FrameBudget  = 50000; // ray steps per frame before further searches are deferred
 
 // C4PathFinderRay
 
@@ -111,6 +116,7 @@ bool C4PathFinderRay::Execute()
 		{
 			// Mark zone used
 			UseZone->Used = true;
+			pPathFinder->AddSearchZone(UseZone);
 			// Target in transfer zone: success
 			if (UseZone->At(TargetX, TargetY))
 			{
@@ -154,6 +160,7 @@ bool C4PathFinderRay::Execute()
 		// Path intersected by transfer zone
 		else if (pZone)
 		{
+			pPathFinder->AddSearchZone(pZone);
 			// Zone entry point adjust (if not already in zone)
 			if (!pZone->At(X, Y))
 				pZone->GetEntryPoint(X2, Y2, X2, Y2);
@@ -392,17 +399,20 @@ void C4PathFinderRay::SetCompletePath()
 	{
 		// Transfer waypoint
 		if (pRay->UseZone)
-			pPathFinder->SetWaypoint(pRay->X2, pRay->Y2, (intptr_t)pRay->UseZone->Object,
-				pPathFinder->WaypointParameter);
+			pPathFinder->AddWaypoint(pRay->X2, pRay->Y2, (intptr_t)pRay->UseZone->Object);
 		// MoveTo waypoint
 		else
-			pPathFinder->SetWaypoint(pRay->From->X2, pRay->From->Y2, 0,
-				pPathFinder->WaypointParameter);
+			pPathFinder->AddWaypoint(pRay->From->X2, pRay->From->Y2, 0);
 	}
 }
 
 bool C4PathFinderRay::PointFree(int32_t iX, int32_t iY)
 {
+	// Remember the area looked at for the path cache
+	if (iX < pPathFinder->SearchX1) pPathFinder->SearchX1 = iX;
+	if (iX > pPathFinder->SearchX2) pPathFinder->SearchX2 = iX;
+	if (iY < pPathFinder->SearchY1) pPathFinder->SearchY1 = iY;
+	if (iY > pPathFinder->SearchY2) pPathFinder->SearchY2 = iY;
 	return pPathFinder->PointFree(iX, iY);
 }
 
@@ -534,6 +544,11 @@ void C4PathFinder::Default()
 	TransferZones = nullptr;
 	TransferZonesEnabled = true;
 	Level = 1;
+	NavGridEnabled = false;
+	Cache.clear();
+	SearchPath.clear();
+	SearchX1 = SearchY1 = SearchX2 = SearchY2 = 0;
+	BudgetFrame = -1; BudgetSteps = 0;
 }
 
 void C4PathFinder::Clear()
@@ -548,6 +563,7 @@ void C4PathFinder::Init(bool(*fnPointFree)(int32_t, int32_t), C4TransferZones *p
 	// Set data
 	PointFree = fnPointFree;
 	TransferZones = pTransferZones;
+	NavGrid.Init(fnPointFree, pTransferZones);
 }
 
 void C4PathFinder::EnableTransferZones(bool fEnabled)
@@ -555,9 +571,14 @@ void C4PathFinder::EnableTransferZones(bool fEnabled)
 	TransferZonesEnabled = fEnabled;
 }
 
+void C4PathFinder::EnableNavGrid(bool fEnabled)
+{
+	NavGridEnabled = fEnabled;
+}
+
 void C4PathFinder::SetLevel(int iLevel)
 {
-	Level = BoundBy(iLevel, 1, 10);
+	Level = BoundBy<int>(iLevel, 1, C4PF_MaxLevel);
 }
 
 void C4PathFinder::Draw(C4FacetEx &cgo)
@@ -582,6 +603,7 @@ bool C4PathFinder::Execute()
 	for (C4PathFinderRay *pRay = FirstRay; pRay && !Success; pRay = pRay->Next, iRays++)
 		if (pRay->Execute())
 			fContinue = true;
+	BudgetSteps += iRays;
 
 	// Max ray limit
 	if (iRays >= C4PF_MaxRay) return false;
@@ -600,7 +622,7 @@ bool C4PathFinder::Execute()
 	return fContinue;
 }
 
-bool C4PathFinder::Find(int32_t iFromX, int32_t iFromY, int32_t iToX, int32_t iToY, bool(*fnSetWaypoint)(int32_t, int32_t, intptr_t, intptr_t), intptr_t iWaypointParameter)
+bool C4PathFinder::Find(int32_t iFromX, int32_t iFromY, int32_t iToX, int32_t iToY, bool(*fnSetWaypoint)(int32_t, int32_t, intptr_t, intptr_t), intptr_t iWaypointParameter, bool *pfDeferred)
 {
 	// Prepare
 	Clear();
@@ -613,17 +635,142 @@ bool C4PathFinder::Find(int32_t iFromX, int32_t iFromY, int32_t iToX, int32_t iT
 	// Start & target coordinates must be free
 	if (!PointFree(iFromX, iFromY) || !PointFree(iToX, iToY)) return false;
 
-	// Add the first two rays
-	if (!AddRay(iFromX, iFromY, iToX, iToY, 0, C4PF_Direction_Left, nullptr)) return false;
-	if (!AddRay(iFromX, iFromY, iToX, iToY, 0, C4PF_Direction_Right, nullptr)) return false;
+	// Frame budget used up: caller may retry later
+	// Checked before the cache, so searches are deferred the same way whether their result is known or not
+	if (IsBudgetExhausted() && pfDeferred)
+	{
+		*pfDeferred = true;
+		return false;
+	}
+
+	// Known path?
+	CacheKey Key(iFromX, iFromY, iToX, iToY, Level, TransferZonesEnabled, NavGridEnabled);
+	if (FindCached(Key)) return Success;
+
+	SearchPath.clear();
+	SearchX1 = SearchX2 = iFromX; SearchY1 = SearchY2 = iFromY;
+	int32_t iBudgetSteps = BudgetSteps;
+
+	// Navigation grid; cells too solid for it and ways it does not know are left to the rays
+	if (!FindNavGrid(iFromX, iFromY, iToX, iToY))
+	{
+		// Add the first two rays
+		if (!AddRay(iFromX, iFromY, iToX, iToY, 0, C4PF_Direction_Left, nullptr)) return false;
+		if (!AddRay(iFromX, iFromY, iToX, iToY, 0, C4PF_Direction_Right, nullptr)) return false;
+
+		// Run
+		Run();
+	}
 
-	// Run
-	Run();
+	// Remember result
+	StoreCached(Key, BudgetSteps - iBudgetSteps);
 
 	// Success
+	if (Success) SetPath(SearchPath);
 	return Success;
 }
 
+void C4PathFinder::AddWaypoint(int32_t iX, int32_t iY, intptr_t iZone)
+{
+	Waypoint Point = { iX, iY, iZone };
+	SearchPath.push_back(Point);
+}
+
+bool C4PathFinder::AddNavGridWaypoint(int32_t iX, int32_t iY, intptr_t iZone, intptr_t ipPathFinder)
+{
+	((C4PathFinder *)ipPathFinder)->AddWaypoint(iX, iY, iZone);
+	return true;
+}
+
+bool C4PathFinder::FindNavGrid(int32_t iFromX, int32_t iFromY, int32_t iToX, int32_t iToY)
+{
+	if (!NavGridEnabled) return false;
+	bool fUsable = NavGrid.CanFind(iFromX, iFromY, iToX, iToY, TransferZonesEnabled);
+	if (fUsable)
+		Success = NavGrid.Find(iFromX, iFromY, iToX, iToY, &AddNavGridWaypoint, (intptr_t)this);
+	// Remember what the grid looked at, also if the rays take over
+	const C4Rect &rcArea = NavGrid.GetSearchArea();
+	if (rcArea.Wdt && rcArea.Hgt)
+	{
+		SearchX1 = std::min<int32_t>(SearchX1, rcArea.x); SearchX2 = std::max<int32_t>(SearchX2, rcArea.x + rcArea.Wdt - 1);
+		SearchY1 = std::min<int32_t>(SearchY1, rcArea.y); SearchY2 = std::max<int32_t>(SearchY2, rcArea.y + rcArea.Hgt - 1);
+	}
+	BudgetSteps += NavGrid.GetSearchSteps();
+	return fUsable && Success;
+}
+
+void C4PathFinder::AddSearchZone(C4TransferZone *pZone)
+{
+	// Entry points are searched around the zone and dropped vertically
+	SearchX1 = std::min<int32_t>(SearchX1, pZone->X - 1);
+	SearchX2 = std::max<int32_t>(SearchX2, pZone->X + pZone->Wdt);
+	SearchY1 = 0;
+	SearchY2 = std::max<int32_t>(SearchY2, GBackHgt - 1);
+}
+
+void C4PathFinder::SetPath(const std::vector<Waypoint> &Path)
+{
+	for (const Waypoint &Point : Path)
+		SetWaypoint(Point.X, Point.Y, Point.Zone, WaypointParameter);
+}
+
+bool C4PathFinder::IsBudgetExhausted()
+{
+	// New frame: new budget
+	if (BudgetFrame != Game.FrameCounter)
+	{
+		BudgetFrame = Game.FrameCounter;
+		BudgetSteps = 0;
+	}
+	return BudgetSteps >= C4PF_FrameBudget;
+}
+
+bool C4PathFinder::FindCached(const CacheKey &Key)
+{
+	auto it = Cache.find(Key);
+	if (it == Cache.end()) return false;
+	const CacheEntry &Entry = it->second;
+	// Outdated: transfer zones or landscape changed
+	if ((TransferZonesEnabled && TransferZones && Entry.ZoneVersion != TransferZones->Version)
+		|| Game.Landscape.IsChangedSince(Entry.Area, Entry.Frame))
+	{
+		Cache.erase(it);
+		return false;
+	}
+	// Use cached path; the budget is used as if it was searched again
+	BudgetSteps += Entry.Steps;
+	Success = Entry.Success;
+	if (Success) SetPath(Entry.Waypoints);
+	return true;
+}
+
+void C4PathFinder::StoreCached(const CacheKey &Key, int32_t iSteps)
+{
+	// Cache full: drop oldest path
+	if (Cache.size() >= C4PF_MaxCacheSize && !Cache.count(Key))
+	{
+		auto itOldest = Cache.begin();
+		for (auto it = Cache.begin(); it != Cache.end(); ++it)
+			if (it->second.Frame < itOldest->second.Frame)
+				itOldest = it;
+		Cache.erase(itOldest);
+	}
+	CacheEntry &Entry = Cache[Key];
+	Entry.Success = Success;
+	Entry.Waypoints = SearchPath;
+	Entry.Area = C4Rect(SearchX1, SearchY1, SearchX2 - SearchX1 + 1, SearchY2 - SearchY1 + 1);
+	Entry.Frame = Game.FrameCounter;
+	Entry.ZoneVersion = TransferZones ? TransferZones->Version : 0;
+	Entry.Steps = iSteps;
+}
+
+void C4PathFinder::ClearCache()
+{
+	Cache.clear();
+	NavGrid.Invalidate();
+	BudgetFrame = -1; BudgetSteps = 0;
+}
+
 bool C4PathFinder::AddRay(int32_t iFromX, int32_t iFromY, int32_t iToX, int32_t iToY, int32_t iDepth, int32_t iDirection, C4PathFinderRay *pFrom, C4TransferZone *pUseZone)
 {
 	// Max depth
@@ -19,6 +19,12 @@
 #pragma once
 
 #include <C4TransferZone.h>
+#include <C4NavGrid.h>
+#include <C4Shape.h>
+
+#include <map>
+#include <tuple>
+#include <vector>
 
 class C4PathFinderRay
 {
@@ -78,18 +84,63 @@ protected:
 	C4TransferZones *TransferZones;
 	bool TransferZonesEnabled;
 	int Level;
+	bool NavGridEnabled; // search the navigation grid before casting rays
+	C4NavGrid NavGrid;
+
+	// Path cache: results of previous searches between the same points, reused until the
+	// landscape they looked at or the transfer zones change. A reused result is the one the
+	// search would find again, and it is charged to the frame budget like that search, so
+	// clients with different cache contents stay in sync.
+	struct Waypoint
+	{
+		int32_t X, Y;
+		intptr_t Zone; // transfer zone object, if any
+	};
+
+	struct CacheEntry
+	{
+		bool Success;
+		std::vector<Waypoint> Waypoints; // in SetWaypoint order: target first
+		C4Rect Area; // all landscape the search looked at
+		int32_t Frame;
+		uint32_t ZoneVersion;
+		int32_t Steps; // budget used by the search
+	};
+
+	// start, target, level, transfer zones enabled, navigation grid enabled
+	typedef std::tuple<int32_t, int32_t, int32_t, int32_t, int, bool, bool> CacheKey;
+	std::map<CacheKey, CacheEntry> Cache;
+
+	// current search
+	std::vector<Waypoint> SearchPath;
+	int32_t SearchX1, SearchY1, SearchX2, SearchY2; // bounds of all points looked at
+
+	// ray steps executed in BudgetFrame
+	int32_t BudgetFrame, BudgetSteps;
 
 public:
 	void Draw(C4FacetEx &cgo);
 	void Clear();
 	void Default();
 	void Init(bool(*fnPointFree)(int32_t, int32_t), C4TransferZones *pTransferZones = nullptr);
-	bool Find(int32_t iFromX, int32_t iFromY, int32_t iToX, int32_t iToY, bool(*fnSetWaypoint)(int32_t, int32_t, intptr_t, intptr_t), intptr_t iWaypointParameter);
+	// pfDeferred: if given, a search that would exceed the frame budget is not started;
+	// *pfDeferred is set instead and the caller should retry in the next frame
+	bool Find(int32_t iFromX, int32_t iFromY, int32_t iToX, int32_t iToY, bool(*fnSetWaypoint)(int32_t, int32_t, intptr_t, intptr_t), intptr_t iWaypointParameter, bool *pfDeferred = nullptr);
 	void EnableTransferZones(bool fEnabled);
+	void EnableNavGrid(bool fEnabled);
 	void SetLevel(int iLevel);
+	void ClearCache(); // drop all cached paths - must happen synchronized on all clients
 
 protected:
 	void Run();
+	void AddWaypoint(int32_t iX, int32_t iY, intptr_t iZone);
+	static bool AddNavGridWaypoint(int32_t iX, int32_t iY, intptr_t iZone, intptr_t ipPathFinder);
+	bool FindNavGrid(int32_t iFromX, int32_t iFromY, int32_t iToX, int32_t iToY);
+	void AddSearchZone(C4TransferZone *pZone);
+	bool IsBudgetExhausted();
+	bool FindCached(const CacheKey &Key);
+	void StoreCached(const CacheKey &Key, int32_t iSteps);
+	void SetPath(const std::vector<Waypoint> &Path);
 	bool AddRay(int32_t iFromX, int32_t iFromY, int32_t iToX, int32_t iToY, int32_t iDepth, int32_t iDirection, C4PathFinderRay *pFrom, C4TransferZone *pUseZone = nullptr);
 	bool SplitRay(C4PathFinderRay *pRay, int32_t iAtX, int32_t iAtY);
 	bool Execute();
@@ -337,7 +337,7 @@ bool C4Player::Init(int32_t iNumber, int32_t iAtClient, const char *szAtClientNa
 			C4Def *pDefCallback;
 			if (idCallback && (pDefCallback = C4Id2Def(idCallback)))
 			{
-				pDefCallback->Script.Call(PSF_InitializeScriptPlayer, &C4AulParSet(C4VInt(Number),
+				pDefCallback->Script.Call(PSFId_InitializeScriptPlayer, &C4AulParSet(C4VInt(Number),
 					C4VInt(Team)));
 			}
 		}
@@ -530,7 +530,7 @@ void C4Player::PlaceReadyCrew(int32_t tx1, int32_t tx2, int32_t ty, C4Object *Fi
 				C4DebugRecOff DBGRECOFF;
 #endif
 				C4AulParSet parset(C4VInt(Number));
-				nobj->Call(PSF_OnJoinCrew, &parset);
+				nobj->Call(PSFId_OnJoinCrew, &parset);
 			}
 		}
 	}
@@ -572,7 +572,7 @@ void C4Player::PlaceReadyCrew(int32_t tx1, int32_t tx2, int32_t ty, C4Object *Fi
 						C4DebugRecOff DbgRecOff;
 #endif
 						C4AulParSet parset(C4VInt(Number));
-						nobj->Call(PSF_OnJoinCrew, &parset);
+						nobj->Call(PSFId_OnJoinCrew, &parset);
 					}
 				}
 			}
@@ -870,7 +870,7 @@ C4Object *C4Player::Buy(C4ID id, bool fShowErrors, int32_t iForPlr, C4Object *pB
 		Game.Players.Get(iForPlr)->MakeCrewMember(pThing);
 	// success
 	C4AulParSet parset(C4VInt(Number), C4VObj(pBuyObj));
-	pThing->Call(PSF_Purchase, &parset);
+	pThing->Call(PSFId_Purchase, &parset);
 	if (!pThing->Status) return nullptr;
 	return pThing;
 }
@@ -907,7 +907,7 @@ bool C4Player::Sell2Home(C4Object *pObj)
 	}
 	// Remove object, eject any crew members
 	if (pObj->Contained) pObj->Exit();
-	pObj->Call(PSF_Sale, &C4AulParSet(C4VInt(Number)));
+	pObj->Call(PSFId_Sale, &C4AulParSet(C4VInt(Number)));
 	pObj->AssignRemoval(true);
 	// Done
 	return true;
@@ -1210,7 +1210,7 @@ bool C4Player::MakeCrewMember(C4Object *pObj, bool fForceInfo, bool fDoCalls)
 	if (fDoCalls)
 	{
 		C4AulParSet parset(C4VInt(Number));
-		pObj->Call(PSF_OnJoinCrew, &parset);
+		pObj->Call(PSFId_OnJoinCrew, &parset);
 	}
 
 	return true;
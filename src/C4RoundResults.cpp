@@ -296,10 +296,10 @@ void C4RoundResults::EvaluateGoals(C4IDList &GoalList, C4IDList &FulfilledGoalLi
 			if (fRivalvry)
 			{
 				C4AulParSet pars(C4VInt(iPlayerNumber));
-				fFulfilled = !!pObj->Call(PSF_IsFulfilledforPlr, &pars);
+				fFulfilled = !!pObj->Call(PSFId_IsFulfilledforPlr, &pars);
 			}
 			else
-				fFulfilled = !!pObj->Call(PSF_IsFulfilled);
+				fFulfilled = !!pObj->Call(PSFId_IsFulfilled);
 		}
 		GoalList.SetIDCount(idGoal, cnt, true);
 		if (fFulfilled) FulfilledGoalList.SetIDCount(idGoal, 1, true);
@@ -221,6 +221,7 @@ void C4SGame::Default()
 	Goals.Clear();
 	Rules.Clear();
 	FoWColor = 0;
+	ObjectSleep = C4S_ObjectSleepOn;
 }
 
 void C4SGame::CompileFunc(StdCompiler *pComp, bool fSection)
@@ -259,6 +260,7 @@ void C4SGame::CompileFunc(StdCompiler *pComp, bool fSection)
 	pComp->Value(mkNamingAdapt(Goals,    "Goals",    C4IDList()));
 	pComp->Value(mkNamingAdapt(Rules,    "Rules",    C4IDList()));
 	pComp->Value(mkNamingAdapt(FoWColor, "FoWColor", 0u));
+	pComp->Value(mkNamingAdapt(ObjectSleep, "ObjectSleep", C4S_ObjectSleepOn));
 }
 
 void C4SPlrStart::Default()
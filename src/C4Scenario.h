@@ -147,6 +147,8 @@ public:
 
 	uint32_t FoWColor; // color of FoW; may contain transparency
 
+	int32_t ObjectSleep; // whether objects at rest are executed; see C4S_ObjectSleep*
+
 	C4SRealism Realism;
 
 public:
@@ -165,6 +167,12 @@ const int32_t C4S_Cooperative   = 0,
               C4S_Melee         = 1,
               C4S_MeleeTeamwork = 2;
 
+// Object sleep
+
+const int32_t C4S_ObjectSleepOff   = 0, // execute all objects every frame
+              C4S_ObjectSleepOn    = 1, // objects at rest are not executed until they change
+              C4S_ObjectSleepCheck = 2; // execute objects at rest anyway and log any change sleeping would have missed
+
 // Player elimination
 
 const int32_t C4S_KillTheCaptain = 0,
@@ -1955,8 +1955,8 @@ static bool FnFindConstructionSite(C4AulContext *cthr, C4ID id, long iVarX, long
 	if (!Inside<long>(iVarX, 0, C4AUL_MAX_Par - 1) || !Inside<long>(iVarY, 0, C4AUL_MAX_Par - 1)) return false;
 	// Get thread vars
 	if (!cthr->Caller) return false;
-	C4Value &V1 = cthr->Caller->NumVars[iVarX];
-	C4Value &V2 = cthr->Caller->NumVars[iVarY];
+	C4Value &V1 = cthr->Caller->GetNumVars()[iVarX];
+	C4Value &V2 = cthr->Caller->GetNumVars()[iVarY];
 	// Construction check at starting position
 	if (ConstructionCheck(id, V1.getInt(), V2.getInt()))
 		return true;
@@ -2033,11 +2033,16 @@ static C4Value FnObjectCount2(C4AulContext *cthr, C4Value *pPars)
 	if (!pFO)
 		throw new C4AulExecError(cthr->Obj, "ObjectCount: No valid search criterions supplied!");
 	// Search
-	int32_t iCnt = pFO->Count(Game.Objects, Game.Objects.Sectors);
+	C4Value Result;
+	if (!Game.Objects.FindCache.Lookup('c', pPars, pFO, Result))
+	{
+		Result = C4VInt(pFO->Count(Game.Objects, Game.Objects.Sectors));
+		Game.Objects.FindCache.Store(Result);
+	}
 	// Free
 	delete pFO;
 	// Return
-	return C4VInt(iCnt);
+	return Result;
 }
 
 static C4Value FnFindObject2(C4AulContext *cthr, C4Value *pPars)
@@ -2050,11 +2055,16 @@ static C4Value FnFindObject2(C4AulContext *cthr, C4Value *pPars)
 	if (!pFO)
 		throw new C4AulExecError(cthr->Obj, "FindObject: No valid search criterions supplied!");
 	// Search
-	C4Object *pObj = pFO->Find(Game.Objects, Game.Objects.Sectors);
+	C4Value Result;
+	if (!Game.Objects.FindCache.Lookup('f', pPars, pFO, Result))
+	{
+		Result = C4VObj(pFO->Find(Game.Objects, Game.Objects.Sectors));
+		Game.Objects.FindCache.Store(Result);
+	}
 	// Free
 	delete pFO;
 	// Return
-	return C4VObj(pObj);
+	return Result;
 }
 
 static C4Value FnFindObjects(C4AulContext *cthr, C4Value *pPars)
@@ -2067,11 +2077,16 @@ static C4Value FnFindObjects(C4AulContext *cthr, C4Value *pPars)
 	if (!pFO)
 		throw new C4AulExecError(cthr->Obj, "FindObjects: No valid search criterions supplied!");
 	// Search
-	C4ValueArray *pResult = pFO->FindMany(Game.Objects, Game.Objects.Sectors);
+	C4Value Result;
+	if (!Game.Objects.FindCache.Lookup('m', pPars, pFO, Result))
+	{
+		Result = C4VArray(pFO->FindMany(Game.Objects, Game.Objects.Sectors));
+		Game.Objects.FindCache.Store(Result);
+	}
 	// Free
 	delete pFO;
 	// Return
-	return C4VArray(pResult);
+	return Result;
 }
 
 static C4Value FnObjectCount(C4AulContext *cthr, C4Value *pPars)
@@ -3445,27 +3460,27 @@ static long FnAsyncRandom(C4AulContext *cthr, long iRange)
 static C4Value FnSetVar_C4V(C4AulContext *cthr, C4Value *iVarIndex, C4Value *iValue)
 {
 	if (!cthr->Caller) return C4VNull;
-	cthr->Caller->NumVars[iVarIndex->getInt()] = *iValue;
+	cthr->Caller->GetNumVars()[iVarIndex->getInt()] = *iValue;
 	return *iValue;
 }
 
 static C4Value FnIncVar_C4V(C4AulContext *cthr, C4Value *iVarIndex)
 {
 	if (!cthr->Caller) return C4VNull;
-	return ++cthr->Caller->NumVars[iVarIndex->getInt()];
+	return ++cthr->Caller->GetNumVars()[iVarIndex->getInt()];
 }
 
 static C4Value FnDecVar_C4V(C4AulContext *cthr, C4Value *iVarIndex)
 {
 	if (!cthr->Caller) return C4VNull;
-	return --cthr->Caller->NumVars[iVarIndex->getInt()];
+	return --cthr->Caller->GetNumVars()[iVarIndex->getInt()];
 }
 
 static C4Value FnVar_C4V(C4AulContext *cthr, C4Value *iVarIndex)
 {
 	if (!cthr->Caller) return C4VNull;
 	// Referenz zurückgeben
-	return cthr->Caller->NumVars[iVarIndex->getInt()].GetRef();
+	return cthr->Caller->GetNumVars()[iVarIndex->getInt()].GetRef();
 }
 
 static C4Value FnSetGlobal_C4V(C4AulContext *cthr, C4Value *iVarIndex, C4Value *iValue)
@@ -5301,6 +5316,8 @@ static long FnGetPathLength(C4AulContext *ctx, long iFromX, long iFromY, long iT
 	PathInfo.ilx = iFromX;
 	PathInfo.ily = iFromY;
 	PathInfo.ilen = 0;
+	// Rays, regardless of what the last MoveTo command used
+	Game.PathFinder.EnableNavGrid(false);
 	if (!Game.PathFinder.Find(iFromX, iFromY, iToX, iToY, &SumPathLength, (long)&PathInfo))
 		return 0;
 	return PathInfo.ilen + Distance(PathInfo.ilx, PathInfo.ily, iToX, iToY);
@@ -5363,8 +5380,8 @@ static bool FnFightWith(C4AulContext *ctx, C4Object *pTarget, C4Object *pClonk)
 	// RejectFight callback
 	C4AulParSet parset1(C4VObj(pTarget));
 	C4AulParSet parset2(C4VObj(pClonk));
-	if (pTarget->Call(PSF_RejectFight, &parset1).getBool()) return false;
-	if (pClonk->Call(PSF_RejectFight, &parset2).getBool()) return false;
+	if (pTarget->Call(PSFId_RejectFight, &parset1).getBool()) return false;
+	if (pClonk->Call(PSFId_RejectFight, &parset2).getBool()) return false;
 	// begin fighting
 	ObjectActionFight(pClonk, pTarget);
 	ObjectActionFight(pTarget, pClonk);
@@ -5410,6 +5427,7 @@ static bool FnSetObjectLayer(C4AulContext *ctx, C4Object *pNewLayer, C4Object *p
 	if (!pObj) if (!(pObj = ctx->Obj)) return false;
 	// set layer object
 	pObj->pLayer = pNewLayer;
+	Game.Objects.FindCache.Invalidate(C4FOD_Objects);
 	// set for all contents as well
 	for (C4ObjectLink *pLnk = pObj->Contents.First; pLnk; pLnk = pLnk->Next)
 		if ((pObj = pLnk->Obj) && pObj->Status)
@@ -5734,7 +5752,7 @@ static C4Value FnGetEffect_C4V(C4AulContext *ctx, C4Value *pvsEffectName, C4Valu
 	case 3: return C4VInt(pEffect->iIntervall);     // 3: timer intervall
 	case 4: return C4VObj(pEffect->pCommandTarget); // 4: command target
 	case 5: return C4VID(pEffect->idCommandTarget); // 5: command target ID
-	case 6: return C4VInt(pEffect->iTime);          // 6: effect time
+	case 6: return C4VInt(pEffect->GetTime(pTarget)); // 6: effect time
 	}
 	// invalid data queried
 	return C4Value();
@@ -5757,7 +5775,7 @@ static bool FnRemoveEffect(C4AulContext *ctx, C4String *psEffectName, C4Object *
 	if (!pEffect) return 0;
 	// kill it
 	if (fDoNoCalls)
-		pEffect->SetDead();
+		pEffect->SetDead(pTarget);
 	else
 		pEffect->Kill(pTarget);
 	// done, success
@@ -5788,7 +5806,7 @@ static bool FnChangeEffect(C4AulContext *ctx, C4String *psEffectName, C4Object *
 	if (iNewTimer >= 0)
 	{
 		pEffect->iIntervall = iNewTimer;
-		pEffect->iTime = 0;
+		pEffect->SetTime(pTarget, 0);
 	}
 	// done, success
 	return true;
@@ -6260,6 +6278,18 @@ static bool FnStopScriptProfiler(C4AulContext *ctx)
 	return true;
 }
 
+static bool FnSetFindObjectCache(C4AulContext *ctx, bool fEnable)
+{
+	C4FindObjectCache &Cache = Game.Objects.FindCache;
+	if (fEnable == Cache.Enabled) return false;
+	// show statistics of the last period the cache was enabled
+	if (!fEnable) Cache.ShowStats();
+	Cache.Clear();
+	Cache.ResetStats();
+	Cache.Enabled = fEnable;
+	return true;
+}
+
 static bool FnCustomMessage(C4AulContext *ctx, C4String *pMsg, C4Object *pObj, long iOwner, long iOffX, long iOffY, long dwClr, C4ID idDeco, C4String *sPortrait, long dwFlags, long iHSize)
 {
 	// safeties
@@ -6838,6 +6868,7 @@ void InitFunctionMap(C4AulScriptEngine *pEngine)
 	AddFunc(pEngine, "StartCallTrace",                  FnStartCallTrace);
 	AddFunc(pEngine, "StartScriptProfiler",             FnStartScriptProfiler);
 	AddFunc(pEngine, "StopScriptProfiler",              FnStopScriptProfiler);
+	AddFunc(pEngine, "SetFindObjectCache",              FnSetFindObjectCache);
 	AddFunc(pEngine, "CustomMessage",                   FnCustomMessage);
 	AddFunc(pEngine, "PauseGame",                       FnPauseGame);
 	AddFunc(pEngine, "ExecuteCommand",                  FnExecuteCommand);
@@ -6851,6 +6882,70 @@ void InitFunctionMap(C4AulScriptEngine *pEngine)
 	new C4AulDefCastFunc(pEngine, "CastAny",       C4V_Any,  C4V_Any);
 }
 
+const char *const C4PSFNames[] =
+{
+	PSF_Initialize,
+	PSF_InitializeDef,
+	PSF_Construction,
+	PSF_Destruction,
+	PSF_ContentsDestruction,
+	PSF_InitializeScriptPlayer,
+	PSF_Hit,
+	PSF_Hit2,
+	PSF_Hit3,
+	PSF_Grab,
+	PSF_Grabbed,
+	PSF_Get,
+	PSF_Put,
+	PSF_Collection,
+	PSF_Collection2,
+	PSF_Ejection,
+	PSF_Entrance,
+	PSF_Departure,
+	PSF_Completion,
+	PSF_Purchase,
+	PSF_Sale,
+	PSF_Damage,
+	PSF_Incineration,
+	PSF_IncinerationEx,
+	PSF_Death,
+	PSF_ActivateEntrance,
+	PSF_Activate,
+	PSF_LiftTop,
+	PSF_ControlUpdate,
+	PSF_ContainedControlUpdate,
+	PSF_ControlCommand,
+	PSF_ControlCommandFinished,
+	PSF_DeepBreath,
+	PSF_CatchBlow,
+	PSF_QueryCatchBlow,
+	PSF_Stuck,
+	PSF_RejectCollection,
+	PSF_RejectContents,
+	PSF_GrabLost,
+	PSF_LineBreak,
+	PSF_BuildNeedsMaterial,
+	PSF_UpdateTransferZone,
+	PSF_MenuQueryCancel,
+	PSF_IsFulfilled,
+	PSF_IsFulfilledforPlr,
+	PSF_RejectEntrance,
+	PSF_RejectFight,
+	PSF_AttachTargetLost,
+	PSF_CrewSelection,
+	PSF_MenuSelection,
+	PSF_OnActionJump,
+	PSF_MouseSelection,
+	PSF_OnOwnerChanged,
+	PSF_OnJoinCrew,
+	PSF_FireMode,
+	PSF_GetFairCrewPhysical,
+	PSF_ControlCommandAcquire,
+	PSF_ControlCommandConstruction,
+};
+
+static_assert(sizeof(C4PSFNames) / sizeof(*C4PSFNames) == PSFId_Count, "C4PSFNames must list every C4PSFId");
+
 C4ScriptConstDef C4ScriptConstMap[] =
 {
 	{ "C4D_All",         C4V_Int, C4D_All },
@@ -148,3 +148,71 @@ void InitFunctionMap(C4AulScriptEngine *pEngine); // add functions to engine
 // an additional callback for Construct.
 #define PSF_ControlCommandAcquire      "~ControlCommandAcquire" // C4Object *pTarget (unused), int iRangeX, int iRangeY, C4Object *pExcludeContainer, C4ID idAcquireDef
 #define PSF_ControlCommandConstruction "~ControlCommandConstruction" // C4Object *pTarget (unused), int iRangeX, int iRangeY, C4Object *pTarget2 (unused), C4ID idConstructDef
+
+// engine callbacks that are looked up once per definition in C4DefScriptHost::AfterLink,
+// so calling them by id needs no name lookup
+enum C4PSFId
+{
+	PSFId_Initialize,
+	PSFId_InitializeDef,
+	PSFId_Construction,
+	PSFId_Destruction,
+	PSFId_ContentsDestruction,
+	PSFId_InitializeScriptPlayer,
+	PSFId_Hit,
+	PSFId_Hit2,
+	PSFId_Hit3,
+	PSFId_Grab,
+	PSFId_Grabbed,
+	PSFId_Get,
+	PSFId_Put,
+	PSFId_Collection,
+	PSFId_Collection2,
+	PSFId_Ejection,
+	PSFId_Entrance,
+	PSFId_Departure,
+	PSFId_Completion,
+	PSFId_Purchase,
+	PSFId_Sale,
+	PSFId_Damage,
+	PSFId_Incineration,
+	PSFId_IncinerationEx,
+	PSFId_Death,
+	PSFId_ActivateEntrance,
+	PSFId_Activate,
+	PSFId_LiftTop,
+	PSFId_ControlUpdate,
+	PSFId_ContainedControlUpdate,
+	PSFId_ControlCommand,
+	PSFId_ControlCommandFinished,
+	PSFId_DeepBreath,
+	PSFId_CatchBlow,
+	PSFId_QueryCatchBlow,
+	PSFId_Stuck,
+	PSFId_RejectCollection,
+	PSFId_RejectContents,
+	PSFId_GrabLost,
+	PSFId_LineBreak,
+	PSFId_BuildNeedsMaterial,
+	PSFId_UpdateTransferZone,
+	PSFId_MenuQueryCancel,
+	PSFId_IsFulfilled,
+	PSFId_IsFulfilledforPlr,
+	PSFId_RejectEntrance,
+	PSFId_RejectFight,
+	PSFId_AttachTargetLost,
+	PSFId_CrewSelection,
+	PSFId_MenuSelection,
+	PSFId_OnActionJump,
+	PSFId_MouseSelection,
+	PSFId_OnOwnerChanged,
+	PSFId_OnJoinCrew,
+	PSFId_FireMode,
+	PSFId_GetFairCrewPhysical,
+	PSFId_ControlCommandAcquire,
+	PSFId_ControlCommandConstruction,
+
+	PSFId_Count
+};
+
+extern const char *const C4PSFNames[PSFId_Count]; // PSF_* name of each callback id
@@ -191,6 +191,7 @@ void C4DefScriptHost::Default()
 {
 	C4ScriptHost::Default();
 	SFn_CalcValue = SFn_SellTo = SFn_ControlTransfer = SFn_CustomComponents = nullptr;
+	std::fill_n(Callbacks, PSFId_Count, nullptr);
 	ControlMethod[0] = ControlMethod[1] = ContainedControlMethod[0] = ContainedControlMethod[1] = ActivationControlMethod[0] = ActivationControlMethod[1] = 0;
 }
 
@@ -203,6 +204,8 @@ void C4DefScriptHost::AfterLink()
 	SFn_SellTo           = GetSFunc(PSF_SellTo,              AA_PROTECTED);
 	SFn_ControlTransfer  = GetSFunc(PSF_ControlTransfer,     AA_PROTECTED);
 	SFn_CustomComponents = GetSFunc(PSF_GetCustomComponents, AA_PROTECTED);
+	for (int32_t i = 0; i < PSFId_Count; ++i)
+		Callbacks[i] = GetSFunc(C4PSFNames[i]);
 	if (Def)
 	{
 		C4AulAccess CallAccess = AA_PRIVATE;
@@ -222,6 +225,30 @@ void C4DefScriptHost::AfterLink()
 	GetControlMethodMask(PSF_Activate,         ActivationControlMethod[0], ActivationControlMethod[1]);
 }
 
+C4Value C4DefScriptHost::ObjectCall(C4Object *pCaller, C4Object *pObj, C4PSFId eCallback, C4AulParSet *pPars, bool fPassError)
+{
+#ifdef C4ENGINE
+
+	// function looked up in AfterLink
+	C4AulScriptFunc *pFn = Callbacks[eCallback];
+	if (!pFn) return C4VNull;
+	// check access like FunctionCall does
+	if (pObj && (pObj != pCaller))
+		if (pFn->Access < (pCaller ? AA_PUBLIC : AA_PROTECTED))
+		{
+			C4AulParseError err(this, "insufficient access level");
+			err.show();
+		}
+	// Call code
+	return pFn->Exec(pObj, pPars, fPassError);
+
+#else
+
+	return 0;
+
+#endif
+}
+
 // C4GameScriptHost
 
 C4GameScriptHost::C4GameScriptHost() : Counter(0), Go(false) {}
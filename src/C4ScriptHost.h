@@ -22,6 +22,7 @@
 
 #ifndef BIG_C4INCLUDE
 #include <C4Aul.h>
+#include <C4Script.h>
 #endif
 
 // generic script host for objects
@@ -71,6 +72,14 @@ public:
 
 	bool Delete() { return false; } // do NOT delete this - it's just a class member!
 
+	using C4ScriptHost::ObjectCall;
+	using C4ScriptHost::Call;
+	C4Value ObjectCall(C4Object *pCaller, C4Object *pObj, C4PSFId eCallback, C4AulParSet *pPars = nullptr, bool fPassError = false);
+	C4Value Call(C4PSFId eCallback, C4AulParSet *pPars = nullptr, bool fPassError = false)
+	{
+		return ObjectCall(nullptr, nullptr, eCallback, pPars, fPassError);
+	}
+
 protected:
 	void AfterLink(); // get common funcs
 
@@ -79,6 +88,7 @@ public:
 	C4AulScriptFunc *SFn_SellTo; // player par(0) sold the object
 	C4AulScriptFunc *SFn_ControlTransfer; // object par(0) tries to get to par(1)/par(2)
 	C4AulScriptFunc *SFn_CustomComponents; // PSF_GetCustomComponents
+	C4AulScriptFunc *Callbacks[PSFId_Count]; // engine callbacks by id
 	int32_t ControlMethod[2], ContainedControlMethod[2], ActivationControlMethod[2];
 };
 
@@ -551,6 +551,47 @@ bool C4Shape::ContactCheck(int32_t cx, int32_t cy)
 	ContactCNAT = CNAT_None;
 	ContactCount = 0;
 
+	// Area covered by all colliding vertices and their neighbours
+	int32_t iMinX = INT32_MAX, iMinY = INT32_MAX, iMaxX = INT32_MIN, iMaxY = INT32_MIN;
+	for (int32_t cvtx = 0; cvtx < VtxNum; cvtx++)
+		if (!(VtxCNAT[cvtx] & CNAT_NoCollision))
+		{
+			iMinX = std::min(iMinX, VtxX[cvtx]); iMaxX = std::max(iMaxX, VtxX[cvtx]);
+			iMinY = std::min(iMinY, VtxY[cvtx]); iMaxY = std::max(iMaxY, VtxY[cvtx]);
+		}
+	if (iMinX > iMaxX) return false;
+
+	// Fast path: area inside the landscape, so no lookup needs border handling
+	int32_t iPitch;
+	const uint8_t *pBits = Game.Landscape.GetPixBuffer(cx + iMinX - 1, cy + iMinY - 1, iMaxX - iMinX + 3, iMaxY - iMinY + 3, iPitch);
+	if (pBits)
+	{
+		for (int32_t cvtx = 0; cvtx < VtxNum; cvtx++)
+			if (!(VtxCNAT[cvtx] & CNAT_NoCollision))
+			{
+				const uint8_t *pPix = pBits + (cy + VtxY[cvtx]) * iPitch + cx + VtxX[cvtx];
+				VtxContactCNAT[cvtx] = CNAT_None;
+				VtxContactMat[cvtx] = Game.Landscape.GetPixMat(*pPix);
+
+				if (Game.Landscape.GetPixDensity(*pPix) >= ContactDensity)
+				{
+					ContactCNAT |= VtxCNAT[cvtx];
+					VtxContactCNAT[cvtx] |= CNAT_Center;
+					ContactCount++;
+					// Vertex center contact, now check top,bottom,left,right
+					if (Game.Landscape.GetPixDensity(pPix[-iPitch]) >= ContactDensity)
+						VtxContactCNAT[cvtx] |= CNAT_Top;
+					if (Game.Landscape.GetPixDensity(pPix[iPitch]) >= ContactDensity)
+						VtxContactCNAT[cvtx] |= CNAT_Bottom;
+					if (Game.Landscape.GetPixDensity(pPix[-1]) >= ContactDensity)
+						VtxContactCNAT[cvtx] |= CNAT_Left;
+					if (Game.Landscape.GetPixDensity(pPix[1]) >= ContactDensity)
+						VtxContactCNAT[cvtx] |= CNAT_Right;
+				}
+			}
+		return ContactCount;
+	}
+
 	for (int32_t cvtx = 0; cvtx < VtxNum; cvtx++)
 
 		// Ignore vertex if collision has been flagged out
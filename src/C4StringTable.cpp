@@ -81,6 +81,12 @@ void C4String::Reg(C4StringTable *pnTable)
 	pnTable->Last = this;
 
 	pTable = pnTable;
+
+	// index
+	Hash = C4StringTable::HashContent(Data.getData());
+	Serial = pTable->NextSerial++;
+	pTable->ContentIndex.Add(this, Hash);
+	pTable->PointerIndex.Add(this, C4StringTable::HashPointer(this));
 }
 
 void C4String::UnReg()
@@ -96,6 +102,10 @@ void C4String::UnReg()
 	else
 		pTable->First = Next;
 
+	pTable->ContentIndex.Remove(this, Hash);
+	pTable->PointerIndex.Remove(this, C4StringTable::HashPointer(this));
+	if (iEnumID >= 0) pTable->EnumIndexValid = false;
+
 	pTable = nullptr;
 
 	// delete hold flag if table is lost and check for delete
@@ -104,10 +114,104 @@ void C4String::UnReg()
 		delete this;
 }
 
+// free list of the string pool
+static void *FreeStrings = nullptr;
+const int C4StringPoolBlockSize = 256;
+
+void *C4String::operator new(size_t iSize)
+{
+	assert(iSize == sizeof(C4String));
+	if (!FreeStrings)
+	{
+		// blocks are never freed, but reused for new strings
+		const size_t iEntrySize = (std::max)(sizeof(C4String), sizeof(void *));
+		char *pBlock = static_cast<char *>(::operator new(iEntrySize * C4StringPoolBlockSize));
+		for (int i = 0; i < C4StringPoolBlockSize; i++)
+		{
+			void *pEntry = pBlock + i * iEntrySize;
+			*static_cast<void **>(pEntry) = FreeStrings;
+			FreeStrings = pEntry;
+		}
+	}
+	void *pMem = FreeStrings;
+	FreeStrings = *static_cast<void **>(pMem);
+	return pMem;
+}
+
+void C4String::operator delete(void *pMem)
+{
+	if (!pMem) return;
+	*static_cast<void **>(pMem) = FreeStrings;
+	FreeStrings = pMem;
+}
+
+// *** C4StringIndex
+
+C4StringIndex::C4StringIndex()
+	: Slots(nullptr), Capacity(0), Count(0), Used(0) {}
+
+C4StringIndex::~C4StringIndex()
+{
+	delete[] Slots;
+}
+
+void C4StringIndex::Clear()
+{
+	delete[] Slots; Slots = nullptr;
+	Capacity = Count = Used = 0;
+}
+
+void C4StringIndex::Add(C4String *pString, uint32_t iHash)
+{
+	// keep at most 3/4 of the slots in use, so that lookups find free slots soon
+	if (4 * (Used + 1) > 3 * Capacity)
+		Resize(2 * Count + 2 > Capacity / 2 ? (std::max)(2 * Capacity, 64u) : Capacity);
+	uint32_t i = iHash & (Capacity - 1);
+	while (Slots[i].String) i = (i + 1) & (Capacity - 1);
+	if (!Slots[i].Deleted) ++Used;
+	Slots[i].String = pString;
+	Slots[i].Hash = iHash;
+	Slots[i].Deleted = false;
+	++Count;
+}
+
+void C4StringIndex::Remove(C4String *pString, uint32_t iHash)
+{
+	uint32_t i = iHash & (Capacity - 1);
+	while (Slots[i].String != pString)
+	{
+		// crash on remove of a not contained string
+		assert(Slots[i].String || Slots[i].Deleted);
+		i = (i + 1) & (Capacity - 1);
+	}
+	Slots[i].String = nullptr;
+	Slots[i].Deleted = true;
+	--Count;
+}
+
+void C4StringIndex::Resize(uint32_t iNewCapacity)
+{
+	// rehash everything, which gets rid of deleted slots as well
+	Slot *pOldSlots = Slots;
+	uint32_t iOldCapacity = Capacity;
+	Slots = new Slot[iNewCapacity];
+	Capacity = iNewCapacity;
+	Count = Used = 0;
+	for (uint32_t i = 0; i < Capacity; i++)
+	{
+		Slots[i].String = nullptr;
+		Slots[i].Deleted = false;
+	}
+	for (uint32_t i = 0; i < iOldCapacity; i++)
+		if (pOldSlots[i].String)
+			Add(pOldSlots[i].String, pOldSlots[i].Hash);
+	delete[] pOldSlots;
+}
+
 // *** C4StringTable
 
 C4StringTable::C4StringTable()
-	: First(nullptr), Last(nullptr) {}
+	: First(nullptr), Last(nullptr), EnumIndexValid(false), NextSerial(0) {}
 
 C4StringTable::~C4StringTable()
 {
@@ -133,31 +237,80 @@ void C4StringTable::Clear()
 	} while (bContinue);
 }
 
-int C4StringTable::EnumStrings()
+uint32_t C4StringTable::HashContent(const char *szString)
 {
-	int iCurrID = 0;
+	// Fowler/Noll/Vo hash
+	uint32_t h = 2166136261u;
+	while (*szString)
+		h = (h ^ static_cast<unsigned char>(*(szString++))) * 16777619u;
+	return h;
+}
+
+uint32_t C4StringTable::HashPointer(const C4String *pString)
+{
+	// the lower bits are the same for all strings because of the alignment
+	uintptr_t iPtr = reinterpret_cast<uintptr_t>(pString);
+	return static_cast<uint32_t>((iPtr >> 4) ^ (iPtr >> 20)) * 2654435761u;
+}
+
+template <typename Fn> void C4StringTable::ForEachSaveString(Fn fnCallback)
+{
+	// Calls fnCallback(pString, pSaveString) for all strings in list order. pSaveString is
+	// what FindSaveString returns (the first string of the same content that is not
+	// only held), or nullptr if pString itself is only held and won't be saved.
+	C4StringIndex SaveStrings;
 	for (C4String *pAct = First; pAct; pAct = pAct->Next)
 	{
-		if (!pAct->Hold || pAct->iRefCnt)
+		if (pAct->Hold && !pAct->iRefCnt)
 		{
-			C4String *same;
-			if ((same = FindSaveString(pAct)) == pAct)
-			{
-				pAct->iEnumID = iCurrID++;
-			}
-			else
-			{
-				pAct->iEnumID = same->iEnumID;
-			}
+			fnCallback(pAct, static_cast<C4String *>(nullptr));
+			continue;
 		}
-		else
+		C4String *pSaveString = nullptr;
+		SaveStrings.ForEach(pAct->Hash, [&](C4String *pString)
 		{
-			pAct->iEnumID = -1;
+			if (!pSaveString && SEqual(pString->Data.getData(), pAct->Data.getData()))
+				pSaveString = pString;
+		});
+		if (!pSaveString)
+		{
+			SaveStrings.Add(pAct, pAct->Hash);
+			pSaveString = pAct;
 		}
+		fnCallback(pAct, pSaveString);
 	}
+}
+
+int C4StringTable::EnumStrings()
+{
+	int iCurrID = 0;
+	ForEachSaveString([&](C4String *pAct, C4String *pSaveString)
+	{
+		if (!pSaveString)
+			pAct->iEnumID = -1;
+		else if (pSaveString == pAct)
+			pAct->iEnumID = iCurrID++;
+		else
+			pAct->iEnumID = pSaveString->iEnumID;
+	});
+	EnumIndexValid = false;
 	return iCurrID;
 }
 
+void C4StringTable::BuildEnumIndex()
+{
+	EnumIndex.clear();
+	for (C4String *pAct = First; pAct; pAct = pAct->Next)
+		if (pAct->iEnumID >= 0)
+		{
+			if (static_cast<size_t>(pAct->iEnumID) >= EnumIndex.size())
+				EnumIndex.resize(pAct->iEnumID + 1, nullptr);
+			if (!EnumIndex[pAct->iEnumID])
+				EnumIndex[pAct->iEnumID] = pAct;
+		}
+	EnumIndexValid = true;
+}
+
 C4String *C4StringTable::RegString(const char *strString)
 {
 	return new C4String(strString, this);
@@ -165,39 +318,50 @@ C4String *C4StringTable::RegString(const char *strString)
 
 C4String *C4StringTable::FindString(const char *strString)
 {
-	for (C4String *pAct = First; pAct; pAct = pAct->Next)
-		if (SEqual(pAct->Data.getData(), strString))
-			return pAct;
-	return nullptr;
+	// the first one in the list
+	C4String *pFound = nullptr;
+	ContentIndex.ForEach(HashContent(strString), [&](C4String *pAct)
+	{
+		if ((!pFound || pAct->Serial < pFound->Serial) && SEqual(pAct->Data.getData(), strString))
+			pFound = pAct;
+	});
+	return pFound;
 }
 
 C4String *C4StringTable::FindString(C4String *pString)
 {
-	for (C4String *pAct = First; pAct; pAct = pAct->Next)
-		if (pAct == pString)
-			return pAct;
-	return nullptr;
+	// pString might be anything, so don't touch it
+	C4String *pFound = nullptr;
+	PointerIndex.ForEach(HashPointer(pString), [&](C4String *pAct)
+	{
+		if (pAct == pString) pFound = pAct;
+	});
+	return pFound;
 }
 
 C4String *C4StringTable::FindString(int iEnumID)
 {
-	for (C4String *pAct = First; pAct; pAct = pAct->Next)
-		if (pAct->iEnumID == iEnumID)
-			return pAct;
-	return nullptr;
+	if (iEnumID < 0)
+	{
+		for (C4String *pAct = First; pAct; pAct = pAct->Next)
+			if (pAct->iEnumID == iEnumID)
+				return pAct;
+		return nullptr;
+	}
+	if (!EnumIndexValid) BuildEnumIndex();
+	return static_cast<size_t>(iEnumID) < EnumIndex.size() ? EnumIndex[iEnumID] : nullptr;
 }
 
 C4String *C4StringTable::FindSaveString(C4String *pString)
 {
-	for (C4String *pAct = First; pAct; pAct = pAct->Next)
+	// the first one in the list
+	C4String *pFound = nullptr;
+	ContentIndex.ForEach(pString->Hash, [&](C4String *pAct)
 	{
-		if (SEqual(pAct->Data.getData(), pString->Data.getData()) && (!pAct->Hold || pAct->iRefCnt))
-		{
-			return pAct;
-		}
-	}
-
-	return nullptr;
+		if ((!pFound || pAct->Serial < pFound->Serial) && (!pAct->Hold || pAct->iRefCnt) && SEqual(pAct->Data.getData(), pString->Data.getData()))
+			pFound = pAct;
+	});
+	return pFound;
 }
 
 bool C4StringTable::Load(C4Group &ParentGroup)
@@ -217,6 +381,7 @@ bool C4StringTable::Load(C4Group &ParentGroup)
 			pnString = RegString(strBuf);
 		pnString->iEnumID = i;
 	}
+	EnumIndexValid = false;
 	// delete data
 	delete[] pData;
 	return true;
@@ -227,39 +392,38 @@ bool C4StringTable::Save(C4Group &ParentGroup)
 	// no tbl entries?
 	if (!First) return true;
 
+	// collect strings to save
+	std::vector<C4String *> SaveStrings;
+	ForEachSaveString([&](C4String *pAct, C4String *pSaveString)
+	{
+		if (pAct->iEnumID > -1 && pSaveString == pAct)
+			SaveStrings.push_back(pAct);
+	});
+
 	// calc needed space for string table
 	int iTableSize = 1;
-	C4String *pAct;
-	for (pAct = First; pAct; pAct = pAct->Next)
-	{
-		if (pAct->iEnumID > -1 && FindSaveString(pAct) == pAct)
-		{
-			iTableSize += SLen(pAct->Data.getData()) + 2;
-		}
-	}
+	for (C4String *pAct : SaveStrings)
+		iTableSize += SLen(pAct->Data.getData()) + 2;
 
 	// no entries?
 	if (iTableSize <= 1) return true;
 
 	char *pData = new char[iTableSize], *pPos = pData;
 	*pData = 0;
-	for (pAct = First; pAct; pAct = pAct->Next)
+	for (C4String *pAct : SaveStrings)
 	{
-		if (pAct->iEnumID > -1 && FindSaveString(pAct) == pAct)
+		SCopy(pAct->Data.getData(), pPos);
+		if (strchr(pPos, 10) || strchr(pPos, 13))
 		{
-			SCopy(pAct->Data.getData(), pPos);
-			if (strchr(pPos, 10) || strchr(pPos, 13))
-			{
-				// delete feeds
-				char *pCharPos = pPos;
-				while (pCharPos = strchr(pCharPos, 10)) memmove(pCharPos, pCharPos + 1, SLen(pCharPos + 1) + 1);
-				// and replace breaks (by C4Script-"escapes")
-				SReplaceChar(pPos, 13, '|');
-			}
-			SAppendChar(0xD, pPos);
-			SAppendChar(0xA, pPos);
-			pPos += SLen(pPos);
+			// delete feeds
+			char *pCharPos = pPos;
+			while (pCharPos = strchr(pCharPos, 10)) memmove(pCharPos, pCharPos + 1, SLen(pCharPos + 1) + 1);
+			// and replace breaks (by C4Script-"escapes")
+			SReplaceChar(pPos, 13, '|');
 		}
+		SAppendChar(0xD, pPos);
+		SAppendChar(0xA, pPos);
+		pPos += SLen(pPos);
 	}
 
 	// write in group
@@ -18,6 +18,9 @@
 
 #pragma once
 
+#include <cstdint>
+#include <vector>
+
 class C4StringTable;
 
 class C4String
@@ -37,12 +40,53 @@ public:
 
 	int iEnumID;
 
+	uint32_t Hash; // hash of Data
+	uint64_t Serial; // position in the table, ascending from First to Last
+
 	C4String *Next, *Prev; // double-linked list
 
 	C4StringTable *pTable; // owning table
 
 	void Reg(C4StringTable *pTable);
 	void UnReg();
+
+	// scripts create and delete strings all the time, so they are pooled
+	static void *operator new(size_t iSize);
+	static void operator delete(void *pMem);
+};
+
+// open addressing hash set of strings; the hash values are supplied by the user
+class C4StringIndex
+{
+public:
+	C4StringIndex();
+	~C4StringIndex();
+
+	void Clear();
+	void Add(C4String *pString, uint32_t iHash);
+	void Remove(C4String *pString, uint32_t iHash);
+
+	// calls fnCallback for every string added with the hash value (and a few others)
+	template <typename Fn> void ForEach(uint32_t iHash, Fn fnCallback) const
+	{
+		if (!Capacity) return;
+		for (uint32_t i = iHash & (Capacity - 1); Slots[i].String || Slots[i].Deleted; i = (i + 1) & (Capacity - 1))
+			if (Slots[i].String && Slots[i].Hash == iHash)
+				fnCallback(Slots[i].String);
+	}
+
+protected:
+	struct Slot
+	{
+		C4String *String;
+		uint32_t Hash;
+		bool Deleted; // removed: lookups have to go on
+	};
+
+	Slot *Slots;
+	uint32_t Capacity, Count, Used; // Used counts deleted slots as well
+
+	void Resize(uint32_t iNewCapacity);
 };
 
 class C4StringTable
@@ -65,4 +109,17 @@ public:
 	bool Save(C4Group &ParentGroup);
 
 	C4String *First, *Last; // string list
+
+protected:
+	C4StringIndex ContentIndex, PointerIndex;
+	std::vector<C4String *> EnumIndex; // first string of each enum ID
+	bool EnumIndexValid;
+	uint64_t NextSerial;
+
+	static uint32_t HashContent(const char *szString);
+	static uint32_t HashPointer(const C4String *pString);
+	void BuildEnumIndex();
+	template <typename Fn> void ForEachSaveString(Fn fnCallback);
+
+	friend class C4String;
 };
@@ -25,6 +25,8 @@
 #include <C4Wrappers.h>
 #endif
 
+#include <algorithm>
+
 C4TransferZone::C4TransferZone()
 {
 	Default();
@@ -40,6 +42,7 @@ void C4TransferZone::Default()
 	Object = nullptr;
 	X = Y = Wdt = Hgt = 0;
 	Next = nullptr;
+	Number = 0;
 	Used = false;
 }
 
@@ -58,6 +61,13 @@ C4TransferZones::~C4TransferZones()
 void C4TransferZones::Default()
 {
 	First = nullptr;
+	ZoneCount = 0;
+	Sectors.clear();
+	SectorOut.clear();
+	SectorPxWdt = SectorPxHgt = -1;
+	SectorWdt = SectorHgt = 0;
+	ObjectZones.clear();
+	Version = 0;
 }
 
 void C4TransferZones::Clear()
@@ -65,10 +75,15 @@ void C4TransferZones::Clear()
 	C4TransferZone *pZone, *pNext;
 	for (pZone = First; pZone; pZone = pNext) { pNext = pZone->Next; delete pZone; }
 	First = nullptr;
+	for (auto &rSector : Sectors) rSector.clear();
+	SectorOut.clear();
+	ObjectZones.clear();
+	Version++;
 }
 
 void C4TransferZones::ClearPointers(C4Object *pObj)
 {
+	ObjectZones.erase(pObj);
 	// Clear object pointers
 	for (C4TransferZone *pZone = First; pZone; pZone = pZone->Next)
 		if (pZone->Object == pObj)
@@ -85,8 +100,14 @@ bool C4TransferZones::Set(int32_t iX, int32_t iY, int32_t iWdt, int32_t iHgt, C4
 	// Update existing zone
 	if (pZone = Find(pObj))
 	{
-		pZone->X = iX; pZone->Y = iY;
-		pZone->Wdt = iWdt; pZone->Hgt = iHgt;
+		if (pZone->X != iX || pZone->Y != iY || pZone->Wdt != iWdt || pZone->Hgt != iHgt)
+		{
+			RemoveFromIndex(pZone);
+			pZone->X = iX; pZone->Y = iY;
+			pZone->Wdt = iWdt; pZone->Hgt = iHgt;
+			AddToIndex(pZone);
+			Version++;
+		}
 	}
 	// Allocate and add new zone
 	else
@@ -104,7 +125,10 @@ bool C4TransferZones::Add(int32_t iX, int32_t iY, int32_t iWdt, int32_t iHgt, C4
 	pZone->Wdt = iWdt; pZone->Hgt = iHgt;
 	pZone->Object = pObj;
 	pZone->Next = First;
+	pZone->Number = ++ZoneCount;
 	First = pZone;
+	AddToIndex(pZone);
+	Version++;
 	// Success
 	return true;
 }
@@ -117,13 +141,119 @@ void C4TransferZones::Synchronize()
 
 C4TransferZone *C4TransferZones::Find(int32_t iX, int32_t iY)
 {
-	for (C4TransferZone *pZone = First; pZone; pZone = pZone->Next)
+	UpdateIndex();
+	// Zones of the sector at that point
+	std::vector<C4TransferZone *> &rZones = (Inside<int32_t>(iX, 0, SectorPxWdt - 1) && Inside<int32_t>(iY, 0, SectorPxHgt - 1))
+		? Sectors[(iY / C4LSectorHgt) * SectorWdt + iX / C4LSectorWdt] : SectorOut;
+	for (C4TransferZone *pZone : rZones)
 		if (Inside<int32_t>(iX - pZone->X, 0, pZone->Wdt - 1))
 			if (Inside<int32_t>(iY - pZone->Y, 0, pZone->Hgt - 1))
 				return pZone;
 	return nullptr;
 }
 
+void C4TransferZones::Find(const C4Rect &rcArea, std::vector<C4TransferZone *> &rZones)
+{
+	rZones.clear();
+	UpdateIndex();
+	C4Rect rcCheck = rcArea;
+	auto AddZones = [&](const std::vector<C4TransferZone *> &rSector)
+	{
+		for (C4TransferZone *pZone : rSector)
+			if (C4Rect(pZone->X, pZone->Y, pZone->Wdt, pZone->Hgt).Overlap(rcCheck))
+				if (std::find(rZones.begin(), rZones.end(), pZone) == rZones.end())
+					rZones.push_back(pZone);
+	};
+	int32_t iX1, iY1, iX2, iY2;
+	if (GetSectorRange(rcArea, iX1, iY1, iX2, iY2))
+		for (int32_t iY = iY1; iY <= iY2; iY++)
+			for (int32_t iX = iX1; iX <= iX2; iX++)
+				AddZones(Sectors[iY * SectorWdt + iX]);
+	if (rcArea.x < 0 || rcArea.y < 0 || rcArea.x + rcArea.Wdt > SectorPxWdt || rcArea.y + rcArea.Hgt > SectorPxHgt)
+		AddZones(SectorOut);
+	// List order
+	std::sort(rZones.begin(), rZones.end(), [](C4TransferZone *pZone1, C4TransferZone *pZone2) { return pZone1->Number > pZone2->Number; });
+}
+
+void C4TransferZones::UpdateIndex()
+{
+	// Sector map changed (e.g. new landscape): rebuild
+	if (SectorPxWdt == Game.Objects.Sectors.PxWdt && SectorPxHgt == Game.Objects.Sectors.PxHgt) return;
+	SectorPxWdt = Game.Objects.Sectors.PxWdt; SectorPxHgt = Game.Objects.Sectors.PxHgt;
+	SectorWdt = Game.Objects.Sectors.Wdt; SectorHgt = Game.Objects.Sectors.Hgt;
+	Sectors.assign(SectorPxWdt > 0 && SectorPxHgt > 0 ? SectorWdt * SectorHgt : 0, std::vector<C4TransferZone *>());
+	SectorOut.clear();
+	ObjectZones.clear();
+	for (C4TransferZone *pZone = First; pZone; pZone = pZone->Next)
+		AddToIndex(pZone);
+}
+
+bool C4TransferZones::GetSectorRange(const C4Rect &rcArea, int32_t &rX1, int32_t &rY1, int32_t &rX2, int32_t &rY2)
+{
+	if (Sectors.empty()) return false;
+	C4Rect rcIn = rcArea;
+	rcIn.Intersect(C4Rect(0, 0, SectorPxWdt, SectorPxHgt));
+	if (rcIn.Wdt <= 0 || rcIn.Hgt <= 0) return false;
+	rX1 = rcIn.x / C4LSectorWdt; rX2 = (rcIn.x + rcIn.Wdt - 1) / C4LSectorWdt;
+	rY1 = rcIn.y / C4LSectorHgt; rY2 = (rcIn.y + rcIn.Hgt - 1) / C4LSectorHgt;
+	return true;
+}
+
+void C4TransferZones::AddToIndex(C4TransferZone *pZone)
+{
+	auto InsertSorted = [pZone](std::vector<C4TransferZone *> &rZones)
+	{
+		rZones.insert(std::find_if(rZones.begin(), rZones.end(), [pZone](C4TransferZone *pOther) { return pOther->Number < pZone->Number; }), pZone);
+	};
+	// Object index keeps the newest zone
+	if (pZone->Object)
+	{
+		C4TransferZone *&rObjectZone = ObjectZones[pZone->Object];
+		if (!rObjectZone || rObjectZone->Number < pZone->Number) rObjectZone = pZone;
+	}
+	// Not yet indexed by sector: UpdateIndex will do it
+	if (SectorPxWdt < 0) return;
+	C4Rect rcZone(pZone->X, pZone->Y, pZone->Wdt, pZone->Hgt);
+	int32_t iX1, iY1, iX2, iY2;
+	if (GetSectorRange(rcZone, iX1, iY1, iX2, iY2))
+		for (int32_t iY = iY1; iY <= iY2; iY++)
+			for (int32_t iX = iX1; iX <= iX2; iX++)
+				InsertSorted(Sectors[iY * SectorWdt + iX]);
+	if (rcZone.x < 0 || rcZone.y < 0 || rcZone.x + rcZone.Wdt > SectorPxWdt || rcZone.y + rcZone.Hgt > SectorPxHgt)
+		InsertSorted(SectorOut);
+}
+
+void C4TransferZones::RemoveFromIndex(C4TransferZone *pZone)
+{
+	auto Remove = [pZone](std::vector<C4TransferZone *> &rZones)
+	{
+		rZones.erase(std::remove(rZones.begin(), rZones.end(), pZone), rZones.end());
+	};
+	// Object index: fall back to an older zone of the same object
+	if (pZone->Object)
+	{
+		auto it = ObjectZones.find(pZone->Object);
+		if (it != ObjectZones.end() && it->second == pZone)
+		{
+			ObjectZones.erase(it);
+			for (C4TransferZone *pOther = First; pOther; pOther = pOther->Next)
+				if (pOther != pZone && pOther->Object == pZone->Object)
+				{
+					ObjectZones[pOther->Object] = pOther;
+					break;
+				}
+		}
+	}
+	if (SectorPxWdt < 0) return;
+	C4Rect rcZone(pZone->X, pZone->Y, pZone->Wdt, pZone->Hgt);
+	int32_t iX1, iY1, iX2, iY2;
+	if (GetSectorRange(rcZone, iX1, iY1, iX2, iY2))
+		for (int32_t iY = iY1; iY <= iY2; iY++)
+			for (int32_t iX = iX1; iX <= iX2; iX++)
+				Remove(Sectors[iY * SectorWdt + iX]);
+	Remove(SectorOut);
+}
+
 void C4TransferZones::Draw(C4FacetEx &cgo)
 {
 	for (C4TransferZone *pZone = First; pZone; pZone = pZone->Next)
@@ -153,10 +283,12 @@ int32_t C4TransferZones::RemoveNullZones()
 		pNext = pZone->Next;
 		if (!pZone->Object)
 		{
+			RemoveFromIndex(pZone);
 			delete pZone;
 			if (pPrev) pPrev->Next = pNext;
 			else First = pNext;
 			iResult++;
+			Version++;
 		}
 		else
 			pPrev = pZone;
@@ -213,8 +345,6 @@ void C4TransferZones::ClearUsed()
 
 C4TransferZone *C4TransferZones::Find(C4Object *pObj)
 {
-	for (C4TransferZone *pZone = First; pZone; pZone = pZone->Next)
-		if (pZone->Object == pObj)
-			return pZone;
-	return nullptr;
+	auto it = ObjectZones.find(pObj);
+	return it != ObjectZones.end() ? it->second : nullptr;
 }
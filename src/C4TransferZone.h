@@ -18,6 +18,11 @@
 
 #pragma once
 
+#include <C4Shape.h>
+
+#include <map>
+#include <vector>
+
 class C4TransferZones;
 
 class C4TransferZone
@@ -35,6 +40,7 @@ public:
 
 protected:
 	C4TransferZone *Next;
+	int32_t Number; // newer zones have higher numbers and come first in the list
 
 public:
 	bool GetEntryPoint(int32_t &rX, int32_t &rY, int32_t iToX, int32_t iToY);
@@ -53,8 +59,23 @@ public:
 protected:
 	int32_t RemoveNullZones();
 	C4TransferZone *First;
+	int32_t ZoneCount; // zones numbered so far
+
+	// Index: zones overlapping each sector of the C4LSectors map, in list order
+	std::vector<std::vector<C4TransferZone *>> Sectors;
+	std::vector<C4TransferZone *> SectorOut; // zones reaching outside the map
+	int32_t SectorPxWdt, SectorPxHgt, SectorWdt, SectorHgt;
+	// Index: newest zone of each object
+	std::map<C4Object *, C4TransferZone *> ObjectZones;
+
+	void UpdateIndex();
+	void AddToIndex(C4TransferZone *pZone);
+	void RemoveFromIndex(C4TransferZone *pZone);
+	bool GetSectorRange(const C4Rect &rcArea, int32_t &rX1, int32_t &rY1, int32_t &rX2, int32_t &rY2);
 
 public:
+	uint32_t Version; // incremented whenever a zone is added, moved or removed
+
 	void Default();
 	void Clear();
 	void ClearUsed();
@@ -63,6 +84,7 @@ public:
 	void Synchronize();
 	C4TransferZone *Find(C4Object *pObj);
 	C4TransferZone *Find(int32_t iX, int32_t iY);
+	void Find(const C4Rect &rcArea, std::vector<C4TransferZone *> &rZones); // all zones overlapping the area, in list order
 	bool Add(int32_t iX, int32_t iY, int32_t iWdt, int32_t iHgt, C4Object *pObj);
 	bool Set(int32_t iX, int32_t iY, int32_t iWdt, int32_t iHgt, C4Object *pObj);
 };
@@ -31,25 +31,98 @@ const C4Value C4VNull = C4Value();
 const C4Value C4VTrue = C4VBool(true);
 const C4Value C4VFalse = C4VBool(false);
 
-C4Value::~C4Value()
+C4Value::RefLinks *C4Value::LinkTable = nullptr;
+uint32_t C4Value::LinkTableSize = 0, C4Value::FirstFreeLinks = 0, C4Value::UsedLinks = 0;
+
+void C4Value::Clear()
 {
 	// resolve all C4Values referencing this Value
-	while (FirstRef)
-		FirstRef->Set(*this);
+	while (C4Value *pRef = GetFirstRef())
+		pRef->Set(*this);
 
 	// delete contents
-	DelDataRef(Data, Type, GetNextRef(), GetBaseArray());
+	C4Value *pNextRef = GetNextRef();
+	C4ValueArray *pBaseArray = GetBaseArray();
+	SetNextRef(nullptr);
+	DelDataRef(Data, Type, pNextRef, pBaseArray);
 }
 
-C4Value &C4Value::operator=(const C4Value &nValue)
+uint32_t C4Value::AllocLinks()
 {
-	// set referenced value
-	if (Type == C4V_pC4Value)
-		GetRefVal().operator=(nValue);
-	else
-		Set(nValue.GetRefVal());
+	if (!FirstFreeLinks)
+	{
+		// grow the table; entry 0 stays unused so that 0 can mean "no links"
+		uint32_t iNewSize = LinkTableSize ? 2 * LinkTableSize : 256;
+		RefLinks *pNewTable = new RefLinks[iNewSize];
+		if (LinkTable) std::copy(LinkTable, LinkTable + LinkTableSize, pNewTable);
+		for (uint32_t i = (std::max)(LinkTableSize, 1u); i < iNewSize; i++)
+			pNewTable[i].NextFree = i + 1 < iNewSize ? i + 1 : 0;
+		FirstFreeLinks = (std::max)(LinkTableSize, 1u);
+		delete[] LinkTable;
+		LinkTable = pNewTable;
+		LinkTableSize = iNewSize;
+	}
+	uint32_t iLinks = FirstFreeLinks;
+	RefLinks &rLinks = LinkTable[iLinks];
+	FirstFreeLinks = rLinks.NextFree;
+	++UsedLinks;
+	rLinks.FirstRef = rLinks.NextRef = nullptr;
+	rLinks.HasBaseArray = false;
+	return iLinks;
+}
 
-	return *this;
+void C4Value::FreeLinksIfUnused()
+{
+	assert(Links);
+	RefLinks &rLinks = LinkTable[Links];
+	// with HasBaseArray, BaseArray is set
+	if (rLinks.FirstRef || rLinks.NextRef) return;
+	rLinks.NextFree = FirstFreeLinks;
+	FirstFreeLinks = Links;
+	Links = 0;
+	--UsedLinks;
+}
+
+void C4Value::FreeLinkTable()
+{
+	// values still in a list keep their entries
+	if (UsedLinks) return;
+	delete[] LinkTable;
+	LinkTable = nullptr;
+	LinkTableSize = FirstFreeLinks = 0;
+}
+
+void C4Value::SetFirstRef(C4Value *pRef)
+{
+	if (!Links)
+	{
+		if (!pRef) return;
+		Links = AllocLinks();
+	}
+	LinkTable[Links].FirstRef = pRef;
+	if (!pRef) FreeLinksIfUnused();
+}
+
+void C4Value::SetNextRef(C4Value *pRef)
+{
+	if (!Links)
+	{
+		if (!pRef) return;
+		Links = AllocLinks();
+	}
+	RefLinks &rLinks = LinkTable[Links];
+	rLinks.NextRef = pRef;
+	rLinks.HasBaseArray = false;
+	if (!pRef) FreeLinksIfUnused();
+}
+
+void C4Value::SetBaseArray(C4ValueArray *pBaseArray)
+{
+	assert(pBaseArray);
+	if (!Links) Links = AllocLinks();
+	RefLinks &rLinks = LinkTable[Links];
+	rLinks.BaseArray = pBaseArray;
+	rLinks.HasBaseArray = true;
 }
 
 void C4Value::AddDataRef()
@@ -86,8 +159,6 @@ void C4Value::DelDataRef(C4V_Data Data, C4V_Type Type, C4Value *pNextRef, C4Valu
 	switch (Type)
 	{
 	case C4V_pC4Value:
-		// Save because AddDataRef does not set this flag
-		HasBaseArray = false;
 		Data.Ref->DelRef(this, pNextRef, pBaseArray);
 		break;
 #ifdef C4ENGINE
@@ -99,39 +170,44 @@ void C4Value::DelDataRef(C4V_Data Data, C4V_Type Type, C4Value *pNextRef, C4Valu
 	}
 }
 
-void C4Value::Set(C4V_Data nData, C4V_Type nType)
+void C4Value::SetDataRef(C4V_Data nData, C4V_Type nType)
 {
 	// Do not add this to the same linked list twice.
 	if (Data == nData && Type == nType) return;
 
 	C4V_Data oData = Data;
 	C4V_Type oType = Type;
-	C4Value *oNextRef = NextRef;
-	C4ValueArray *oBaseArray = BaseArray;
-	bool oHasBaseArray = HasBaseArray;
+	C4Value *oNextRef = GetNextRef();
+	C4ValueArray *oBaseArray = GetBaseArray();
 
 	// change
 	Data = nData;
 	Type = nData ? nType : C4V_Any;
 
+	// leave the old list; the neighbours are linked when cleaning up below
+	if (Links) SetNextRef(nullptr);
+
 	// hold
 	AddDataRef();
 
 	// clean up
-	DelDataRef(oData, oType, oHasBaseArray ? nullptr : oNextRef, oHasBaseArray ? oBaseArray : nullptr);
+	DelDataRef(oData, oType, oNextRef, oBaseArray);
 }
 
-void C4Value::Set0()
+void C4Value::Set0DataRef()
 {
 	C4V_Data oData = Data;
 	C4V_Type oType = Type;
+	C4Value *oNextRef = GetNextRef();
+	C4ValueArray *oBaseArray = GetBaseArray();
 
 	// change
 	Data = 0;
 	Type = C4V_Any;
+	if (Links) SetNextRef(nullptr);
 
 	// clean up (save even if Data was 0 before)
-	DelDataRef(oData, oType, HasBaseArray ? nullptr : NextRef, HasBaseArray ? BaseArray : nullptr);
+	DelDataRef(oData, oType, oNextRef, oBaseArray);
 }
 
 void C4Value::Move(C4Value *nValue)
@@ -139,15 +215,16 @@ void C4Value::Move(C4Value *nValue)
 	nValue->Set(*this);
 
 	// change references
-	for (C4Value *pVal = FirstRef; pVal; pVal = pVal->GetNextRef())
+	C4Value *pFirstRef = GetFirstRef();
+	for (C4Value *pVal = pFirstRef; pVal; pVal = pVal->GetNextRef())
 		pVal->Data.Ref = nValue;
 
 	// copy ref list
-	assert(!nValue->FirstRef);
-	nValue->FirstRef = FirstRef;
+	assert(!nValue->GetFirstRef());
+	nValue->SetFirstRef(pFirstRef);
 
 	// delete usself
-	FirstRef = nullptr;
+	SetFirstRef(nullptr);
 	Set(0);
 }
 
@@ -170,15 +247,14 @@ void C4Value::GetArrayElement(int32_t Index, C4Value &target, C4AulContext *pctx
 	else
 	{
 		// Is target the first ref?
-		if (Index >= Ref.Data.Array->GetSize() || !Ref.Data.Array->GetItem(Index).FirstRef)
+		if (Index >= Ref.Data.Array->GetSize() || !Ref.Data.Array->GetItem(Index).GetFirstRef())
 		{
 			Ref.Data.Array = Ref.Data.Array->IncElementRef();
 			target.SetRef(&Ref.Data.Array->GetItem(Index));
 			if (target.Type == C4V_pC4Value)
 			{
-				assert(!target.NextRef);
-				target.BaseArray = Ref.Data.Array;
-				target.HasBaseArray = true;
+				assert(!target.GetNextRef());
+				target.SetBaseArray(Ref.Data.Array);
 			}
 			// else target apparently owned the last reference to the array
 		}
@@ -200,51 +276,33 @@ void C4Value::SetArrayLength(int32_t size, C4AulContext *cthr)
 
 #endif
 
-const C4Value &C4Value::GetRefVal() const
-{
-	const C4Value *pVal = this;
-	while (pVal->Type == C4V_pC4Value)
-		pVal = pVal->Data.Ref;
-	return *pVal;
-}
-
-C4Value &C4Value::GetRefVal()
-{
-	C4Value *pVal = this;
-	while (pVal->Type == C4V_pC4Value)
-		pVal = pVal->Data.Ref;
-	return *pVal;
-}
-
 void C4Value::AddRef(C4Value *pRef)
 {
-	pRef->NextRef = FirstRef;
-	FirstRef = pRef;
+	pRef->SetNextRef(GetFirstRef());
+	SetFirstRef(pRef);
 }
 
 void C4Value::DelRef(const C4Value *pRef, C4Value *pNextRef, C4ValueArray *pBaseArray)
 {
-	if (pRef == FirstRef)
-		FirstRef = pNextRef;
+	if (pRef == GetFirstRef())
+		SetFirstRef(pNextRef);
 	else
 	{
-		C4Value *pVal = FirstRef;
-		while (pVal->NextRef != pRef)
+		C4Value *pVal = GetFirstRef();
+		while (pVal->GetNextRef() != pRef)
 		{
 			// assert that pRef really was in the list
-			assert(pVal->NextRef && !pVal->HasBaseArray);
-			pVal = pVal->NextRef;
+			assert(pVal->GetNextRef());
+			pVal = pVal->GetNextRef();
 		}
-		pVal->NextRef = pNextRef;
 		if (pBaseArray)
-		{
-			pVal->HasBaseArray = true;
-			pVal->BaseArray = pBaseArray;
-		}
+			pVal->SetBaseArray(pBaseArray);
+		else
+			pVal->SetNextRef(pNextRef);
 	}
 	// Was pRef the last ref to an array element?
 #ifdef C4ENGINE
-	if (pBaseArray && !FirstRef)
+	if (pBaseArray && !GetFirstRef())
 	{
 		pBaseArray->DecElementRef();
 	}
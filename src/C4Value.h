@@ -76,46 +76,57 @@ template <typename T> struct C4ValueConv;
 class C4Value
 {
 public:
-	C4Value() : Type(C4V_Any), HasBaseArray(false), NextRef(nullptr), FirstRef(nullptr) { Data.Ref = 0; }
+	C4Value() : Links(0), Type(C4V_Any) { Data.Ref = 0; }
 
-	C4Value(const C4Value &nValue) : Data(nValue.Data), Type(nValue.Type), HasBaseArray(false), NextRef(nullptr), FirstRef(nullptr)
+	C4Value(const C4Value &nValue) : Data(nValue.Data), Links(0), Type(nValue.Type)
 	{
-		AddDataRef();
+		if (HasDataRef()) AddDataRef();
 	}
 
-	C4Value(C4V_Data nData, C4V_Type nType) : Data(nData), Type(nData ? nType : C4V_Any), HasBaseArray(false), NextRef(nullptr), FirstRef(nullptr)
+	C4Value(C4V_Data nData, C4V_Type nType) : Data(nData), Links(0), Type(nData ? nType : C4V_Any)
 	{
-		AddDataRef();
+		if (HasDataRef()) AddDataRef();
 	}
 
-	C4Value(int32_t nData, C4V_Type nType) : Type(nData ? nType : C4V_Any), HasBaseArray(false), NextRef(nullptr), FirstRef(nullptr)
+	C4Value(int32_t nData, C4V_Type nType) : Links(0), Type(nData ? nType : C4V_Any)
 	{
-		Data.Int = nData; AddDataRef();
+		Data.Int = nData; if (HasDataRef()) AddDataRef();
 	}
 
-	explicit C4Value(C4Object *pObj) : Type(pObj ? C4V_C4Object : C4V_Any), HasBaseArray(false), NextRef(nullptr), FirstRef(nullptr)
+	explicit C4Value(C4Object *pObj) : Links(0), Type(pObj ? C4V_C4Object : C4V_Any)
 	{
 		Data.Obj = pObj; AddDataRef();
 	}
 
-	explicit C4Value(C4String *pStr) : Type(pStr ? C4V_String : C4V_Any), HasBaseArray(false), NextRef(nullptr), FirstRef(nullptr)
+	explicit C4Value(C4String *pStr) : Links(0), Type(pStr ? C4V_String : C4V_Any)
 	{
 		Data.Str = pStr; AddDataRef();
 	}
 
-	explicit C4Value(C4ValueArray *pArray) : Type(pArray ? C4V_Array : C4V_Any), HasBaseArray(false), NextRef(nullptr), FirstRef(nullptr)
+	explicit C4Value(C4ValueArray *pArray) : Links(0), Type(pArray ? C4V_Array : C4V_Any)
 	{
 		Data.Array = pArray; AddDataRef();
 	}
 
-	explicit C4Value(C4Value *pVal) : Type(pVal ? C4V_pC4Value : C4V_Any), HasBaseArray(false), NextRef(nullptr), FirstRef(nullptr)
+	explicit C4Value(C4Value *pVal) : Links(0), Type(pVal ? C4V_pC4Value : C4V_Any)
 	{
 		Data.Ref = pVal; AddDataRef();
 	}
 
-	C4Value &operator=(const C4Value &nValue);
+	C4Value &operator=(const C4Value &nValue)
+	{
+		// set referenced value
+		if (Type == C4V_pC4Value)
+			GetRefVal().operator=(nValue);
+		else
+			Set(nValue.GetRefVal());
+		return *this;
+	}
 
-	~C4Value();
+	~C4Value()
+	{
+		if (Links || HasDataRef()) Clear();
+	}
 
 	// Checked getters
 	int32_t getInt()         { return ConvertTo(C4V_Int)      ? Data.Int   : 0; }
@@ -158,7 +169,12 @@ public:
 
 	void SetRef(C4Value *nValue) { C4V_Data d; d.Ref = nValue; Set(d, C4V_pC4Value); }
 
-	void Set0();
+	void Set0()
+	{
+		// plain values can be overwritten right away
+		if (Type <= C4V_C4ID) { Data.Ref = 0; Type = C4V_Any; }
+		else Set0DataRef();
+	}
 
 	bool operator==(const C4Value &Value2) const;
 	bool operator!=(const C4Value &Value2) const;
@@ -185,8 +201,20 @@ public:
 	C4V_Type GetType() const { return GetRefVal().Type; }
 
 	// return referenced value
-	const C4Value &GetRefVal() const;
-	C4Value &GetRefVal();
+	const C4Value &GetRefVal() const
+	{
+		const C4Value *pVal = this;
+		while (pVal->Type == C4V_pC4Value)
+			pVal = pVal->Data.Ref;
+		return *pVal;
+	}
+	C4Value &GetRefVal()
+	{
+		C4Value *pVal = this;
+		while (pVal->Type == C4V_pC4Value)
+			pVal = pVal->Data.Ref;
+		return *pVal;
+	}
 
 	// Get the Value at the index. Throws C4AulExecError if not an array
 	void GetArrayElement(int32_t index, C4Value &to, struct C4AulContext *pctx = 0, bool noref = false);
@@ -211,27 +239,64 @@ public:
 	// Compilation
 	void CompileFunc(StdCompiler *pComp);
 
+	// frees the reference list table once no value is in a list anymore
+	static void FreeLinkTable();
+
 protected:
+	// Reference lists: all values referencing a value, and all values pointing to
+	// an object, are linked into a list. Only few values are part of such a list,
+	// so the links are kept in a shared table and values just store an index.
+	struct RefLinks
+	{
+		C4Value *FirstRef; // first value referencing this one
+		union
+		{
+			C4Value *NextRef; // next value in the list this value is part of
+			C4ValueArray *BaseArray; // last reference to an array element: the array
+		};
+		bool HasBaseArray;
+		uint32_t NextFree; // next unused entry
+	};
+
+	static RefLinks *LinkTable;
+	static uint32_t LinkTableSize, FirstFreeLinks, UsedLinks;
+
 	// data
 	C4V_Data Data;
 
-	// reference-list
-	union
-	{
-		C4Value *NextRef;
-		C4ValueArray *BaseArray;
-	};
-	C4Value *FirstRef;
+	// reference-list entry in LinkTable, 0 if none
+	uint32_t Links;
 
 	// data type
 	C4V_Type Type : 8;
-	bool HasBaseArray : 8;
 
-	C4Value *GetNextRef() { if (HasBaseArray) return 0; else return NextRef; }
-	C4ValueArray *GetBaseArray() { if (HasBaseArray) return BaseArray; else return 0; }
+	// whether the value holds a reference that has to be counted or listed
+	bool HasDataRef() const { return Type == C4V_Any ? !!Data.Ref : Type > C4V_C4ID; }
+
+	C4Value *GetFirstRef() const { return Links ? LinkTable[Links].FirstRef : nullptr; }
+	C4Value *GetNextRef() const { return Links && !LinkTable[Links].HasBaseArray ? LinkTable[Links].NextRef : nullptr; }
+	C4ValueArray *GetBaseArray() const { return Links && LinkTable[Links].HasBaseArray ? LinkTable[Links].BaseArray : nullptr; }
+	void SetFirstRef(C4Value *pRef);
+	void SetNextRef(C4Value *pRef);
+	void SetBaseArray(C4ValueArray *pBaseArray);
+	uint32_t AllocLinks();
+	void FreeLinksIfUnused();
 
 	void Set(long nData, C4V_Type nType = C4V_Any) { C4V_Data d; d.Int = nData; Set(d, nType); }
-	void Set(C4V_Data nData, C4V_Type nType);
+	void Set(C4V_Data nData, C4V_Type nType)
+	{
+		// plain values can be overwritten right away
+		if (Type <= C4V_C4ID && (nType == C4V_Int || nType == C4V_Bool || nType == C4V_C4ID || !nData))
+		{
+			Data = nData;
+			Type = nData ? nType : C4V_Any;
+		}
+		else
+			SetDataRef(nData, nType);
+	}
+	void SetDataRef(C4V_Data nData, C4V_Type nType);
+	void Set0DataRef();
+	void Clear();
 
 	void AddRef(C4Value *pRef);
 	void DelRef(const C4Value *pRef, C4Value *pNextRef, C4ValueArray *pBaseArray);
@@ -248,8 +313,11 @@ protected:
 
 	friend class C4Object;
 	friend class C4AulDefFunc;
+	friend class C4ValueList;
 };
 
+static_assert(sizeof(C4Value) <= 16, "C4Value should fit into 16 bytes");
+
 // converter
 inline C4Value C4VInt(int32_t iVal) { C4V_Data d; d.Int = iVal; return C4Value(d, C4V_Int); }
 inline C4Value C4VBool(bool fVal) { C4V_Data d; d.Int = fVal; return C4Value(d, C4V_Bool); }
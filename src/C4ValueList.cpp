@@ -17,6 +17,7 @@
 #include <C4Include.h>
 #include <C4ValueList.h>
 #include <algorithm>
+#include <new>
 
 #ifndef BIG_C4INCLUDE
 #include <C4Aul.h>
@@ -24,16 +25,16 @@
 #endif
 
 C4ValueList::C4ValueList()
-	: iSize(0), pData(nullptr) {}
+	: iSize(0), iCapacity(0), iDropped(0), pData(nullptr) {}
 
 C4ValueList::C4ValueList(int32_t inSize)
-	: iSize(0), pData(nullptr)
+	: iSize(0), iCapacity(0), iDropped(0), pData(nullptr)
 {
 	SetSize(inSize);
 }
 
 C4ValueList::C4ValueList(const C4ValueList &ValueList2)
-	: iSize(0), pData(nullptr)
+	: iSize(0), iCapacity(0), iDropped(0), pData(nullptr)
 {
 	SetSize(ValueList2.GetSize());
 	for (int32_t i = 0; i < iSize; i++)
@@ -43,7 +44,7 @@ C4ValueList::C4ValueList(const C4ValueList &ValueList2)
 C4ValueList::~C4ValueList()
 {
 	delete[] pData; pData = nullptr;
-	iSize = 0;
+	iSize = iCapacity = iDropped = 0;
 }
 
 C4ValueList &C4ValueList::operator=(const C4ValueList &ValueList2)
@@ -120,26 +121,57 @@ void C4ValueList::SetSize(int32_t inSize)
 	{
 		// free values in undefined area
 		for (int i = inSize; i < iSize; i++) pData[i].Set0();
+		iDropped = (std::max)(iDropped, iSize);
 		iSize = inSize;
+		// give back the memory if most of it is unused, unless a dropped value
+		// is still referenced: it lives until the array is enlarged again
+		if (iSize < iCapacity / 4)
+		{
+			for (int32_t i = iSize; i < iDropped; i++)
+				if (pData[i].GetFirstRef()) return;
+			Reallocate(iSize);
+		}
 		return;
 	}
 
 	// bounds check
 	if (inSize > MaxSize) return;
 
+	if (inSize > iCapacity)
+	{
+		// grow geometrically, so appending one by one takes amortized constant time
+		Reallocate((std::min<int32_t>)((std::max<int32_t>)(inSize, iCapacity + iCapacity / 2), MaxSize));
+		if (iCapacity < inSize) return;
+	}
+	else
+	{
+		// dropped values are destroyed now, as if the memory had been reallocated
+		for (int32_t i = iSize; i < iDropped; i++)
+		{
+			pData[i].~C4Value();
+			new (&pData[i]) C4Value();
+		}
+	}
+	iDropped = 0;
+	iSize = inSize;
+}
+
+void C4ValueList::Reallocate(int32_t inCapacity)
+{
 	// create new array (initialises)
-	C4Value *pnData = new C4Value[inSize];
-	if (!pnData) return;
+	C4Value *pnData = inCapacity ? new C4Value[inCapacity] : nullptr;
+	if (inCapacity && !pnData) return;
 
 	// move existing values
 	int32_t i;
 	for (i = 0; i < iSize; i++)
 		pData[i].Move(&pnData[i]);
 
-	// replace
+	// replace; dropped values are destroyed with the old array
 	delete[] pData;
 	pData = pnData;
-	iSize = inSize;
+	iCapacity = inCapacity;
+	iDropped = 0;
 }
 
 bool C4ValueList::operator==(const C4ValueList &IntList2) const
@@ -154,7 +186,7 @@ bool C4ValueList::operator==(const C4ValueList &IntList2) const
 void C4ValueList::Reset()
 {
 	delete[] pData; pData = nullptr;
-	iSize = 0;
+	iSize = iCapacity = iDropped = 0;
 }
 
 void C4ValueList::DenumeratePointers()
@@ -252,7 +284,7 @@ C4ValueArray *C4ValueArray::SetLength(int32_t size)
 	if (iRefCnt > 1)
 	{
 		C4ValueArray *pNew = (new C4ValueArray(size))->IncRef();
-		for (int32_t i = 0; i < iSize; i++)
+		for (int32_t i = 0; i < (std::min)(iSize, size); i++)
 			pNew->pData[i].Set(pData[i]);
 		if (C4VALUEARRAY_DEBUG) printf("%p SetLength at %d, %d - Copying %p\n", this, iRefCnt, iElementReferences, pNew);
 		--iRefCnt;
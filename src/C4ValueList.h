@@ -34,8 +34,12 @@ public:
 
 protected:
 	int32_t iSize;
+	int32_t iCapacity; // allocated values; those beyond iSize are null
+	int32_t iDropped; // values from iSize up to here were dropped by shrinking and may still be referenced
 	C4Value *pData;
 
+	void Reallocate(int32_t inCapacity); // set the number of allocated values; keeps the first iSize
+
 public:
 	int32_t GetSize() const { return iSize; }
 
@@ -48,7 +52,7 @@ public:
 	C4Value &operator[](int32_t iElem) { return GetItem(iElem); }
 
 	void Reset();
-	void SetSize(int32_t inSize); // (enlarge only!)
+	void SetSize(int32_t inSize); // grows the storage geometrically; shrinking keeps it unless mostly unused
 
 	void DenumeratePointers();
 
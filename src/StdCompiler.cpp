@@ -185,8 +185,8 @@ void StdCompilerBinRead::String(std::string &str, RawCompileType type)
 		{
 			excEOF(); return;
 		}
-	// Copy data
-	str.assign(getBufPtr<char>(Buf, iStart), getBufPtr<char>(Buf, iPos));
+	// Copy data without the terminator
+	str.assign(getBufPtr<char>(Buf, iStart), getBufPtr<char>(Buf, iPos - 1));
 }
 
 void StdCompilerBinRead::Raw(void *pData, size_t iSize, RawCompileType eType)
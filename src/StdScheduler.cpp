@@ -368,6 +368,22 @@ unsigned int StdSchedulerThread::ThreadFunc()
 
 StdThread::StdThread() : fStarted(false), fStopSignaled(false) {}
 
+bool StdThread::Start()
+{
+	// already running? stop
+	if (fStarted) Stop();
+	// begin thread
+	fStopSignaled = false;
+#ifdef HAVE_WINTHREAD
+	iThread = _beginthread(_ThreadFunc, 0, this);
+	fStarted = (iThread != -1);
+#elif HAVE_PTHREAD
+	fStarted = !pthread_create(&Thread, nullptr, _ThreadFunc, this);
+#endif
+	// success?
+	return fStarted;
+}
+
 void StdThread::SignalStop()
 {
 	// Not running?
@@ -398,7 +414,13 @@ void StdThread::Stop()
 	return;
 }
 
-#if !defined(HAVE_WINTHREAD) && defined(HAVE_PTHREAD)
+#ifdef HAVE_WINTHREAD
+void __cdecl StdThread::_ThreadFunc(void *pPar)
+{
+	StdThread *pThread = reinterpret_cast<StdThread *>(pPar);
+	_endthreadex(pThread->ThreadFunc());
+}
+#elif defined(HAVE_PTHREAD)
 void *StdThread::_ThreadFunc(void *pPar)
 {
 	StdThread *pThread = reinterpret_cast<StdThread *>(pPar);